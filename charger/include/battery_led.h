@@ -16,6 +16,8 @@
 #ifndef BATTERY_LED_H
 #define BATTERY_LED_H
 
+#include <array>
+
 #include "battery_config.h"
 #include "power_supply_provider.h"
 #include "v1_0/ilight_interface.h"
@@ -36,9 +38,18 @@ public:
     uint32_t GetLightColor() const;
 
 private:
+    struct ColorEntry {
+        bool hasColor {false};
+        uint32_t rgb {0};
+    };
+    static constexpr int32_t MAX_SOC = 100;
+    void BuildColorTable();
+
     sptr<OHOS::HDI::Light::V1_0::ILightInterface> batteryLight_ {nullptr};
     bool available_ {false};
     uint32_t lightColor_ {0};
+    // light conf resolved per capacity once, the config is parsed before InitLight
+    std::array<ColorEntry, MAX_SOC + 1> colorTable_ {};
 };
 } // namespace PowerMgr
 } // namespace OHOS
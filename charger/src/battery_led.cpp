@@ -28,6 +28,7 @@ constexpr uint32_t MOVE_RIGHT_8 = 8;
 } // namespace
 void BatteryLed::InitLight()
 {
+    BuildColorTable();
     batteryLight_ = ILightInterface::Get();
     if (batteryLight_ == nullptr) {
         BATTERY_HILOGW(FEATURE_CHARGING, "Light interface is null");
@@ -85,18 +86,32 @@ bool BatteryLed::UpdateColor(int32_t chargeState, int32_t capacity)
         return false;
     }
 
+    if (capacity < 0 || capacity > MAX_SOC || !colorTable_[capacity].hasColor) {
+        return false;
+    }
+    uint32_t rgb = colorTable_[capacity].rgb;
+    if (lightColor_ == rgb) {
+        return true;
+    }
+    TurnOff();
+    TurnOn(rgb);
+    return true;
+}
+
+void BatteryLed::BuildColorTable()
+{
     const auto& lightConf = BatteryConfig::GetInstance().GetLightConf();
-    for (const auto& it : lightConf) {
-        if ((capacity >= it.beginSoc) && (capacity <= it.endSoc)) {
-            if (lightColor_ == it.rgb) {
-                return true;
+    for (int32_t capacity = 0; capacity <= MAX_SOC; capacity++) {
+        ColorEntry& entry = colorTable_[capacity];
+        entry = ColorEntry();
+        for (const auto& it : lightConf) {
+            if ((capacity >= it.beginSoc) && (capacity <= it.endSoc)) {
+                entry.hasColor = true;
+                entry.rgb = it.rgb;
+                break;
             }
-            TurnOff();
-            TurnOn(it.rgb);
-            return true;
         }
     }
-    return false;
 }
 
 bool BatteryLed::IsAvailable() const
@@ -52,3 +52,9 @@ BatteryInfo_BatteryPluggedType OH_BatteryInfo_GetPluggedType()
     }
     return ret;
 }
+
+int64_t OH_BatteryInfo_GetRemainingDischargeTime()
+{
+    BatterySrvClient& batterySrvClient = BatterySrvClient::GetInstance();
+    return batterySrvClient.GetRemainingDischargeTime();
+}
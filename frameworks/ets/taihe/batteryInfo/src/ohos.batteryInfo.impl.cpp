@@ -26,6 +26,8 @@
 #include <cstdio>
 #include <string>
 #include <map>
+#include <utility>
+#include <vector>
 
 using namespace taihe;
 using namespace ohos::batteryInfo;
@@ -81,6 +83,54 @@ bool IsBatteryConfigSupported(taihe::string_view sceneName)
     return result;
 }
 
+taihe::array<BatteryConfigResult> CreateBatteryConfigResults(const std::vector<std::string>& sceneNames,
+    const std::vector<std::string>& values, const std::vector<BatteryError>& results)
+{
+    std::vector<BatteryConfigResult> configResults;
+    for (size_t i = 0; i < results.size() && i < sceneNames.size() && i < values.size(); i++) {
+        configResults.push_back({taihe::string(sceneNames[i]), taihe::string(values[i]),
+            static_cast<int32_t>(results[i])});
+    }
+    return taihe::array<BatteryConfigResult>(taihe::copy_data_t{}, configResults.data(), configResults.size());
+}
+
+taihe::array<BatteryConfigResult> SetBatteryConfigs(taihe::array_view<BatteryConfigEntry> configs)
+{
+    std::vector<std::pair<std::string, std::string>> entries;
+    std::vector<std::string> sceneNames;
+    std::vector<std::string> values;
+    for (const auto& config : configs) {
+        entries.emplace_back(std::string(config.sceneName), std::string(config.sceneValue));
+        sceneNames.emplace_back(config.sceneName);
+        values.emplace_back(config.sceneValue);
+    }
+    std::vector<BatteryError> results;
+    BatteryError code = g_battClient.SetBatteryConfigs(entries, results);
+    BATTERY_HILOGI(FEATURE_BATT_INFO, "set charge configs, size: %{public}zu, ret: %{public}d", entries.size(),
+        static_cast<int32_t>(code));
+    if (code != BatteryError::ERR_OK && code != BatteryError::ERR_FAILURE) {
+        taihe::set_business_error(static_cast<int32_t>(code), g_errorTable[code]);
+    }
+    return CreateBatteryConfigResults(sceneNames, values, results);
+}
+
+taihe::array<BatteryConfigResult> GetBatteryConfigs(taihe::array_view<taihe::string> sceneNames)
+{
+    std::vector<std::string> names;
+    for (const auto& sceneName : sceneNames) {
+        names.emplace_back(sceneName);
+    }
+    std::vector<std::string> values;
+    std::vector<BatteryError> results;
+    BatteryError code = g_battClient.GetBatteryConfigs(names, values, results);
+    BATTERY_HILOGD(COMP_FWK, "get charge configs, size: %{public}zu, ret: %{public}d", names.size(),
+        static_cast<int32_t>(code));
+    if (code != BatteryError::ERR_OK && code != BatteryError::ERR_FAILURE) {
+        taihe::set_business_error(static_cast<int32_t>(code), g_errorTable[code]);
+    }
+    return CreateBatteryConfigResults(names, values, results);
+}
+
 int32_t BatterySOC()
 {
     int32_t capacity = g_battClient.GetCapacity();
@@ -237,6 +287,12 @@ int64_t EstimatedRemainingChargeTime()
     return time;
 }
 
+int64_t EstimatedRemainingDischargeTime()
+{
+    int64_t time = g_battClient.GetRemainingDischargeTime();
+    return time;
+}
+
 int32_t TotalEnergy()
 {
     int32_t totalEnergy = g_battClient.GetTotalEnergy();
@@ -264,6 +320,8 @@ int32_t RemainingEnergy()
 TH_EXPORT_CPP_API_SetBatteryConfig(SetBatteryConfig);
 TH_EXPORT_CPP_API_GetBatteryConfig(GetBatteryConfig);
 TH_EXPORT_CPP_API_IsBatteryConfigSupported(IsBatteryConfigSupported);
+TH_EXPORT_CPP_API_SetBatteryConfigs(SetBatteryConfigs);
+TH_EXPORT_CPP_API_GetBatteryConfigs(GetBatteryConfigs);
 TH_EXPORT_CPP_API_BatterySOC(BatterySOC);
 TH_EXPORT_CPP_API_ChargingStatus(ChargingStatus);
 TH_EXPORT_CPP_API_HealthStatus(HealthStatus);
@@ -274,6 +332,7 @@ TH_EXPORT_CPP_API_BatteryTemperature(BatteryTemperature);
 TH_EXPORT_CPP_API_IsBatteryPresent(IsBatteryPresent);
 TH_EXPORT_CPP_API_GetCapacityLevel(GetCapacityLevel);
 TH_EXPORT_CPP_API_EstimatedRemainingChargeTime(EstimatedRemainingChargeTime);
+TH_EXPORT_CPP_API_EstimatedRemainingDischargeTime(EstimatedRemainingDischargeTime);
 TH_EXPORT_CPP_API_TotalEnergy(TotalEnergy);
 TH_EXPORT_CPP_API_NowCurrent(NowCurrent);
 TH_EXPORT_CPP_API_RemainingEnergy(RemainingEnergy);
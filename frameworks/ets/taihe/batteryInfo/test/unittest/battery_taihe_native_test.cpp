@@ -141,6 +141,12 @@ int64_t BatterySrvClient::GetRemainingChargeTime()
     ++g_count;
     return INVALID_REMAINING_CHARGE_TIME_VALUE;
 }
+
+int64_t BatterySrvClient::GetRemainingDischargeTime()
+{
+    ++g_count;
+    return INVALID_REMAINING_CHARGE_TIME_VALUE;
+}
 }
 
 namespace {
@@ -249,10 +255,11 @@ HWTEST_F(BatteryTaiheNativeTest, BatteryTaiheNativeTest_004, TestSize.Level1)
     IsBatteryPresent();
     GetCapacityLevel();
     EstimatedRemainingChargeTime();
+    EstimatedRemainingDischargeTime();
     TotalEnergy();
     NowCurrent();
     RemainingEnergy();
-    EXPECT_EQ(g_count, 13); // func call counts
+    EXPECT_EQ(g_count, 14); // func call counts
     BATTERY_HILOGI(LABEL_TEST, "BatteryTaiheNativeTest_004 end");
 }
 
@@ -13,9 +13,12 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <string>
+#include <utility>
+#include <vector>
 #include "js_native_api.h"
 #include "js_native_api_types.h"
 #include "napi/native_common.h"
@@ -34,10 +37,33 @@ constexpr int32_t INDEX_2 = 2;
 
 thread_local static BatterySrvClient& g_battClient = BatterySrvClient::GetInstance();
 
+namespace {
+// getters read in one js turn share a snapshot instead of one ipc per property
+constexpr int64_t SNAPSHOT_REUSE_MS = 50;
+
+thread_local BatteryInfoSnapshot g_snapshot;
+thread_local bool g_snapshotValid = false;
+thread_local std::chrono::steady_clock::time_point g_snapshotTime;
+
+const BatteryInfoSnapshot* AcquireSnapshot()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (g_snapshotTime.time_since_epoch().count() != 0 &&
+        now - g_snapshotTime < std::chrono::milliseconds(SNAPSHOT_REUSE_MS)) {
+        return g_snapshotValid ? &g_snapshot : nullptr;
+    }
+    // a failed fetch is also kept for the window so the fallback getters do not pay for it twice
+    g_snapshotValid = (g_battClient.GetBatteryInfoSnapshot(g_snapshot) == BatteryError::ERR_OK);
+    g_snapshotTime = now;
+    return g_snapshotValid ? &g_snapshot : nullptr;
+}
+} // namespace
+
 static napi_value BatterySOC(napi_env env, napi_callback_info info)
 {
     napi_value napiValue = nullptr;
-    int32_t capacity = g_battClient.GetCapacity();
+    const BatteryInfoSnapshot* snapshot = AcquireSnapshot();
+    int32_t capacity = snapshot != nullptr ? snapshot->GetInfo().GetCapacity() : g_battClient.GetCapacity();
 
     NAPI_CALL(env, napi_create_int32(env, capacity, &napiValue));
 
@@ -48,7 +74,9 @@ static napi_value BatterySOC(napi_env env, napi_callback_info info)
 static napi_value GetChargingState(napi_env env, napi_callback_info info)
 {
     napi_value napiValue = nullptr;
-    int32_t chargingState = (int32_t)g_battClient.GetChargingStatus();
+    const BatteryInfoSnapshot* snapshot = AcquireSnapshot();
+    int32_t chargingState = (int32_t)(snapshot != nullptr ? snapshot->GetInfo().GetChargeState() :
+        g_battClient.GetChargingStatus());
 
     NAPI_CALL(env, napi_create_int32(env, chargingState, &napiValue));
 
@@ -60,7 +88,9 @@ static napi_value GetChargingState(napi_env env, napi_callback_info info)
 static napi_value GetHealthState(napi_env env, napi_callback_info info)
 {
     napi_value napiValue = nullptr;
-    int32_t healthStatus = (int32_t)g_battClient.GetHealthStatus();
+    const BatteryInfoSnapshot* snapshot = AcquireSnapshot();
+    int32_t healthStatus = (int32_t)(snapshot != nullptr ? snapshot->GetInfo().GetHealthState() :
+        g_battClient.GetHealthStatus());
 
     NAPI_CALL(env, napi_create_int32(env, healthStatus, &napiValue));
 
@@ -72,7 +102,9 @@ static napi_value GetHealthState(napi_env env, napi_callback_info info)
 static napi_value GetPluggedType(napi_env env, napi_callback_info info)
 {
     napi_value napiValue = nullptr;
-    int32_t pluggedType = (int32_t)g_battClient.GetPluggedType();
+    const BatteryInfoSnapshot* snapshot = AcquireSnapshot();
+    int32_t pluggedType = (int32_t)(snapshot != nullptr ? snapshot->GetInfo().GetPluggedType() :
+        g_battClient.GetPluggedType());
 
     NAPI_CALL(env, napi_create_int32(env, pluggedType, &napiValue));
 
@@ -84,7 +116,8 @@ static napi_value GetPluggedType(napi_env env, napi_callback_info info)
 static napi_value GetVoltage(napi_env env, napi_callback_info info)
 {
     napi_value napiValue = nullptr;
-    int32_t voltage = g_battClient.GetVoltage();
+    const BatteryInfoSnapshot* snapshot = AcquireSnapshot();
+    int32_t voltage = snapshot != nullptr ? snapshot->GetInfo().GetVoltage() : g_battClient.GetVoltage();
 
     NAPI_CALL(env, napi_create_int32(env, voltage, &napiValue));
 
@@ -96,7 +129,8 @@ static napi_value GetVoltage(napi_env env, napi_callback_info info)
 static napi_value GetTechnology(napi_env env, napi_callback_info info)
 {
     napi_value napiValue = nullptr;
-    auto technology = g_battClient.GetTechnology();
+    const BatteryInfoSnapshot* snapshot = AcquireSnapshot();
+    std::string technology = snapshot != nullptr ? snapshot->GetInfo().GetTechnology() : g_battClient.GetTechnology();
     const char* technologyStr = technology.c_str();
 
     NAPI_CALL(env, napi_create_string_utf8(env, technologyStr, strlen(technologyStr), &napiValue));
@@ -108,7 +142,9 @@ static napi_value GetTechnology(napi_env env, napi_callback_info info)
 static napi_value GetBatteryTemperature(napi_env env, napi_callback_info info)
 {
     napi_value napiValue = nullptr;
-    int32_t temperature = g_battClient.GetBatteryTemperature();
+    const BatteryInfoSnapshot* snapshot = AcquireSnapshot();
+    int32_t temperature = snapshot != nullptr ? snapshot->GetInfo().GetTemperature() :
+        g_battClient.GetBatteryTemperature();
 
     NAPI_CALL(env, napi_create_int32(env, temperature, &napiValue));
 
@@ -120,7 +156,8 @@ static napi_value GetBatteryTemperature(napi_env env, napi_callback_info info)
 static napi_value GetBatteryPresent(napi_env env, napi_callback_info info)
 {
     napi_value napiValue = nullptr;
-    bool present = g_battClient.GetPresent();
+    const BatteryInfoSnapshot* snapshot = AcquireSnapshot();
+    bool present = snapshot != nullptr ? snapshot->GetInfo().IsPresent() : g_battClient.GetPresent();
 
     NAPI_CALL(env, napi_get_boolean(env, present, &napiValue));
 
@@ -132,7 +169,8 @@ static napi_value GetBatteryPresent(napi_env env, napi_callback_info info)
 static napi_value GetBatteryNowCurrent(napi_env env, napi_callback_info info)
 {
     napi_value napiValue = nullptr;
-    int32_t curNow = g_battClient.GetNowCurrent();
+    const BatteryInfoSnapshot* snapshot = AcquireSnapshot();
+    int32_t curNow = snapshot != nullptr ? snapshot->GetInfo().GetNowCurrent() : g_battClient.GetNowCurrent();
 
     NAPI_CALL(env, napi_create_int32(env, curNow, &napiValue));
 
@@ -143,7 +181,10 @@ static napi_value GetBatteryNowCurrent(napi_env env, napi_callback_info info)
 static napi_value GetBatteryRemainEnergy(napi_env env, napi_callback_info info)
 {
     napi_value napiValue = nullptr;
-    int32_t remainEnergy = g_battClient.GetRemainEnergy();
+    // the snapshot blanks the energy fields for non-system callers, as the single getter does
+    const BatteryInfoSnapshot* snapshot = AcquireSnapshot();
+    int32_t remainEnergy = snapshot != nullptr ? snapshot->GetInfo().GetRemainEnergy() :
+        g_battClient.GetRemainEnergy();
 
     NAPI_CALL(env, napi_create_int32(env, remainEnergy, &napiValue));
 
@@ -154,7 +195,18 @@ static napi_value GetBatteryRemainEnergy(napi_env env, napi_callback_info info)
 static napi_value GetRemainingChargeTime(napi_env env, napi_callback_info info)
 {
     napi_value napiValue = nullptr;
-    int64_t time = g_battClient.GetRemainingChargeTime();
+    const BatteryInfoSnapshot* snapshot = AcquireSnapshot();
+    int64_t time = snapshot != nullptr ? snapshot->GetRemainingChargeTime() : g_battClient.GetRemainingChargeTime();
+
+    NAPI_CALL(env, napi_create_int64(env, time, &napiValue));
+    return napiValue;
+}
+
+static napi_value GetRemainingDischargeTime(napi_env env, napi_callback_info info)
+{
+    napi_value napiValue = nullptr;
+    // not part of the snapshot
+    int64_t time = g_battClient.GetRemainingDischargeTime();
 
     NAPI_CALL(env, napi_create_int64(env, time, &napiValue));
     return napiValue;
@@ -163,7 +215,9 @@ static napi_value GetRemainingChargeTime(napi_env env, napi_callback_info info)
 static napi_value GetTotalEnergy(napi_env env, napi_callback_info info)
 {
     napi_value napiValue = nullptr;
-    int32_t totalEnergy = (int32_t)g_battClient.GetTotalEnergy();
+    const BatteryInfoSnapshot* snapshot = AcquireSnapshot();
+    int32_t totalEnergy = snapshot != nullptr ? snapshot->GetInfo().GetTotalEnergy() :
+        (int32_t)g_battClient.GetTotalEnergy();
 
     NAPI_CALL(env, napi_create_int32(env, totalEnergy, &napiValue));
 
@@ -174,7 +228,9 @@ static napi_value GetTotalEnergy(napi_env env, napi_callback_info info)
 static napi_value GetCapacityLevel(napi_env env, napi_callback_info info)
 {
     napi_value napiValue = nullptr;
-    int32_t batteryCapacityLevel = (int32_t)g_battClient.GetCapacityLevel();
+    const BatteryInfoSnapshot* snapshot = AcquireSnapshot();
+    int32_t batteryCapacityLevel = (int32_t)(snapshot != nullptr ? snapshot->GetCapacityLevel() :
+        g_battClient.GetCapacityLevel());
 
     NAPI_CALL(env, napi_create_int32(env, batteryCapacityLevel, &napiValue));
 
@@ -271,6 +327,128 @@ static napi_value IsBatteryConfigSupported(napi_env env, napi_callback_info info
     return napiValue;
 }
 
+static bool GetStringProperty(napi_env env, napi_value object, const char* name, std::string& result)
+{
+    napi_value value = nullptr;
+    if (napi_get_named_property(env, object, name, &value) != napi_ok ||
+        !NapiUtils::CheckValueType(env, value, napi_string)) {
+        return false;
+    }
+    result = NapiUtils::GetStringFromNapi(env, value);
+    return true;
+}
+
+static bool GetArrayLength(napi_env env, napi_value value, uint32_t& length)
+{
+    bool isArray = false;
+    if (napi_is_array(env, value, &isArray) != napi_ok || !isArray) {
+        return false;
+    }
+    return napi_get_array_length(env, value, &length) == napi_ok;
+}
+
+static napi_value CreateBatteryConfigResults(napi_env env, const std::vector<std::string>& sceneNames,
+    const std::vector<std::string>& values, const std::vector<BatteryError>& results)
+{
+    napi_value array = nullptr;
+    NAPI_CALL(env, napi_create_array_with_length(env, results.size(), &array));
+    for (size_t i = 0; i < results.size() && i < sceneNames.size() && i < values.size(); i++) {
+        napi_value item = nullptr;
+        napi_value sceneName = nullptr;
+        napi_value sceneValue = nullptr;
+        napi_value errorCode = nullptr;
+        NAPI_CALL(env, napi_create_object(env, &item));
+        NAPI_CALL(env, napi_create_string_utf8(env, sceneNames[i].c_str(), sceneNames[i].size(), &sceneName));
+        NAPI_CALL(env, napi_create_string_utf8(env, values[i].c_str(), values[i].size(), &sceneValue));
+        NAPI_CALL(env, napi_create_int32(env, static_cast<int32_t>(results[i]), &errorCode));
+        NAPI_CALL(env, napi_set_named_property(env, item, "sceneName", sceneName));
+        NAPI_CALL(env, napi_set_named_property(env, item, "sceneValue", sceneValue));
+        NAPI_CALL(env, napi_set_named_property(env, item, "errorCode", errorCode));
+        NAPI_CALL(env, napi_set_element(env, array, i, item));
+    }
+    return array;
+}
+
+static napi_value SetBatteryConfigs(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value argv[argc];
+    NapiUtils::GetCallbackInfo(env, info, argc, argv);
+    NapiError error;
+
+    uint32_t length = 0;
+    if (argc != 1 || !GetArrayLength(env, argv[INDEX_0], length)) {
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "set charge configs failed, param is invalid");
+        error.ThrowError(env, BatteryError::ERR_PARAM_INVALID);
+        return nullptr;
+    }
+    std::vector<std::pair<std::string, std::string>> configs;
+    std::vector<std::string> sceneNames;
+    std::vector<std::string> values;
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value item = nullptr;
+        std::string sceneName;
+        std::string value;
+        if (napi_get_element(env, argv[INDEX_0], i, &item) != napi_ok ||
+            !GetStringProperty(env, item, "sceneName", sceneName) ||
+            !GetStringProperty(env, item, "sceneValue", value)) {
+            BATTERY_HILOGW(FEATURE_BATT_INFO, "set charge configs failed, config %{public}u is invalid", i);
+            error.ThrowError(env, BatteryError::ERR_PARAM_INVALID);
+            return nullptr;
+        }
+        configs.emplace_back(sceneName, value);
+        sceneNames.push_back(sceneName);
+        values.push_back(value);
+    }
+
+    std::vector<BatteryError> results;
+    BatteryError code = g_battClient.SetBatteryConfigs(configs, results);
+    BATTERY_HILOGI(FEATURE_BATT_INFO, "set charge configs, size: %{public}u, ret: %{public}d", length,
+        static_cast<int32_t>(code));
+    if (code != BatteryError::ERR_OK) {
+        error.ThrowError(env, code);
+        return nullptr;
+    }
+    return CreateBatteryConfigResults(env, sceneNames, values, results);
+}
+
+static napi_value GetBatteryConfigs(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value argv[argc];
+    NapiUtils::GetCallbackInfo(env, info, argc, argv);
+    NapiError error;
+
+    uint32_t length = 0;
+    if (argc != 1 || !GetArrayLength(env, argv[INDEX_0], length)) {
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "get charge configs failed, param is invalid");
+        error.ThrowError(env, BatteryError::ERR_PARAM_INVALID);
+        return nullptr;
+    }
+    std::vector<std::string> sceneNames;
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value item = nullptr;
+        if (napi_get_element(env, argv[INDEX_0], i, &item) != napi_ok ||
+            !NapiUtils::CheckValueType(env, item, napi_string)) {
+            BATTERY_HILOGW(FEATURE_BATT_INFO, "get charge configs failed, scene %{public}u is invalid", i);
+            error.ThrowError(env, BatteryError::ERR_PARAM_INVALID);
+            return nullptr;
+        }
+        sceneNames.push_back(NapiUtils::GetStringFromNapi(env, item));
+    }
+
+    std::vector<std::string> values;
+    std::vector<BatteryError> results;
+    BatteryError code = g_battClient.GetBatteryConfigs(sceneNames, values, results);
+    BATTERY_HILOGD(COMP_FWK, "get charge configs, size: %{public}u, ret: %{public}d", length,
+        static_cast<int32_t>(code));
+    if (code != BatteryError::ERR_OK) {
+        error.ThrowError(env, code);
+        return nullptr;
+    }
+    return CreateBatteryConfigResults(env, sceneNames, values, results);
+}
+
 static napi_value EnumHealthClassConstructor(napi_env env, napi_callback_info info)
 {
     napi_value thisArg = nullptr;
@@ -578,12 +756,15 @@ static napi_value BatteryInit(napi_env env, napi_value exports)
         DECLARE_NAPI_GETTER("isBatteryPresent", GetBatteryPresent),
         DECLARE_NAPI_GETTER("batteryCapacityLevel", GetCapacityLevel),
         DECLARE_NAPI_GETTER("estimatedRemainingChargeTime", GetRemainingChargeTime),
+        DECLARE_NAPI_GETTER("estimatedRemainingDischargeTime", GetRemainingDischargeTime),
         DECLARE_NAPI_GETTER("nowCurrent", GetBatteryNowCurrent),
         DECLARE_NAPI_GETTER("remainingEnergy", GetBatteryRemainEnergy),
         DECLARE_NAPI_GETTER("totalEnergy", GetTotalEnergy),
         DECLARE_NAPI_FUNCTION("setBatteryConfig", SetBatteryConfig),
         DECLARE_NAPI_FUNCTION("getBatteryConfig", GetBatteryConfig),
         DECLARE_NAPI_FUNCTION("isBatteryConfigSupported", IsBatteryConfigSupported),
+        DECLARE_NAPI_FUNCTION("setBatteryConfigs", SetBatteryConfigs),
+        DECLARE_NAPI_FUNCTION("getBatteryConfigs", GetBatteryConfigs),
     };
     NAPI_CALL(env, napi_define_properties(env, exports, sizeof(desc) / sizeof(desc[0]), desc));
 
@@ -197,8 +197,14 @@ void SystemBattery::Error::SetErrorMsg(int32_t code, const std::string& msg)
 bool SystemBattery::BatteryInfo::GetBatteryInfo()
 {
     BatterySrvClient& g_battClient = BatterySrvClient::GetInstance();
-    capacity_ = g_battClient.GetCapacity();
-    chargingState_ = g_battClient.GetChargingStatus();
+    BatteryInfoSnapshot snapshot;
+    if (g_battClient.GetBatteryInfoSnapshot(snapshot) == BatteryError::ERR_OK) {
+        capacity_ = snapshot.GetInfo().GetCapacity();
+        chargingState_ = snapshot.GetInfo().GetChargeState();
+    } else {
+        capacity_ = g_battClient.GetCapacity();
+        chargingState_ = g_battClient.GetChargingStatus();
+    }
     BATTERY_HILOGI(FEATURE_BATT_INFO, "Get battery info, capacity: %{public}d, charging: %{public}d",
         capacity_, static_cast<int32_t>(chargingState_));
     return (capacity_ != INVALID_BATT_INT_VALUE) && (chargingState_ != BatteryChargeState::CHARGE_STATE_BUTT);
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_charge_sessions.h"
+
+#include <new>
+
+#include "battery_log.h"
+#include "battery_parcel_payload.h"
+#include "power_common.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+bool WriteSession(Parcel& parcel, const BatteryChargeSessions::Session& session)
+{
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int64, session.startTime, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int64, session.duration, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Uint32, static_cast<uint32_t>(session.pluggedType), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, session.startCapacity, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, session.endCapacity, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, session.chargeDelivered, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, session.energyDelivered, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, session.peakCurrent, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, session.averageCurrent, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, session.minTemperature, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, session.maxTemperature, false);
+    // the count goes first so a reader knowing fewer charge types can skip the rest
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Uint32, static_cast<uint32_t>(session.chargeTypeTime.size()), false);
+    for (int64_t time : session.chargeTypeTime) {
+        RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int64, time, false);
+    }
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Bool, session.active, false);
+    return true;
+}
+
+bool ReadSession(Parcel& parcel, BatteryChargeSessions::Session& session)
+{
+    uint32_t pluggedType = 0;
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int64, session.startTime, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int64, session.duration, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Uint32, pluggedType, false);
+    session.pluggedType = static_cast<BatteryPluggedType>(pluggedType);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, session.startCapacity, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, session.endCapacity, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, session.chargeDelivered, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, session.energyDelivered, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, session.peakCurrent, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, session.averageCurrent, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, session.minTemperature, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, session.maxTemperature, false);
+    uint32_t chargeTypeCount = 0;
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Uint32, chargeTypeCount, false);
+    for (uint32_t i = 0; i < chargeTypeCount; i++) {
+        int64_t time = 0;
+        RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int64, time, false);
+        if (i < session.chargeTypeTime.size()) {
+            session.chargeTypeTime[i] = time;
+        }
+    }
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Bool, session.active, false);
+    return true;
+}
+}
+
+bool BatteryChargeSessions::Marshalling(Parcel& parcel) const
+{
+    return WriteVersionedPayload(parcel, version_, [this](Parcel& payload) { return WriteFields(payload); });
+}
+
+bool BatteryChargeSessions::WriteFields(Parcel& parcel) const
+{
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Uint32, static_cast<uint32_t>(sessions_.size()), false);
+    for (const Session& session : sessions_) {
+        if (!WriteSizedPayload(parcel, [&session](Parcel& payload) { return WriteSession(payload, session); })) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BatteryChargeSessions::ReadFromParcel(Parcel& parcel)
+{
+    return ReadVersionedPayload(parcel, version_, [this](Parcel& payload) { return ReadFields(payload); });
+}
+
+bool BatteryChargeSessions::ReadFields(Parcel& parcel)
+{
+    if (version_ == 0) {
+        BATTERY_HILOGW(COMP_FWK, "invalid charge sessions version");
+        return false;
+    }
+    uint32_t count = 0;
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Uint32, count, false);
+    if (count > MAX_SESSIONS) {
+        BATTERY_HILOGW(COMP_FWK, "too many charge sessions %{public}u", count);
+        return false;
+    }
+    sessions_.assign(count, Session());
+    for (Session& session : sessions_) {
+        if (!ReadSizedPayload(parcel, [&session](Parcel& payload) { return ReadSession(payload, session); })) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BatteryChargeSessions* BatteryChargeSessions::Unmarshalling(Parcel& parcel)
+{
+    BatteryChargeSessions* sessions = new (std::nothrow) BatteryChargeSessions();
+    if (sessions == nullptr) {
+        BATTERY_HILOGE(COMP_FWK, "create battery charge sessions failed");
+        return nullptr;
+    }
+    if (!sessions->ReadFromParcel(parcel)) {
+        delete sessions;
+        return nullptr;
+    }
+    return sessions;
+}
+} // namespace PowerMgr
+} // namespace OHOS
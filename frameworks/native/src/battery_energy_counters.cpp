@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_energy_counters.h"
+
+#include <new>
+
+#include "battery_log.h"
+#include "battery_parcel_payload.h"
+#include "power_common.h"
+
+namespace OHOS {
+namespace PowerMgr {
+bool BatteryEnergyCounters::Marshalling(Parcel& parcel) const
+{
+    return WriteVersionedPayload(parcel, version_, [this](Parcel& payload) { return WriteFields(payload); });
+}
+
+bool BatteryEnergyCounters::WriteFields(Parcel& parcel) const
+{
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int64, counters_.time, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Uint64, counters_.sampleCount, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int64, counters_.chargeIn, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int64, counters_.chargeOut, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int64, counters_.energyIn, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int64, counters_.energyOut, false);
+    return true;
+}
+
+bool BatteryEnergyCounters::ReadFromParcel(Parcel& parcel)
+{
+    return ReadVersionedPayload(parcel, version_, [this](Parcel& payload) { return ReadFields(payload); });
+}
+
+bool BatteryEnergyCounters::ReadFields(Parcel& parcel)
+{
+    if (version_ == 0) {
+        BATTERY_HILOGW(COMP_FWK, "invalid energy counters version");
+        return false;
+    }
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int64, counters_.time, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Uint64, counters_.sampleCount, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int64, counters_.chargeIn, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int64, counters_.chargeOut, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int64, counters_.energyIn, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int64, counters_.energyOut, false);
+    return true;
+}
+
+BatteryEnergyCounters* BatteryEnergyCounters::Unmarshalling(Parcel& parcel)
+{
+    BatteryEnergyCounters* counters = new (std::nothrow) BatteryEnergyCounters();
+    if (counters == nullptr) {
+        BATTERY_HILOGE(COMP_FWK, "create battery energy counters failed");
+        return nullptr;
+    }
+    if (!counters->ReadFromParcel(parcel)) {
+        delete counters;
+        return nullptr;
+    }
+    return counters;
+}
+} // namespace PowerMgr
+} // namespace OHOS
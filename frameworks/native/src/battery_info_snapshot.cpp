@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_info_snapshot.h"
+
+#include <new>
+
+#include "battery_log.h"
+#include "battery_parcel_payload.h"
+#include "power_common.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr uint32_t VERSION_CONFIDENCE = 2;
+}
+
+bool BatteryInfoSnapshot::Marshalling(Parcel& parcel) const
+{
+    return WriteVersionedPayload(parcel, version_, [this](Parcel& payload) { return WriteFields(payload); });
+}
+
+bool BatteryInfoSnapshot::WriteFields(Parcel& parcel) const
+{
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Uint64, sequence_, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int64, timestamp_, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, info_.GetCapacity(), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, info_.GetVoltage(), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, info_.GetTemperature(), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Uint32, ToUnderlying(info_.GetHealthState()), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Uint32, ToUnderlying(info_.GetPluggedType()), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, info_.GetPluggedMaxCurrent(), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, info_.GetPluggedMaxVoltage(), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Uint32, ToUnderlying(info_.GetChargeState()), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, info_.GetChargeCounter(), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Bool, info_.IsPresent(), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, String, info_.GetTechnology(), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, info_.GetTotalEnergy(), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, info_.GetCurAverage(), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, info_.GetNowCurrent(), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, info_.GetRemainEnergy(), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Uint32, ToUnderlying(info_.GetChargeType()), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Uint32, ToUnderlying(capacityLevel_), false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int64, remainingChargeTime_, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, remainingChargeTimeConfidence_, false);
+    return true;
+}
+
+bool BatteryInfoSnapshot::ReadFromParcel(Parcel& parcel)
+{
+    return ReadVersionedPayload(parcel, version_, [this](Parcel& payload) { return ReadFields(payload); });
+}
+
+bool BatteryInfoSnapshot::ReadFields(Parcel& parcel)
+{
+    if (version_ == 0) {
+        BATTERY_HILOGW(COMP_FWK, "invalid snapshot version");
+        return false;
+    }
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Uint64, sequence_, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int64, timestamp_, false);
+
+    int32_t capacity = INVALID_BATT_INT_VALUE;
+    int32_t voltage = INVALID_BATT_INT_VALUE;
+    int32_t temperature = INVALID_BATT_TEMP_VALUE;
+    uint32_t healthState = 0;
+    uint32_t pluggedType = 0;
+    int32_t pluggedMaxCurrent = INVALID_BATT_INT_VALUE;
+    int32_t pluggedMaxVoltage = INVALID_BATT_INT_VALUE;
+    uint32_t chargeState = 0;
+    int32_t chargeCounter = INVALID_BATT_INT_VALUE;
+    bool present = false;
+    std::string technology;
+    int32_t totalEnergy = INVALID_BATT_INT_VALUE;
+    int32_t curAverage = INVALID_BATT_INT_VALUE;
+    int32_t nowCurr = INVALID_BATT_INT_VALUE;
+    int32_t remainEnergy = INVALID_BATT_INT_VALUE;
+    uint32_t chargeType = 0;
+    uint32_t capacityLevel = 0;
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, capacity, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, voltage, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, temperature, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Uint32, healthState, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Uint32, pluggedType, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, pluggedMaxCurrent, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, pluggedMaxVoltage, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Uint32, chargeState, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, chargeCounter, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Bool, present, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, String, technology, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, totalEnergy, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, curAverage, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, nowCurr, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, remainEnergy, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Uint32, chargeType, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Uint32, capacityLevel, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int64, remainingChargeTime_, false);
+    remainingChargeTimeConfidence_ = 0;
+    if (version_ >= VERSION_CONFIDENCE) {
+        RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, remainingChargeTimeConfidence_, false);
+    }
+
+    info_.SetCapacity(capacity);
+    info_.SetVoltage(voltage);
+    info_.SetTemperature(temperature);
+    info_.SetHealthState(static_cast<BatteryHealthState>(healthState));
+    info_.SetPluggedType(static_cast<BatteryPluggedType>(pluggedType));
+    info_.SetPluggedMaxCurrent(pluggedMaxCurrent);
+    info_.SetPluggedMaxVoltage(pluggedMaxVoltage);
+    info_.SetChargeState(static_cast<BatteryChargeState>(chargeState));
+    info_.SetChargeCounter(chargeCounter);
+    info_.SetPresent(present);
+    info_.SetTechnology(technology);
+    info_.SetTotalEnergy(totalEnergy);
+    info_.SetCurAverage(curAverage);
+    info_.SetNowCurrent(nowCurr);
+    info_.SetRemainEnergy(remainEnergy);
+    info_.SetChargeType(static_cast<ChargeType>(chargeType));
+    capacityLevel_ = static_cast<BatteryCapacityLevel>(capacityLevel);
+    return true;
+}
+
+BatteryInfoSnapshot* BatteryInfoSnapshot::Unmarshalling(Parcel& parcel)
+{
+    BatteryInfoSnapshot* snapshot = new (std::nothrow) BatteryInfoSnapshot();
+    if (snapshot == nullptr) {
+        BATTERY_HILOGE(COMP_FWK, "create battery info snapshot failed");
+        return nullptr;
+    }
+    if (!snapshot->ReadFromParcel(parcel)) {
+        delete snapshot;
+        return nullptr;
+    }
+    return snapshot;
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_listener_proxy.h"
+
+#include <message_option.h>
+#include <message_parcel.h>
+
+#include "battery_log.h"
+#include "power_common.h"
+
+namespace OHOS {
+namespace PowerMgr {
+void BatteryListenerProxy::OnBatteryChanged(uint32_t changedFields, const BatteryInfoSnapshot& snapshot)
+{
+    sptr<IRemoteObject> remote = Remote();
+    RETURN_IF(remote == nullptr);
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_ASYNC);
+    if (!data.WriteInterfaceToken(BatteryListenerProxy::GetDescriptor())) {
+        BATTERY_HILOGE(COMP_FWK, "write descriptor failed");
+        return;
+    }
+    RETURN_IF_WRITE_PARCEL_FAILED_NO_RET(data, Uint32, changedFields);
+    RETURN_IF_WRITE_PARCEL_FAILED_NO_RET(data, Parcelable, &snapshot);
+    int ret = remote->SendRequest(static_cast<uint32_t>(IBatteryListener::Code::ON_BATTERY_CHANGED), data, reply,
+        option);
+    if (ret != ERR_OK) {
+        BATTERY_HILOGW(COMP_FWK, "OnBatteryChanged send failed, ret=%{public}d", ret);
+    }
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_listener_stub.h"
+
+#include <memory>
+#include <message_parcel.h>
+
+#include "battery_log.h"
+#include "errors.h"
+#include "power_common.h"
+
+namespace OHOS {
+namespace PowerMgr {
+int BatteryListenerStub::OnRemoteRequest(uint32_t code, MessageParcel& data, MessageParcel& reply,
+    MessageOption& option)
+{
+    if (data.ReadInterfaceToken() != GetDescriptor()) {
+        BATTERY_HILOGE(COMP_FWK, "descriptor is not matched");
+        return ERR_INVALID_DATA;
+    }
+    if (code != static_cast<uint32_t>(IBatteryListener::Code::ON_BATTERY_CHANGED)) {
+        return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
+    }
+    uint32_t changedFields = 0;
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(data, Uint32, changedFields, ERR_INVALID_DATA);
+    std::unique_ptr<BatteryInfoSnapshot> snapshot(data.ReadParcelable<BatteryInfoSnapshot>());
+    if (snapshot == nullptr) {
+        BATTERY_HILOGE(COMP_FWK, "read battery info snapshot failed");
+        return ERR_INVALID_DATA;
+    }
+    OnBatteryChanged(changedFields, *snapshot);
+    return ERR_OK;
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -15,6 +15,8 @@
 
 #include "battery_srv_client.h"
 
+#include <algorithm>
+#include <functional>
 #include "new"
 #include "refbase.h"
 #include "errors.h"
@@ -22,6 +24,7 @@
 #include "iservice_registry.h"
 #include "if_system_ability_manager.h"
 #include "system_ability_definition.h"
+#include "system_ability_status_change_stub.h"
 #include "battery_info.h"
 #include "battery_log.h"
 #include "power_mgr_errors.h"
@@ -29,6 +32,24 @@
 
 namespace OHOS {
 namespace PowerMgr {
+namespace {
+class BatterySrvStatusListener : public SystemAbilityStatusChangeStub {
+public:
+    explicit BatterySrvStatusListener(const std::function<void()>& onAdded) : onAdded_(onAdded) {}
+    ~BatterySrvStatusListener() override = default;
+    void OnAddSystemAbility(int32_t systemAbilityId, const std::string& deviceId) override
+    {
+        if (systemAbilityId == POWER_MANAGER_BATT_SERVICE_ID) {
+            onAdded_();
+        }
+    }
+    void OnRemoveSystemAbility(int32_t systemAbilityId, const std::string& deviceId) override {}
+
+private:
+    std::function<void()> onAdded_;
+};
+}
+
 BatterySrvClient::BatterySrvClient() {}
 BatterySrvClient::~BatterySrvClient() {}
 
@@ -86,6 +107,47 @@ void BatterySrvClient::BatterySrvDeathRecipient::OnRemoteDied(const wptr<IRemote
     client_.ResetProxy(remote);
 }
 
+void BatterySrvClient::SubscribeSrvStatus()
+{
+    std::lock_guard<std::mutex> lock(listenerMutex_);
+    RETURN_IF(statusListener_ != nullptr);
+    sptr<ISystemAbilityManager> sysMgr = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    if (sysMgr == nullptr) {
+        BATTERY_HILOGE(COMP_FWK, "Failed to get Registry");
+        return;
+    }
+    sptr<ISystemAbilityStatusChange> statusListener =
+        new (std::nothrow) BatterySrvStatusListener([this] { RestoreListeners(); });
+    RETURN_IF(statusListener == nullptr);
+    if (sysMgr->SubscribeSystemAbility(POWER_MANAGER_BATT_SERVICE_ID, statusListener) != ERR_OK) {
+        BATTERY_HILOGE(COMP_FWK, "Subscribe BatteryService status failed");
+        return;
+    }
+    statusListener_ = statusListener->AsObject();
+}
+
+void BatterySrvClient::RestoreListeners()
+{
+    std::lock_guard<std::mutex> transactionLock(listenerTransactionMutex_);
+    std::vector<ListenerEntry> listeners;
+    {
+        std::lock_guard<std::mutex> lock(listenerMutex_);
+        listeners = listeners_;
+    }
+    RETURN_IF(listeners.empty());
+    auto proxy = Connect();
+    RETURN_IF(proxy == nullptr);
+    for (const auto& entry : listeners) {
+        int32_t batteryErr = static_cast<int32_t>(BatteryError::ERR_CONNECTION_FAIL);
+        auto ret = proxy->RegisterBatteryListener(entry.listener, entry.fieldMask, entry.minIntervalMs, batteryErr);
+        if ((ret != ERR_OK) || (batteryErr != static_cast<int32_t>(BatteryError::ERR_OK))) {
+            BATTERY_HILOGE(COMP_FWK, "Restore listener failed, ret=%{public}d, batteryErr=%{public}d", ret,
+                batteryErr);
+        }
+    }
+    BATTERY_HILOGI(COMP_FWK, "Restored %{public}zu battery listeners", listeners.size());
+}
+
 int32_t BatterySrvClient::GetCapacity()
 {
     auto proxy = Connect();
@@ -255,6 +317,19 @@ int64_t BatterySrvClient::GetRemainingChargeTime()
     return remainTime;
 }
 
+int64_t BatterySrvClient::GetRemainingDischargeTime()
+{
+    auto proxy = Connect();
+    RETURN_IF_WITH_RET(proxy == nullptr, INVALID_REMAINING_CHARGE_TIME_VALUE);
+    int64_t remainTime = INVALID_REMAINING_CHARGE_TIME_VALUE;
+    auto ret = proxy->GetRemainingDischargeTime(remainTime);
+    if (ret != ERR_OK) {
+        BATTERY_HILOGE(COMP_FWK, "GetRemainingDischargeTime ret = %{public}d", ret);
+        return INVALID_REMAINING_CHARGE_TIME_VALUE;
+    }
+    return remainTime;
+}
+
 BatteryError BatterySrvClient::SetBatteryConfig(const std::string& sceneName, const std::string& value)
 {
     auto proxy = Connect();
@@ -293,5 +368,153 @@ BatteryError BatterySrvClient::IsBatteryConfigSupported(const std::string& scene
     }
     return static_cast<BatteryError>(batteryErr);
 }
+
+BatteryError BatterySrvClient::GetBatteryInfoSnapshot(BatteryInfoSnapshot& snapshot)
+{
+    auto proxy = Connect();
+    RETURN_IF_WITH_RET(proxy == nullptr, BatteryError::ERR_CONNECTION_FAIL);
+    int32_t batteryErr = static_cast<int32_t>(BatteryError::ERR_CONNECTION_FAIL);
+    auto ret = proxy->GetBatteryInfoSnapshot(snapshot, batteryErr);
+    if (ret != ERR_OK) {
+        BATTERY_HILOGE(COMP_FWK, "GetBatteryInfoSnapshot ret = %{public}d", ret);
+        return BatteryError::ERR_CONNECTION_FAIL;
+    }
+    return static_cast<BatteryError>(batteryErr);
+}
+
+BatteryError BatterySrvClient::SetBatteryConfigs(const std::vector<std::pair<std::string, std::string>>& configs,
+    std::vector<BatteryError>& results)
+{
+    results.clear();
+    auto proxy = Connect();
+    RETURN_IF_WITH_RET(proxy == nullptr, BatteryError::ERR_CONNECTION_FAIL);
+    std::vector<std::string> sceneNames;
+    std::vector<std::string> values;
+    for (const auto& config : configs) {
+        sceneNames.push_back(config.first);
+        values.push_back(config.second);
+    }
+    std::vector<int32_t> batteryErrs;
+    int32_t batteryErr = static_cast<int32_t>(BatteryError::ERR_CONNECTION_FAIL);
+    auto ret = proxy->SetBatteryConfigs(sceneNames, values, batteryErrs, batteryErr);
+    if (ret != ERR_OK) {
+        BATTERY_HILOGE(COMP_FWK, "SetBatteryConfigs ret = %{public}d", ret);
+        return BatteryError::ERR_CONNECTION_FAIL;
+    }
+    for (int32_t err : batteryErrs) {
+        results.push_back(static_cast<BatteryError>(err));
+    }
+    return static_cast<BatteryError>(batteryErr);
+}
+
+BatteryError BatterySrvClient::GetBatteryConfigs(const std::vector<std::string>& sceneNames,
+    std::vector<std::string>& values, std::vector<BatteryError>& results)
+{
+    values.clear();
+    results.clear();
+    auto proxy = Connect();
+    RETURN_IF_WITH_RET(proxy == nullptr, BatteryError::ERR_CONNECTION_FAIL);
+    std::vector<int32_t> batteryErrs;
+    int32_t batteryErr = static_cast<int32_t>(BatteryError::ERR_CONNECTION_FAIL);
+    auto ret = proxy->GetBatteryConfigs(sceneNames, values, batteryErrs, batteryErr);
+    if (ret != ERR_OK) {
+        BATTERY_HILOGE(COMP_FWK, "GetBatteryConfigs ret = %{public}d", ret);
+        return BatteryError::ERR_CONNECTION_FAIL;
+    }
+    for (int32_t err : batteryErrs) {
+        results.push_back(static_cast<BatteryError>(err));
+    }
+    return static_cast<BatteryError>(batteryErr);
+}
+
+BatteryError BatterySrvClient::GetBatteryStats(int32_t windowSeconds, BatteryWindowStats& stats)
+{
+    auto proxy = Connect();
+    RETURN_IF_WITH_RET(proxy == nullptr, BatteryError::ERR_CONNECTION_FAIL);
+    int32_t batteryErr = static_cast<int32_t>(BatteryError::ERR_CONNECTION_FAIL);
+    auto ret = proxy->GetBatteryStats(windowSeconds, stats, batteryErr);
+    if (ret != ERR_OK) {
+        BATTERY_HILOGE(COMP_FWK, "GetBatteryStats ret = %{public}d", ret);
+        return BatteryError::ERR_CONNECTION_FAIL;
+    }
+    return static_cast<BatteryError>(batteryErr);
+}
+
+BatteryError BatterySrvClient::GetChargeSessions(BatteryChargeSessions& sessions)
+{
+    auto proxy = Connect();
+    RETURN_IF_WITH_RET(proxy == nullptr, BatteryError::ERR_CONNECTION_FAIL);
+    int32_t batteryErr = static_cast<int32_t>(BatteryError::ERR_CONNECTION_FAIL);
+    auto ret = proxy->GetChargeSessions(sessions, batteryErr);
+    if (ret != ERR_OK) {
+        BATTERY_HILOGE(COMP_FWK, "GetChargeSessions ret = %{public}d", ret);
+        return BatteryError::ERR_CONNECTION_FAIL;
+    }
+    return static_cast<BatteryError>(batteryErr);
+}
+
+BatteryError BatterySrvClient::GetEnergyCounters(BatteryEnergyCounters& counters)
+{
+    auto proxy = Connect();
+    RETURN_IF_WITH_RET(proxy == nullptr, BatteryError::ERR_CONNECTION_FAIL);
+    int32_t batteryErr = static_cast<int32_t>(BatteryError::ERR_CONNECTION_FAIL);
+    auto ret = proxy->GetEnergyCounters(counters, batteryErr);
+    if (ret != ERR_OK) {
+        BATTERY_HILOGE(COMP_FWK, "GetEnergyCounters ret = %{public}d", ret);
+        return BatteryError::ERR_CONNECTION_FAIL;
+    }
+    return static_cast<BatteryError>(batteryErr);
+}
+
+BatteryError BatterySrvClient::RegisterBatteryListener(const sptr<IBatteryListener>& listener, uint32_t fieldMask,
+    int64_t minIntervalMs)
+{
+    RETURN_IF_WITH_RET(listener == nullptr, BatteryError::ERR_PARAM_INVALID);
+    {
+        std::lock_guard<std::mutex> transactionLock(listenerTransactionMutex_);
+        auto proxy = Connect();
+        RETURN_IF_WITH_RET(proxy == nullptr, BatteryError::ERR_CONNECTION_FAIL);
+        int32_t batteryErr = static_cast<int32_t>(BatteryError::ERR_CONNECTION_FAIL);
+        auto ret = proxy->RegisterBatteryListener(listener, fieldMask, minIntervalMs, batteryErr);
+        if (ret != ERR_OK) {
+            BATTERY_HILOGE(COMP_FWK, "RegisterBatteryListener ret = %{public}d", ret);
+            return BatteryError::ERR_CONNECTION_FAIL;
+        }
+        RETURN_IF_WITH_RET(batteryErr != static_cast<int32_t>(BatteryError::ERR_OK),
+            static_cast<BatteryError>(batteryErr));
+        std::lock_guard<std::mutex> lock(listenerMutex_);
+        auto it = std::find_if(listeners_.begin(), listeners_.end(),
+            [&listener](const ListenerEntry& entry) { return entry.listener == listener; });
+        if (it != listeners_.end()) {
+            it->fieldMask = fieldMask;
+            it->minIntervalMs = minIntervalMs;
+        } else {
+            listeners_.push_back({ listener, fieldMask, minIntervalMs });
+        }
+    }
+    SubscribeSrvStatus();
+    return BatteryError::ERR_OK;
+}
+
+BatteryError BatterySrvClient::UnregisterBatteryListener(const sptr<IBatteryListener>& listener)
+{
+    RETURN_IF_WITH_RET(listener == nullptr, BatteryError::ERR_PARAM_INVALID);
+    // a restore either registered it before or no longer sees it
+    std::lock_guard<std::mutex> transactionLock(listenerTransactionMutex_);
+    {
+        std::lock_guard<std::mutex> lock(listenerMutex_);
+        listeners_.erase(std::remove_if(listeners_.begin(), listeners_.end(),
+            [&listener](const ListenerEntry& entry) { return entry.listener == listener; }), listeners_.end());
+    }
+    auto proxy = Connect();
+    RETURN_IF_WITH_RET(proxy == nullptr, BatteryError::ERR_CONNECTION_FAIL);
+    int32_t batteryErr = static_cast<int32_t>(BatteryError::ERR_CONNECTION_FAIL);
+    auto ret = proxy->UnregisterBatteryListener(listener, batteryErr);
+    if (ret != ERR_OK) {
+        BATTERY_HILOGE(COMP_FWK, "UnregisterBatteryListener ret = %{public}d", ret);
+        return BatteryError::ERR_CONNECTION_FAIL;
+    }
+    return static_cast<BatteryError>(batteryErr);
+}
 }  // namespace PowerMgr
 }  // namespace OHOS
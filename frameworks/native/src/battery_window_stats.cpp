@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_window_stats.h"
+
+#include <new>
+
+#include "battery_log.h"
+#include "battery_parcel_payload.h"
+#include "power_common.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+bool WriteAggregate(Parcel& parcel, const BatteryWindowStats::Aggregate& aggregate)
+{
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, aggregate.min, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, aggregate.max, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, aggregate.avg, false);
+    return true;
+}
+
+bool ReadAggregate(Parcel& parcel, BatteryWindowStats::Aggregate& aggregate)
+{
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, aggregate.min, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, aggregate.max, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, aggregate.avg, false);
+    return true;
+}
+}
+
+bool BatteryWindowStats::Marshalling(Parcel& parcel) const
+{
+    return WriteVersionedPayload(parcel, version_, [this](Parcel& payload) { return WriteFields(payload); });
+}
+
+bool BatteryWindowStats::WriteFields(Parcel& parcel) const
+{
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Int32, windowSeconds_, false);
+    RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(parcel, Uint32, sampleCount_, false);
+    return WriteAggregate(parcel, current_) && WriteAggregate(parcel, voltage_) &&
+        WriteAggregate(parcel, temperature_);
+}
+
+bool BatteryWindowStats::ReadFromParcel(Parcel& parcel)
+{
+    return ReadVersionedPayload(parcel, version_, [this](Parcel& payload) { return ReadFields(payload); });
+}
+
+bool BatteryWindowStats::ReadFields(Parcel& parcel)
+{
+    if (version_ == 0) {
+        BATTERY_HILOGW(COMP_FWK, "invalid window stats version");
+        return false;
+    }
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Int32, windowSeconds_, false);
+    RETURN_IF_READ_PARCEL_FAILED_WITH_RET(parcel, Uint32, sampleCount_, false);
+    return ReadAggregate(parcel, current_) && ReadAggregate(parcel, voltage_) &&
+        ReadAggregate(parcel, temperature_);
+}
+
+BatteryWindowStats* BatteryWindowStats::Unmarshalling(Parcel& parcel)
+{
+    BatteryWindowStats* stats = new (std::nothrow) BatteryWindowStats();
+    if (stats == nullptr) {
+        BATTERY_HILOGE(COMP_FWK, "create battery window stats failed");
+        return nullptr;
+    }
+    if (!stats->ReadFromParcel(parcel)) {
+        delete stats;
+        return nullptr;
+    }
+    return stats;
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_SRV_BATTERY_CHARGE_SESSIONS_H
+#define BATTERY_SRV_BATTERY_CHARGE_SESSIONS_H
+
+#include <array>
+#include <cstdint>
+#include <parcel.h>
+#include <vector>
+
+#include "battery_info.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Statistics of the last charge sessions, oldest first. A session runs from plugging in to unplugging,
+ * the running one is last and marked active.
+ *
+ * Fields are written in a fixed order after the version and the payload size, each session is prefixed
+ * with its own size. Newer versions only append fields to the list or to a session, a reader skips the
+ * ones it does not know by those sizes.
+ */
+class BatteryChargeSessions : public Parcelable {
+public:
+    static constexpr uint32_t VERSION = 1;
+    // ChargeType::NONE to ChargeType::WIRELESS_SUPER_QUICK
+    static constexpr size_t CHARGE_TYPE_COUNT = static_cast<size_t>(ChargeType::WIRELESS_SUPER_QUICK) + 1;
+    // bound on the sessions read from a parcel
+    static constexpr uint32_t MAX_SESSIONS = 64;
+
+    struct Session {
+        int64_t startTime { 0 }; // ms since the epoch
+        int64_t duration { 0 };  // ms
+        BatteryPluggedType pluggedType { BatteryPluggedType::PLUGGED_TYPE_NONE };
+        int32_t startCapacity { 0 };
+        int32_t endCapacity { 0 };
+        int32_t chargeDelivered { 0 }; // mAh, the now current integrated over the session
+        int32_t energyDelivered { 0 }; // mWh, the now current times the voltage integrated over the session
+        int32_t peakCurrent { 0 };     // mA
+        int32_t averageCurrent { 0 };  // mA
+        int32_t minTemperature { 0 };  // 0.1 degrees Celsius
+        int32_t maxTemperature { 0 };  // 0.1 degrees Celsius
+        std::array<int64_t, CHARGE_TYPE_COUNT> chargeTypeTime {}; // ms spent in each ChargeType
+        bool active { false };
+    };
+
+    BatteryChargeSessions() = default;
+    ~BatteryChargeSessions() override = default;
+
+    bool Marshalling(Parcel& parcel) const override;
+    static BatteryChargeSessions* Unmarshalling(Parcel& parcel);
+    bool ReadFromParcel(Parcel& parcel);
+
+    void SetSessions(const std::vector<Session>& sessions)
+    {
+        sessions_ = sessions;
+    }
+
+    const std::vector<Session>& GetSessions() const
+    {
+        return sessions_;
+    }
+
+    uint32_t GetVersion() const
+    {
+        return version_;
+    }
+
+private:
+    bool WriteFields(Parcel& parcel) const;
+    bool ReadFields(Parcel& parcel);
+
+    uint32_t version_ { VERSION };
+    std::vector<Session> sessions_;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+
+#endif // BATTERY_SRV_BATTERY_CHARGE_SESSIONS_H
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_SRV_BATTERY_ENERGY_COUNTERS_H
+#define BATTERY_SRV_BATTERY_ENERGY_COUNTERS_H
+
+#include <cstdint>
+#include <parcel.h>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Monotonic charge and energy totals the service integrated from the battery current and voltage since it
+ * started. The consumption over an interval is the difference of two readings taken at its ends.
+ *
+ * Fields are written in a fixed order after the version and the payload size. Newer versions only append
+ * fields, a reader skips the ones it does not know by the payload size.
+ */
+class BatteryEnergyCounters : public Parcelable {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    struct Counters {
+        int64_t time { 0 };          // ms since boot, including the time spent suspended
+        uint64_t sampleCount { 0 };  // battery events integrated
+        int64_t chargeIn { 0 };      // uAh flowing into the battery
+        int64_t chargeOut { 0 };     // uAh drawn from the battery
+        int64_t energyIn { 0 };      // uWh flowing into the battery
+        int64_t energyOut { 0 };     // uWh drawn from the battery
+    };
+
+    BatteryEnergyCounters() = default;
+    ~BatteryEnergyCounters() override = default;
+
+    bool Marshalling(Parcel& parcel) const override;
+    static BatteryEnergyCounters* Unmarshalling(Parcel& parcel);
+    bool ReadFromParcel(Parcel& parcel);
+
+    void SetCounters(const Counters& counters)
+    {
+        counters_ = counters;
+    }
+
+    const Counters& GetCounters() const
+    {
+        return counters_;
+    }
+
+    uint32_t GetVersion() const
+    {
+        return version_;
+    }
+
+private:
+    bool WriteFields(Parcel& parcel) const;
+    bool ReadFields(Parcel& parcel);
+
+    uint32_t version_ { VERSION };
+    Counters counters_;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+
+#endif // BATTERY_SRV_BATTERY_ENERGY_COUNTERS_H
@@ -228,6 +228,32 @@ public:
         COMMON_EVENT_CODE_CAPACITY_LEVEL = 11,
         COMMON_EVENT_CODE_PLUGGED_NOW_CURRENT = 12,
     };
+
+    /**
+     * Bits of the mask returned by GetChangedFields, one per field.
+     */
+    enum ChangedField : uint32_t {
+        FIELD_NONE = 0,
+        FIELD_PRESENT = 1U << 0,
+        FIELD_CAPACITY = 1U << 1,
+        FIELD_VOLTAGE = 1U << 2,
+        FIELD_TEMPERATURE = 1U << 3,
+        FIELD_TOTAL_ENERGY = 1U << 4,
+        FIELD_CUR_AVERAGE = 1U << 5,
+        FIELD_NOW_CURRENT = 1U << 6,
+        FIELD_PLUGGED_MAX_CURRENT = 1U << 7,
+        FIELD_PLUGGED_MAX_VOLTAGE = 1U << 8,
+        FIELD_CHARGE_COUNTER = 1U << 9,
+        FIELD_HEALTH_STATE = 1U << 10,
+        FIELD_PLUGGED_TYPE = 1U << 11,
+        FIELD_REMAIN_ENERGY = 1U << 12,
+        FIELD_CHARGE_STATE = 1U << 13,
+        FIELD_TECHNOLOGY = 1U << 14,
+        FIELD_UEVENT = 1U << 15,
+        FIELD_CHARGE_TYPE = 1U << 16,
+        FIELD_ALL = 0xFFFFFFFFU,
+    };
+
     BatteryInfo() = default;
     ~BatteryInfo() = default;
 
@@ -428,6 +454,29 @@ public:
         return !(*this == info);
     }
 
+    uint32_t GetChangedFields(const BatteryInfo& info) const
+    {
+        uint32_t fields = FIELD_NONE;
+        fields |= (present_ != info.IsPresent()) ? FIELD_PRESENT : FIELD_NONE;
+        fields |= (capacity_ != info.GetCapacity()) ? FIELD_CAPACITY : FIELD_NONE;
+        fields |= (voltage_ != info.GetVoltage()) ? FIELD_VOLTAGE : FIELD_NONE;
+        fields |= (temperature_ != info.GetTemperature()) ? FIELD_TEMPERATURE : FIELD_NONE;
+        fields |= (totalEnergy_ != info.GetTotalEnergy()) ? FIELD_TOTAL_ENERGY : FIELD_NONE;
+        fields |= (curAverage_ != info.GetCurAverage()) ? FIELD_CUR_AVERAGE : FIELD_NONE;
+        fields |= (nowCurr_ != info.GetNowCurrent()) ? FIELD_NOW_CURRENT : FIELD_NONE;
+        fields |= (pluggedMaxCurrent_ != info.GetPluggedMaxCurrent()) ? FIELD_PLUGGED_MAX_CURRENT : FIELD_NONE;
+        fields |= (pluggedMaxVoltage_ != info.GetPluggedMaxVoltage()) ? FIELD_PLUGGED_MAX_VOLTAGE : FIELD_NONE;
+        fields |= (chargeCounter_ != info.GetChargeCounter()) ? FIELD_CHARGE_COUNTER : FIELD_NONE;
+        fields |= (healthState_ != info.GetHealthState()) ? FIELD_HEALTH_STATE : FIELD_NONE;
+        fields |= (pluggedType_ != info.GetPluggedType()) ? FIELD_PLUGGED_TYPE : FIELD_NONE;
+        fields |= (remainEnergy_ != info.GetRemainEnergy()) ? FIELD_REMAIN_ENERGY : FIELD_NONE;
+        fields |= (chargeState_ != info.GetChargeState()) ? FIELD_CHARGE_STATE : FIELD_NONE;
+        fields |= (technology_ != info.GetTechnology()) ? FIELD_TECHNOLOGY : FIELD_NONE;
+        fields |= (uevent_ != info.GetUevent()) ? FIELD_UEVENT : FIELD_NONE;
+        fields |= (chargeType_ != info.GetChargeType()) ? FIELD_CHARGE_TYPE : FIELD_NONE;
+        return fields;
+    }
+
     // Used by both napi and native
     static constexpr const char* COMMON_EVENT_KEY_CAPACITY = "soc";
     static constexpr const char* COMMON_EVENT_KEY_CHARGE_STATE = "chargeState";
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_SRV_BATTERY_INFO_SNAPSHOT_H
+#define BATTERY_SRV_BATTERY_INFO_SNAPSHOT_H
+
+#include <cstdint>
+#include <parcel.h>
+
+#include "battery_info.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * All battery fields of one sample, returned by a single transaction.
+ *
+ * Fields are written in a fixed order after the version and the payload size. Newer versions
+ * only append fields, a reader skips the ones it does not know by the payload size.
+ */
+class BatteryInfoSnapshot : public Parcelable {
+public:
+    static constexpr uint32_t VERSION = 2;
+
+    BatteryInfoSnapshot() = default;
+    ~BatteryInfoSnapshot() override = default;
+
+    bool Marshalling(Parcel& parcel) const override;
+    static BatteryInfoSnapshot* Unmarshalling(Parcel& parcel);
+    bool ReadFromParcel(Parcel& parcel);
+
+    void SetInfo(const BatteryInfo& info)
+    {
+        info_ = info;
+    }
+
+    void SetCapacityLevel(const BatteryCapacityLevel capacityLevel)
+    {
+        capacityLevel_ = capacityLevel;
+    }
+
+    void SetRemainingChargeTime(const int64_t remainingChargeTime)
+    {
+        remainingChargeTime_ = remainingChargeTime;
+    }
+
+    void SetRemainingChargeTimeConfidence(const int32_t confidence)
+    {
+        remainingChargeTimeConfidence_ = confidence;
+    }
+
+    void SetSequence(const uint64_t sequence)
+    {
+        sequence_ = sequence;
+    }
+
+    void SetTimestamp(const int64_t timestamp)
+    {
+        timestamp_ = timestamp;
+    }
+
+    /**
+     * Return the battery fields, the uevent is not transferred.
+     */
+    const BatteryInfo& GetInfo() const
+    {
+        return info_;
+    }
+
+    BatteryCapacityLevel GetCapacityLevel() const
+    {
+        return capacityLevel_;
+    }
+
+    int64_t GetRemainingChargeTime() const
+    {
+        return remainingChargeTime_;
+    }
+
+    /**
+     * Return how far the remaining charge time can be trusted, 0 to 100. 0 if there is no estimate
+     * or the sender predates version 2.
+     */
+    int32_t GetRemainingChargeTimeConfidence() const
+    {
+        return remainingChargeTimeConfidence_;
+    }
+
+    /**
+     * Return the number of samples the service received before this one, a changed value
+     * means the fields may have changed.
+     */
+    uint64_t GetSequence() const
+    {
+        return sequence_;
+    }
+
+    /**
+     * Return the time the sample was taken, in ms of the monotonic clock.
+     */
+    int64_t GetTimestamp() const
+    {
+        return timestamp_;
+    }
+
+    uint32_t GetVersion() const
+    {
+        return version_;
+    }
+
+private:
+    bool WriteFields(Parcel& parcel) const;
+    bool ReadFields(Parcel& parcel);
+
+    uint32_t version_ { VERSION };
+    uint64_t sequence_ { 0 };
+    int64_t timestamp_ { 0 };
+    BatteryInfo info_;
+    BatteryCapacityLevel capacityLevel_ { BatteryCapacityLevel::LEVEL_NONE };
+    int64_t remainingChargeTime_ { INVALID_REMAINING_CHARGE_TIME_VALUE };
+    int32_t remainingChargeTimeConfidence_ { 0 };
+};
+} // namespace PowerMgr
+} // namespace OHOS
+
+#endif // BATTERY_SRV_BATTERY_INFO_SNAPSHOT_H
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_SRV_BATTERY_JOURNAL_FORMAT_H
+#define BATTERY_SRV_BATTERY_JOURNAL_FORMAT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * On-disk layout of the battery journal, shared by the battery service (writer) and the
+ * ohos-batteryManager tool (reader).
+ *
+ * The file is a header page followed by a ring of fixed-size records. Record n lives in slot
+ * n % capacity and carries its own sequence number and CRC32, so a torn write only invalidates
+ * that record. The cursor in the header is updated after each record; after a crash it may lag
+ * behind, readers and the writer scan forward from it while the records stay valid.
+ */
+namespace BatteryJournalFormat {
+constexpr const char* DEFAULT_PATH = "/data/service/el0/battery/battery_journal";
+constexpr uint32_t MAGIC = 0x4C4E4A42; // "BJNL"
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t HEADER_SIZE = 4096;
+constexpr uint32_t DEFAULT_CAPACITY = 32768;
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t capacity;
+    uint64_t nextSeq; // sequence number of the next record, records start at 1
+};
+
+struct Record {
+    uint64_t seq;
+    int64_t time; // ms since epoch
+    int32_t capacity;
+    int32_t voltage;
+    int32_t current;
+    int32_t temperature;
+    int32_t chargeState;
+    int32_t pluggedType;
+    int32_t healthState;
+    int32_t chargeCounter;
+    int32_t remainEnergy;
+    uint32_t changedFields;
+    uint32_t reserved;
+    uint32_t crc; // CRC32 of the bytes before it
+};
+static_assert(sizeof(Record) == 64, "journal record size is part of the file format");
+
+constexpr std::array<uint32_t, 256> MakeCrcTable()
+{
+    constexpr uint32_t polynomial = 0xEDB88320;
+    std::array<uint32_t, 256> table {};
+    for (uint32_t i = 0; i < table.size(); i++) {
+        uint32_t crc = i;
+        for (uint32_t bit = 0; bit < 8; bit++) {
+            crc = ((crc & 1) != 0) ? ((crc >> 1) ^ polynomial) : (crc >> 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+inline uint32_t Crc32(const void* data, size_t size)
+{
+    static constexpr std::array<uint32_t, 256> table = MakeCrcTable();
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+inline uint32_t RecordCrc(const Record& record)
+{
+    return Crc32(&record, offsetof(Record, crc));
+}
+
+inline bool IsValidHeader(const Header& header, size_t fileSize)
+{
+    return header.magic == MAGIC && header.version == VERSION && header.recordSize == sizeof(Record) &&
+        header.capacity != 0 && fileSize == HEADER_SIZE + static_cast<size_t>(header.capacity) * sizeof(Record);
+}
+
+inline const Record& GetRecord(const uint8_t* base, const Header& header, uint64_t seq)
+{
+    return reinterpret_cast<const Record*>(base + HEADER_SIZE)[seq % header.capacity];
+}
+
+inline Record& GetRecord(uint8_t* base, const Header& header, uint64_t seq)
+{
+    return reinterpret_cast<Record*>(base + HEADER_SIZE)[seq % header.capacity];
+}
+
+inline bool IsValidRecord(const Record& record, uint64_t seq)
+{
+    return record.seq == seq && record.crc == RecordCrc(record);
+}
+
+// The cursor is advisory, the last records of a crashed writer are found by scanning forward from it
+inline uint64_t RecoverNextSeq(const uint8_t* base, const Header& header)
+{
+    uint64_t nextSeq = (header.nextSeq == 0) ? 1 : header.nextSeq;
+    for (uint32_t i = 0; i < header.capacity && IsValidRecord(GetRecord(base, header, nextSeq), nextSeq); i++) {
+        nextSeq++;
+    }
+    return nextSeq;
+}
+
+inline uint64_t GetFirstSeq(const Header& header, uint64_t nextSeq)
+{
+    return (nextSeq > header.capacity) ? (nextSeq - header.capacity) : 1;
+}
+} // namespace BatteryJournalFormat
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // BATTERY_SRV_BATTERY_JOURNAL_FORMAT_H
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_SRV_BATTERY_LISTENER_PROXY_H
+#define BATTERY_SRV_BATTERY_LISTENER_PROXY_H
+
+#include <iremote_proxy.h>
+
+#include "ibattery_listener.h"
+
+namespace OHOS {
+namespace PowerMgr {
+class BatteryListenerProxy : public IRemoteProxy<IBatteryListener> {
+public:
+    explicit BatteryListenerProxy(const sptr<IRemoteObject>& impl) : IRemoteProxy<IBatteryListener>(impl) {}
+    ~BatteryListenerProxy() override = default;
+    void OnBatteryChanged(uint32_t changedFields, const BatteryInfoSnapshot& snapshot) override;
+
+private:
+    static inline BrokerDelegator<BatteryListenerProxy> delegator_;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+
+#endif // BATTERY_SRV_BATTERY_LISTENER_PROXY_H
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_SRV_BATTERY_PARCEL_PAYLOAD_H
+#define BATTERY_SRV_BATTERY_PARCEL_PAYLOAD_H
+
+#include <cstdint>
+#include <limits>
+#include <parcel.h>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Write the size of the fields produced by writer ahead of them.
+ *
+ * The size lets an older reader skip fields appended by a newer version, so the values
+ * written after them in the same transaction stay where the reader expects them.
+ */
+template<typename Writer>
+bool WriteSizedPayload(Parcel& parcel, const Writer& writer)
+{
+    Parcel payload;
+    if (!writer(payload)) {
+        return false;
+    }
+    size_t size = payload.GetDataSize();
+    if (size > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+    return parcel.WriteUint32(static_cast<uint32_t>(size)) &&
+        parcel.WriteBuffer(reinterpret_cast<const void*>(payload.GetData()), size);
+}
+
+/**
+ * Read the size, let reader consume the fields it knows and skip the rest.
+ */
+template<typename Reader>
+bool ReadSizedPayload(Parcel& parcel, const Reader& reader)
+{
+    uint32_t size = 0;
+    if (!parcel.ReadUint32(size) || size > parcel.GetReadableBytes()) {
+        return false;
+    }
+    size_t start = parcel.GetReadPosition();
+    if (!reader(parcel)) {
+        return false;
+    }
+    size_t consumed = parcel.GetReadPosition() - start;
+    if (consumed > size) {
+        return false;
+    }
+    parcel.SkipBytes(size - consumed);
+    return true;
+}
+
+template<typename Writer>
+bool WriteVersionedPayload(Parcel& parcel, uint32_t version, const Writer& writer)
+{
+    return parcel.WriteUint32(version) && WriteSizedPayload(parcel, writer);
+}
+
+template<typename Reader>
+bool ReadVersionedPayload(Parcel& parcel, uint32_t& version, const Reader& reader)
+{
+    return parcel.ReadUint32(version) && ReadSizedPayload(parcel, reader);
+}
+} // namespace PowerMgr
+} // namespace OHOS
+
+#endif // BATTERY_SRV_BATTERY_PARCEL_PAYLOAD_H
@@ -19,9 +19,17 @@
 #include <singleton.h>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "battery_charge_sessions.h"
+#include "battery_energy_counters.h"
 #include "battery_info.h"
+#include "battery_info_snapshot.h"
+#include "battery_window_stats.h"
 #include "battery_srv_errors.h"
 #include "iremote_object.h"
+#include "ibattery_listener.h"
 #include "ibattery_srv.h"
 
 namespace OHOS {
@@ -87,6 +95,11 @@ public:
      * Return the remaining charge time
      */
     int64_t GetRemainingChargeTime();
+    /**
+     * Return the remaining discharge time in ms, 0 while plugged or without an estimate,
+     * INVALID_REMAINING_CHARGE_TIME_VALUE for a caller that is not a system application
+     */
+    int64_t GetRemainingDischargeTime();
     /**
      * set charge config
      */
@@ -99,6 +112,41 @@ public:
      * is support charge config
      */
     BatteryError IsBatteryConfigSupported(const std::string& sceneName, bool& result);
+    /**
+     * Get every battery field of the latest sample in one call
+     */
+    BatteryError GetBatteryInfoSnapshot(BatteryInfoSnapshot& snapshot);
+    /**
+     * set several charge configs in one call, results holds the error of each (scene, value) pair
+     */
+    BatteryError SetBatteryConfigs(const std::vector<std::pair<std::string, std::string>>& configs,
+        std::vector<BatteryError>& results);
+    /**
+     * get several charge configs in one call, values and results follow the order of sceneNames
+     */
+    BatteryError GetBatteryConfigs(const std::vector<std::string>& sceneNames, std::vector<std::string>& values,
+        std::vector<BatteryError>& results);
+    /**
+     * Get min/max/avg of current, voltage and temperature over the last windowSeconds (60, 300 or 900)
+     */
+    BatteryError GetBatteryStats(int32_t windowSeconds, BatteryWindowStats& stats);
+    /**
+     * Get the statistics of the last charge sessions, the running one last. Denied to non-system callers,
+     * the sessions carry the delivered energy
+     */
+    BatteryError GetChargeSessions(BatteryChargeSessions& sessions);
+    /**
+     * Get the monotonic charge and energy totals, the consumption over an interval is the difference of
+     * two readings. Denied to non-system callers
+     */
+    BatteryError GetEnergyCounters(BatteryEnergyCounters& counters);
+    /**
+     * Subscribe listener to the changes of the BatteryInfo::FIELD_* bits in fieldMask, delivered at most once
+     * every minIntervalMs. The subscription is restored when the battery service restarts.
+     */
+    BatteryError RegisterBatteryListener(const sptr<IBatteryListener>& listener, uint32_t fieldMask,
+        int64_t minIntervalMs);
+    BatteryError UnregisterBatteryListener(const sptr<IBatteryListener>& listener);
 
 #ifndef BATTERYMGR_DEATHRECIPIENT_UNITTEST
 private:
@@ -113,11 +161,27 @@ private:
         BatterySrvClient& client_;
     };
 
+    struct ListenerEntry {
+        sptr<IBatteryListener> listener;
+        uint32_t fieldMask;
+        int64_t minIntervalMs;
+    };
+
     sptr<IBatterySrv> Connect();
     void ResetProxy(const wptr<IRemoteObject>& remote);
+    void SubscribeSrvStatus();
+    void RestoreListeners();
     sptr<IBatterySrv> proxy_ {nullptr};
     sptr<IRemoteObject::DeathRecipient> deathRecipient_ {nullptr};
     std::mutex mutex_;
+    // the registered listeners, registered again when the service comes back
+    std::vector<ListenerEntry> listeners_;
+    // notified by samgr when the service is added, see RestoreListeners
+    sptr<IRemoteObject> statusListener_ {nullptr};
+    std::mutex listenerMutex_;
+    // serializes the register and unregister transactions of the callers and of RestoreListeners, so a
+    // restore can't register a listener again after its unregistration
+    std::mutex listenerTransactionMutex_;
 };
 } // namespace PowerMgr
 } // namespace OHOS
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_SRV_BATTERY_WINDOW_STATS_H
+#define BATTERY_SRV_BATTERY_WINDOW_STATS_H
+
+#include <cstdint>
+#include <parcel.h>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Min, max and average of current, voltage and temperature over the samples the service received
+ * in the last windowSeconds.
+ *
+ * Fields are written in a fixed order after the version and the payload size. Newer versions only append
+ * fields, a reader skips the ones it does not know by the payload size.
+ */
+class BatteryWindowStats : public Parcelable {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    struct Aggregate {
+        int32_t min { 0 };
+        int32_t max { 0 };
+        int32_t avg { 0 };
+    };
+
+    BatteryWindowStats() = default;
+    ~BatteryWindowStats() override = default;
+
+    bool Marshalling(Parcel& parcel) const override;
+    static BatteryWindowStats* Unmarshalling(Parcel& parcel);
+    bool ReadFromParcel(Parcel& parcel);
+
+    void SetWindowSeconds(const int32_t windowSeconds)
+    {
+        windowSeconds_ = windowSeconds;
+    }
+
+    void SetSampleCount(const uint32_t sampleCount)
+    {
+        sampleCount_ = sampleCount;
+    }
+
+    void SetCurrent(const Aggregate& current)
+    {
+        current_ = current;
+    }
+
+    void SetVoltage(const Aggregate& voltage)
+    {
+        voltage_ = voltage;
+    }
+
+    void SetTemperature(const Aggregate& temperature)
+    {
+        temperature_ = temperature;
+    }
+
+    int32_t GetWindowSeconds() const
+    {
+        return windowSeconds_;
+    }
+
+    /**
+     * Return the number of samples in the window, the aggregates are meaningless when it is 0.
+     */
+    uint32_t GetSampleCount() const
+    {
+        return sampleCount_;
+    }
+
+    /**
+     * Return the aggregate of the battery current, in mA.
+     */
+    const Aggregate& GetCurrent() const
+    {
+        return current_;
+    }
+
+    /**
+     * Return the aggregate of the battery voltage, in uV.
+     */
+    const Aggregate& GetVoltage() const
+    {
+        return voltage_;
+    }
+
+    /**
+     * Return the aggregate of the battery temperature, in 0.1 degrees Celsius.
+     */
+    const Aggregate& GetTemperature() const
+    {
+        return temperature_;
+    }
+
+    uint32_t GetVersion() const
+    {
+        return version_;
+    }
+
+private:
+    bool WriteFields(Parcel& parcel) const;
+    bool ReadFields(Parcel& parcel);
+
+    uint32_t version_ { VERSION };
+    int32_t windowSeconds_ { 0 };
+    uint32_t sampleCount_ { 0 };
+    Aggregate current_;
+    Aggregate voltage_;
+    Aggregate temperature_;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+
+#endif // BATTERY_SRV_BATTERY_WINDOW_STATS_H
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_SRV_IBATTERY_LISTENER_H
+#define BATTERY_SRV_IBATTERY_LISTENER_H
+
+#include <cstdint>
+#include <iremote_broker.h>
+
+#include "battery_info_snapshot.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Receives the battery state changes a client subscribed to with BatterySrvClient::RegisterBatteryListener.
+ *
+ * Calls are oneway and come from the service, changes arriving faster than the subscribed interval are
+ * merged: changedFields is the union of the BatteryInfo::FIELD_* bits changed since the previous call
+ * and snapshot is the latest state.
+ */
+class IBatteryListener : public IRemoteBroker {
+public:
+    enum class Code : uint32_t {
+        ON_BATTERY_CHANGED = 0,
+    };
+
+    virtual void OnBatteryChanged(uint32_t changedFields, const BatteryInfoSnapshot& snapshot) = 0;
+
+    DECLARE_INTERFACE_DESCRIPTOR(u"OHOS.PowerMgr.IBatteryListener");
+};
+} // namespace PowerMgr
+} // namespace OHOS
+
+#endif // BATTERY_SRV_IBATTERY_LISTENER_H
@@ -117,6 +117,18 @@ int32_t OH_BatteryInfo_GetCapacity();
  * @since 13
  */
 BatteryInfo_BatteryPluggedType OH_BatteryInfo_GetPluggedType();
+
+/**
+ * @brief This API returns the estimated remaining discharge time.
+ *
+ * The estimate is computed by the battery service from the remaining energy and a smoothed drain rate.
+ *
+ * @return Returns the remaining time in milliseconds, 0 if a power source is plugged in or there is no estimate yet,
+ *         -1 if the battery service can't be reached or the caller is not a system application.
+ * @syscap SystemCapability.PowerManager.BatteryManager.Core
+ * @since 23
+ */
+int64_t OH_BatteryInfo_GetRemainingDischargeTime();
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_CHARGE_SESSION_STATS_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_CHARGE_SESSION_STATS_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "battery_charge_sessions.h"
+#include "battery_info.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Statistics of the charge sessions, updated incrementally from every battery event.
+ *
+ * Begin and End are called on the plug transitions, Update on every event in between. Each sample's
+ * current, voltage and charge type hold until the next one. The last MAX_SESSIONS finished sessions
+ * are kept in a fixed ring. The writers are serialized by the service, readers may run concurrently.
+ */
+class BatteryChargeSessionStats {
+public:
+    using Session = BatteryChargeSessions::Session;
+    static constexpr size_t MAX_SESSIONS = 16;
+
+    void Begin(int64_t wallTimeMs, int64_t timeMs, const BatteryInfo& info);
+    void Update(int64_t timeMs, const BatteryInfo& info);
+    void End(int64_t timeMs, const BatteryInfo& info);
+    // the finished sessions oldest first, then the running one
+    std::vector<Session> GetSessions() const;
+
+private:
+    void UpdateLocked(int64_t timeMs, const BatteryInfo& info);
+
+    mutable std::mutex mutex_;
+    std::array<Session, MAX_SESSIONS> finished_ {};
+    size_t next_ { 0 };
+    size_t count_ { 0 };
+    bool running_ { false };
+    Session current_;
+    int64_t startMs_ { 0 };
+    int64_t lastMs_ { 0 };
+    int32_t lastCurrent_ { 0 };
+    int32_t lastVoltage_ { 0 };
+    ChargeType lastChargeType_ { ChargeType::NONE };
+    double chargeMaMs_ { 0 };   // mA * ms
+    double energyUvMaMs_ { 0 }; // uV * mA * ms
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_CHARGE_SESSION_STATS_H
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_CHARGE_TIME_ESTIMATOR_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_CHARGE_TIME_ESTIMATOR_H
+
+#include <array>
+#include <cstdint>
+
+#include "battery_info.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Remaining charge time from a least squares fit over the recent samples of a charge session.
+ *
+ * Capacity and charge counter are each fitted against time over the last WINDOW samples, with the
+ * sums kept incrementally so an update is O(1). The charge counter has a finer step than the 1%
+ * capacity, its rate is preferred once it fits enough samples. Up to TAPER_CAPACITY the charge rate
+ * is taken as constant, above it the constant voltage phase is modelled as an exponential approach
+ * to full whose time constant matches the rate at the start of the taper.
+ *
+ * A plug type change, leaving the charging state or a capacity drop starts a new session.
+ */
+class BatteryChargeTimeEstimator {
+public:
+    struct Estimate {
+        int64_t remainingMs { 0 }; // 0 while there is no estimate
+        int32_t confidence { 0 };  // 0 to 100
+    };
+    static constexpr uint32_t WINDOW = 32;
+    static constexpr int32_t TAPER_CAPACITY = 80;
+    // a sample with unchanged capacity and charge counter is only taken after this interval
+    static constexpr int64_t MIN_SAMPLE_INTERVAL_MS = 30000;
+
+    void Update(int64_t timeMs, const BatteryInfo& info);
+    void Reset();
+    const Estimate& GetEstimate() const
+    {
+        return estimate_;
+    }
+
+private:
+    // Sliding least squares of y against x over the last WINDOW points, exact in integers
+    class Fit {
+    public:
+        void Add(int64_t x, int64_t y);
+        void Clear();
+        uint32_t GetCount() const
+        {
+            return count_;
+        }
+        int64_t GetSpan() const;
+        // false if the points don't define a slope
+        bool GetSlope(double& slope) const;
+        // coefficient of determination, 1 for points on a line
+        double GetRSquared() const;
+        // fitted y at the newest x
+        double GetLastFitted() const;
+
+    private:
+        std::array<int64_t, WINDOW> xs_ {};
+        std::array<int64_t, WINDOW> ys_ {};
+        uint32_t next_ { 0 };
+        uint32_t count_ { 0 };
+        int64_t sumX_ { 0 };
+        int64_t sumY_ { 0 };
+        int64_t sumXX_ { 0 };
+        int64_t sumXY_ { 0 };
+        int64_t sumYY_ { 0 };
+    };
+
+    void UpdateEstimate(int32_t capacity, int32_t chargeCounter);
+    static int64_t GetRemainingMs(double capacity, double ratePerSec);
+
+    bool isCharging_ { false };
+    BatteryPluggedType pluggedType_ { BatteryPluggedType::PLUGGED_TYPE_NONE };
+    int64_t startMs_ { 0 };
+    int64_t lastSampleMs_ { 0 };
+    int32_t lastCapacity_ { 0 };
+    int32_t lastChargeCounter_ { 0 };
+    Fit capacityFit_;
+    Fit counterFit_;
+    Estimate estimate_;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_CHARGE_TIME_ESTIMATOR_H
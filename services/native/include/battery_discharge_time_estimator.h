@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_DISCHARGE_TIME_ESTIMATOR_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_DISCHARGE_TIME_ESTIMATOR_H
+
+#include <cstdint>
+
+#include "battery_info.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Remaining discharge time from the remaining energy and an exponentially weighted drain rate.
+ *
+ * The now current of every sample taken while unplugged is folded into the drain rate with a weight
+ * that grows with the time since the previous sample, so the rate follows the load with a time constant
+ * of TIME_CONSTANT_MS whatever the event rate. Plugging in drops the rate.
+ */
+class BatteryDischargeTimeEstimator {
+public:
+    static constexpr int64_t TIME_CONSTANT_MS = 300000;
+
+    void Update(int64_t timeMs, const BatteryInfo& info);
+    void Reset();
+    // 0 while there is no estimate
+    int64_t GetRemainingMs() const
+    {
+        return remainingMs_;
+    }
+    // mA, 0 while there is no estimate
+    double GetDrainRate() const
+    {
+        return drainRate_;
+    }
+
+private:
+    bool isDischarging_ { false };
+    int64_t lastSampleMs_ { 0 };
+    double drainRate_ { 0 };
+    int64_t remainingMs_ { 0 };
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_DISCHARGE_TIME_ESTIMATOR_H
@@ -36,10 +36,19 @@ public:
     bool Reset(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args);
     bool MockCapacity(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args);
     bool MockUevent(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args);
+    bool DumpEventStats(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args);
+    bool DumpStartupStats(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args);
+    bool DumpEventLog(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args);
+    bool DumpHistory(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args);
+    bool DumpChargeSessions(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args);
+    bool DumpListeners(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args);
+    bool DumpIpcStats(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args);
+    bool DumpTraceStats(int32_t fd, const std::vector<std::u16string> &args);
     void DumpBatteryInfo(sptr<BatteryService> &service, int32_t fd);
 
 private:
     void DumpCurrentTime(int32_t fd);
+    void DumpStageLatency(int32_t fd, const char* stage, const BatteryEventPipeline::StageLatency& latency);
 };
 }  // namespace Sensors
 }  // namespace OHOS
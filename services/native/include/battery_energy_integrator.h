@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_ENERGY_INTEGRATOR_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_ENERGY_INTEGRATOR_H
+
+#include <cstdint>
+#include <mutex>
+
+#include "battery_energy_counters.h"
+#include "battery_info.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Coulomb counter over the battery events. Each sample's current and voltage hold until the next one,
+ * positive current is integrated into the in totals and negative current into the out totals, so every
+ * total only grows. The writers are serialized by the service, readers may run concurrently.
+ */
+class BatteryEnergyIntegrator {
+public:
+    using Counters = BatteryEnergyCounters::Counters;
+
+    void Update(int64_t timeMs, const BatteryInfo& info);
+    // the totals extended to timeMs with the last sample, so readings advance between events
+    Counters GetCounters(int64_t timeMs) const;
+
+private:
+    struct Totals {
+        double chargeIn { 0 };  // mA * ms
+        double chargeOut { 0 }; // mA * ms
+        double energyIn { 0 };  // uV * mA * ms
+        double energyOut { 0 }; // uV * mA * ms
+    };
+    Totals ExtendLocked(int64_t timeMs) const;
+
+    mutable std::mutex mutex_;
+    bool started_ { false };
+    int64_t lastMs_ { 0 };
+    int32_t lastCurrent_ { 0 };
+    int32_t lastVoltage_ { 0 };
+    uint64_t sampleCount_ { 0 };
+    Totals totals_;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_ENERGY_INTEGRATOR_H
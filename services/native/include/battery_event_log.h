@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_EVENT_LOG_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_EVENT_LOG_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "battery_info.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Binary log of the processed battery events.
+ *
+ * Every record is a fixed size copy of the numeric BatteryInfo fields plus the changed field mask,
+ * written into a lock-free ring without any formatting. Records are only decoded by hidumper.
+ * Text logging of the same events goes through BatteryLogLimiter, its verbosity is read from the
+ * persist.battery.log_level system parameter at runtime.
+ */
+class BatteryEventLog {
+public:
+    enum Level : int32_t {
+        LEVEL_BINARY = 0,  // binary records only
+        LEVEL_LIMITED = 1, // rate limited text lines
+        LEVEL_FULL = 2,    // a text line per event
+    };
+    enum Source : uint8_t {
+        SOURCE_EVENT = 0,
+        SOURCE_CES_READY,
+    };
+    static constexpr uint32_t UEVENT_LEN = 32;
+    struct Record {
+        uint64_t seq { 0 };
+        int64_t time { 0 };
+        uint32_t changedFields { 0 };
+        int32_t capacity { 0 };
+        int32_t voltage { 0 };
+        int32_t temperature { 0 };
+        int32_t nowCurrent { 0 };
+        int32_t curAverage { 0 };
+        int32_t totalEnergy { 0 };
+        int32_t remainEnergy { 0 };
+        int32_t chargeCounter { 0 };
+        int32_t pluggedMaxCurrent { 0 };
+        int32_t pluggedMaxVoltage { 0 };
+        uint8_t source { 0 };
+        uint8_t healthState { 0 };
+        uint8_t pluggedType { 0 };
+        uint8_t chargeState { 0 };
+        uint8_t chargeType { 0 };
+        uint8_t present { 0 };
+        char uevent[UEVENT_LEN] { 0 };
+    };
+    static constexpr uint32_t CAPACITY = 256;
+
+    void Append(Source source, const BatteryInfo& info, uint32_t changedFields);
+    // Oldest first, records overwritten while being copied are skipped
+    std::vector<Record> GetRecords() const;
+    uint64_t GetTotal() const;
+
+    static int32_t GetLevel();
+    static void SetLevel(int32_t level);
+    static void WatchLevel();
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq { 0 }; // 0 while the slot is written, else the record seq
+        Record record;
+    };
+    std::array<Slot, CAPACITY> slots_ {};
+    std::atomic<uint64_t> next_ { 0 };
+    static std::atomic<int32_t> level_;
+};
+
+/**
+ * Limits one text log site to BURST lines per WINDOW_MS at LEVEL_LIMITED. The first line allowed
+ * after a suppressed run reports how many were dropped.
+ */
+class BatteryLogLimiter {
+public:
+    static constexpr uint32_t BURST = 5;
+    static constexpr int64_t WINDOW_MS = 60000;
+
+    bool Allow(uint32_t& suppressed);
+
+private:
+    std::atomic<int64_t> windowStart_ { 0 };
+    std::atomic<uint32_t> count_ { 0 };
+    std::atomic<uint32_t> suppressed_ { 0 };
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_EVENT_LOG_H
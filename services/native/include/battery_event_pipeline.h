@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_EVENT_PIPELINE_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_EVENT_PIPELINE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "battery_info.h"
+#include "v2_0/types.h"
+
+namespace ffrt {
+class queue;
+}
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Moves battery hdi pushes off the hdi callback thread.
+ *
+ * Pushes are stored in a bounded ring and handled one at a time by a single consumer on a
+ * serial ffrt queue. A plain power_supply sample replaces a pending plain sample (latest wins),
+ * samples carrying any other uevent are always handled.
+ *
+ * The consumer runs at user initiated qos and only takes the decisions (thermal and low capacity
+ * shutdown, wakeup). Light and common event work is posted to a second serial queue at utility
+ * qos, so a slow common event service never delays the next decision. That lane holds a single
+ * pending broadcast: a newer info replaces the pending one and its changed fields are merged, so
+ * at most one broadcast task waits behind the running one however slow the common event service is.
+ */
+class BatteryEventPipeline {
+public:
+    using EventHandler = std::function<void(const HDI::Battery::V2_0::BatteryInfo& event)>;
+    using BroadcastHandler = std::function<void(BatteryInfo& info, uint32_t changedFields)>;
+    struct StageLatency {
+        uint64_t count { 0 };
+        uint64_t lastUs { 0 };
+        uint64_t maxUs { 0 };
+        uint64_t totalUs { 0 };
+    };
+    struct Stats {
+        uint64_t received { 0 };
+        uint64_t coalesced { 0 };
+        uint64_t processed { 0 };
+        uint64_t dropped { 0 };
+        uint32_t pending { 0 };
+        uint32_t maxPending { 0 };
+        uint64_t broadcastPosted { 0 };    // broadcast tasks submitted to the utility lane
+        uint64_t broadcastCoalesced { 0 }; // broadcasts merged into the pending one
+        uint32_t broadcastPending { 0 };   // 1 while a broadcast task waits to start
+        StageLatency decision;      // hdi push to the end of the decision stage
+        StageLatency broadcastWait; // broadcast task posted to started
+        StageLatency broadcastRun;  // broadcast task duration
+    };
+    static constexpr uint32_t CAPACITY = 16;
+
+    BatteryEventPipeline(const EventHandler& handler, const BroadcastHandler& broadcastHandler);
+    ~BatteryEventPipeline() = default;
+
+    void Push(const HDI::Battery::V2_0::BatteryInfo& event);
+    void PostBroadcast(const BatteryInfo& info, uint32_t changedFields);
+    Stats GetStats();
+    static bool IsCoalescable(const HDI::Battery::V2_0::BatteryInfo& event);
+
+private:
+    class LatencyRecorder {
+    public:
+        void Record(int64_t latencyUs);
+        StageLatency Load() const;
+    private:
+        std::atomic<uint64_t> count_ { 0 };
+        std::atomic<uint64_t> lastUs_ { 0 };
+        std::atomic<uint64_t> maxUs_ { 0 };
+        std::atomic<uint64_t> totalUs_ { 0 };
+    };
+
+    static int64_t GetTickUs();
+    void Drain();
+    bool PopFront(HDI::Battery::V2_0::BatteryInfo& event, int64_t& pushTime);
+    void DropOldest();
+    void RunBroadcast();
+
+    EventHandler handler_;
+    BroadcastHandler broadcastHandler_;
+    std::mutex mutex_;
+    std::array<HDI::Battery::V2_0::BatteryInfo, CAPACITY> ring_;
+    std::array<int64_t, CAPACITY> pushTime_ {};
+    uint32_t head_ { 0 };
+    uint32_t count_ { 0 };
+    uint32_t maxPending_ { 0 };
+    bool draining_ { false };
+    std::atomic<uint64_t> received_ { 0 };
+    std::atomic<uint64_t> coalesced_ { 0 };
+    std::atomic<uint64_t> processed_ { 0 };
+    std::atomic<uint64_t> dropped_ { 0 };
+    std::mutex broadcastMutex_;
+    BatteryInfo broadcastInfo_;
+    uint32_t broadcastFields_ { 0 };
+    int64_t broadcastPostTime_ { 0 };
+    bool broadcastScheduled_ { false };
+    uint64_t broadcastPosted_ { 0 };
+    uint64_t broadcastCoalesced_ { 0 };
+    LatencyRecorder decision_;
+    LatencyRecorder broadcastWait_;
+    LatencyRecorder broadcastRun_;
+    std::shared_ptr<ffrt::queue> queue_ { nullptr };
+    std::shared_ptr<ffrt::queue> broadcastQueue_ { nullptr };
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_EVENT_PIPELINE_H
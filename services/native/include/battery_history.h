@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_HISTORY_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_HISTORY_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Service side history of the battery samples.
+ *
+ * Samples are delta encoded as varints into a ring of fixed blocks. Each block starts with an
+ * absolute sample, so when the ring is full the oldest block is dropped as a whole and every
+ * remaining block still decodes on its own. A typical sample takes 6 to 10 bytes, 24 h of
+ * 10 s samples fits in about a third of the ring.
+ *
+ * There is a single writer (the battery event path), readers never block it: the writer publishes
+ * the used length of a block after writing the bytes and bumps the block generation when it
+ * recycles it, a reader drops a block whose generation changed while it was copied.
+ */
+class BatteryHistory {
+public:
+    struct Sample {
+        int64_t time { 0 }; // ms since epoch
+        int32_t capacity { 0 };
+        int32_t voltage { 0 };
+        int32_t current { 0 };
+        int32_t temperature { 0 };
+        int32_t chargeState { 0 };
+    };
+    struct Stats {
+        uint64_t samples { 0 };
+        uint32_t blocks { 0 };
+        uint32_t bytes { 0 };
+    };
+    static constexpr uint32_t BLOCK_SIZE = 4096;
+    static constexpr uint32_t BLOCK_COUNT = 64;
+
+    // Only called from the battery event path, appends are not thread safe against each other
+    void Append(const Sample& sample);
+    // Samples with begin <= time <= end, oldest first
+    std::vector<Sample> GetSamples(int64_t begin, int64_t end) const;
+    Stats GetStats() const;
+
+private:
+    struct Block {
+        std::atomic<uint64_t> generation { 0 }; // odd while the block is recycled
+        std::atomic<uint64_t> seq { 0 };        // order of the block in the ring, 0 if unused
+        std::atomic<uint32_t> used { 0 };
+        std::array<uint8_t, BLOCK_SIZE> data {};
+    };
+    static constexpr uint32_t FIELD_COUNT = 5;
+    // time delta plus the zigzag deltas, all as 64 bit varints
+    static constexpr uint32_t MAX_SAMPLE_SIZE = 10 * (FIELD_COUNT + 1);
+
+    void StartBlock(const Sample& sample);
+    void Write(const Sample& sample, const Sample& base, bool isKeyframe);
+    static void DecodeBlock(const uint8_t* data, uint32_t size, int64_t begin, int64_t end,
+        std::vector<Sample>& samples);
+
+    std::array<Block, BLOCK_COUNT> blocks_ {};
+    // writer state
+    uint32_t current_ { 0 };
+    uint64_t nextSeq_ { 1 };
+    Sample last_;
+    bool hasLast_ { false };
+    std::atomic<uint64_t> samples_ { 0 };
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_HISTORY_H
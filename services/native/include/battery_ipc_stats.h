@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_IPC_STATS_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_IPC_STATS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Call counters and latency histograms of the battery SA IPC entry points.
+ *
+ * Requests are recorded by ipc code, one slot per code of IBatterySrv. Latencies land in log2
+ * buckets of microseconds, percentiles report the upper bound of the bucket. Calls are also
+ * counted per calling uid in a fixed open addressing table, uids that don't fit are counted as
+ * overflow. Every counter is a relaxed atomic, recording never takes a lock.
+ */
+class BatteryIpcStats {
+public:
+    static constexpr uint32_t MAX_METHODS = 32;
+    static constexpr uint32_t BUCKETS = 24;
+    static constexpr uint32_t MAX_UIDS = 64;
+    struct MethodStats {
+        uint32_t code { 0 };
+        const char* name { nullptr };
+        uint64_t calls { 0 };
+        uint64_t totalUs { 0 };
+        uint64_t maxUs { 0 };
+        uint64_t p50Us { 0 };
+        uint64_t p99Us { 0 };
+    };
+    struct UidStats {
+        int32_t uid { 0 };
+        uint64_t calls { 0 };
+    };
+
+    void Record(uint32_t code, int32_t uid, int64_t latencyUs);
+    std::vector<MethodStats> GetMethodStats() const;
+    // Sorted by calls, the busiest first
+    std::vector<UidStats> GetUidStats() const;
+    uint64_t GetUidOverflow() const;
+    void Reset();
+    static const char* GetMethodName(uint32_t code);
+
+private:
+    struct Method {
+        std::atomic<uint64_t> calls { 0 };
+        std::atomic<uint64_t> totalUs { 0 };
+        std::atomic<uint64_t> maxUs { 0 };
+        std::array<std::atomic<uint64_t>, BUCKETS> buckets {};
+    };
+    struct Uid {
+        static constexpr int32_t EMPTY = -1;
+        std::atomic<int32_t> uid { EMPTY };
+        std::atomic<uint64_t> calls { 0 };
+    };
+    static uint32_t GetBucket(uint64_t latencyUs);
+    static uint64_t GetPercentile(const std::array<uint64_t, BUCKETS>& buckets, uint64_t calls, uint32_t percent);
+    void RecordUid(int32_t uid);
+
+    // the last slot collects codes beyond MAX_METHODS
+    std::array<Method, MAX_METHODS + 1> methods_ {};
+    std::array<Uid, MAX_UIDS> uids_ {};
+    std::atomic<uint64_t> uidOverflow_ { 0 };
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_IPC_STATS_H
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_JOURNAL_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_JOURNAL_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "battery_info.h"
+#include "battery_journal_format.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Append-only battery journal in a memory-mapped file, see battery_journal_format.h for the layout.
+ *
+ * Appending copies one record into the mapping and moves the cursor, nothing is synced on the
+ * event path. The page cache survives a service crash. Flush writes the dirty pages back with
+ * fdatasync and waits for the device, the service calls it every 30 seconds from its own timer task
+ * and right before a low capacity or over temperature shutdown. A power cut or kernel panic loses the
+ * records appended since the last Flush, up to one timer interval, unless the kernel wrote them back
+ * on its own earlier. A record torn by a writeback racing its Append fails the crc and is skipped.
+ * Appends are not thread safe against each other, they come from the battery event path only, and
+ * the caller keeps Close from running concurrently with them. Flush only needs the file descriptor,
+ * syncMutex_ keeps Open and Close from replacing it underneath a running Flush.
+ */
+class BatteryJournal {
+public:
+    BatteryJournal() = default;
+    ~BatteryJournal();
+    BatteryJournal(const BatteryJournal&) = delete;
+    BatteryJournal& operator=(const BatteryJournal&) = delete;
+
+    bool Open(const std::string& path, uint32_t capacity = BatteryJournalFormat::DEFAULT_CAPACITY);
+    // Flushes the mapping and unmaps it, never called on the event path
+    void Close();
+    // Writes the dirty pages back and waits for them, false if the journal is closed
+    bool Flush();
+    bool IsOpen() const
+    {
+        return base_ != nullptr;
+    }
+    void Append(int64_t time, const BatteryInfo& info, uint32_t changedFields);
+    uint64_t GetNextSeq() const
+    {
+        return nextSeq_;
+    }
+
+private:
+    bool Map(int32_t fd, size_t size);
+    std::mutex syncMutex_;
+    int32_t fd_ { -1 };
+    uint8_t* base_ { nullptr };
+    size_t size_ { 0 };
+    uint64_t nextSeq_ { 1 };
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_JOURNAL_H
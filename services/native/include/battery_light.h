@@ -16,7 +16,10 @@
 #ifndef POWERMGR_BATTERY_MANAGER_BATTERY_LIGHT_H
 #define POWERMGR_BATTERY_MANAGER_BATTERY_LIGHT_H
 
+#include <memory>
+
 #include "battery_info.h"
+#include "battery_soc_table.h"
 
 namespace OHOS {
 namespace PowerMgr {
@@ -29,6 +32,7 @@ public:
     void TurnOff();
     void TurnOn(uint32_t color = 0);
     bool UpdateColor(BatteryChargeState chargeState, int32_t capacity);
+    void SetSocTable(const std::shared_ptr<const BatterySocTable>& socTable);
     bool isAvailable() const;
     uint32_t GetLightColor() const;
 
@@ -38,6 +42,7 @@ private:
     int32_t lightId_ {-1};
 #endif
     uint32_t lightColor_ {0};
+    std::shared_ptr<const BatterySocTable> socTable_ {nullptr};
 };
 } // namespace PowerMgr
 } // namespace OHOS
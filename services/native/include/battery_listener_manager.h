@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_LISTENER_MANAGER_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_LISTENER_MANAGER_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "battery_info.h"
+#include "battery_info_snapshot.h"
+#include "battery_srv_errors.h"
+#include "ibattery_listener.h"
+#include "iremote_object.h"
+
+namespace ffrt {
+class queue;
+}
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Delivers battery state changes to the subscribed IBatteryListener objects.
+ *
+ * Notify runs in the decision stage of every battery event and only updates the pending slot of each
+ * subscriber whose field mask matches: changes arriving while a delivery is pending or within the
+ * subscriber's minimum interval are merged into that slot (fields are or'ed, the latest snapshot wins).
+ * A subscriber has at most one delivery task on the serial ffrt queue and every call is oneway, so the
+ * work held for a slow client is bounded and never delays the event processing or the other clients.
+ * Subscribers are removed when their process dies.
+ */
+class BatteryListenerManager {
+public:
+    static constexpr size_t MAX_LISTENERS = 64;
+    static constexpr size_t MAX_LISTENERS_PER_PID = 8;
+    static constexpr int64_t MAX_INTERVAL_MS = 3600000;
+    // only system callers may see these fields change, see BatteryService::GetBatteryInfoSnapshotInner
+    static constexpr uint32_t SYSTEM_FIELDS = BatteryInfo::FIELD_TOTAL_ENERGY | BatteryInfo::FIELD_REMAIN_ENERGY;
+    struct Stats {
+        uint32_t listeners { 0 };
+        uint64_t notified { 0 };
+        uint64_t coalesced { 0 };
+        uint64_t delivered { 0 };
+        uint64_t died { 0 };
+    };
+
+    BatteryListenerManager();
+    ~BatteryListenerManager() = default;
+
+    BatteryError Register(const sptr<IBatteryListener>& listener, uint32_t fieldMask, int64_t minIntervalMs,
+        int32_t pid, bool isSystem);
+    BatteryError Unregister(const sptr<IBatteryListener>& listener);
+    // cheap check so the caller only builds the snapshots when someone listens
+    bool HasListeners() const;
+    void Notify(uint32_t changedFields, const BatteryInfoSnapshot& systemSnapshot,
+        const BatteryInfoSnapshot& publicSnapshot);
+    Stats GetStats();
+
+private:
+    class ListenerDeathRecipient : public IRemoteObject::DeathRecipient {
+    public:
+        explicit ListenerDeathRecipient(BatteryListenerManager& manager) : manager_(manager) {}
+        ~ListenerDeathRecipient() override = default;
+        void OnRemoteDied(const wptr<IRemoteObject>& remote) override;
+    private:
+        BatteryListenerManager& manager_;
+    };
+    struct Subscriber {
+        sptr<IBatteryListener> listener { nullptr };
+        sptr<IRemoteObject> remote { nullptr };
+        uint32_t fieldMask { 0 };
+        int64_t minIntervalMs { 0 };
+        int32_t pid { 0 };
+        bool isSystem { false };
+        int64_t lastDeliveryMs { 0 };
+        bool delivered { false };
+        bool scheduled { false };
+        uint32_t pendingFields { 0 };
+        std::shared_ptr<const BatteryInfoSnapshot> pending { nullptr };
+    };
+
+    static int64_t GetTickMs();
+    void ScheduleLocked(IRemoteObject* key, Subscriber& subscriber, int64_t nowMs);
+    void Deliver(IRemoteObject* key);
+    void OnListenerDied(const wptr<IRemoteObject>& remote);
+
+    std::mutex mutex_;
+    // keyed by the listener's remote object, which the subscriber holds
+    std::map<IRemoteObject*, Subscriber> subscribers_;
+    std::atomic<uint32_t> count_ { 0 };
+    sptr<IRemoteObject::DeathRecipient> deathRecipient_ { nullptr };
+    std::atomic<uint64_t> notified_ { 0 };
+    std::atomic<uint64_t> coalesced_ { 0 };
+    std::atomic<uint64_t> delivered_ { 0 };
+    std::atomic<uint64_t> died_ { 0 };
+    std::shared_ptr<ffrt::queue> queue_ { nullptr };
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_LISTENER_MANAGER_H
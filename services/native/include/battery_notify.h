@@ -16,24 +16,32 @@
 #ifndef BATTERY_SERVICE_SUBSCRIBER_H
 #define BATTERY_SERVICE_SUBSCRIBER_H
 
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 #include "want.h"
 
+#include "battery_event_log.h"
 #include "battery_info.h"
 
 namespace OHOS {
 namespace PowerMgr {
 class BatteryNotify {
 public:
+    struct ChangedEventStats {
+        uint64_t published { 0 };
+        uint64_t suppressed { 0 };
+    };
     BatteryNotify();
     ~BatteryNotify() = default;
-    int32_t PublishEvents(BatteryInfo& info);
+    int32_t PublishEvents(BatteryInfo& info, uint32_t changedFields = BatteryInfo::FIELD_ALL);
+    ChangedEventStats GetChangedEventStats() const;
     bool PublishCustomEvent(const BatteryInfo& info, const std::string& commonEventName) const;
     bool HandleNotification(const std::string& ueventName) const;
 
 private:
     void HandleUevent(BatteryInfo& info);
+    bool IsChangedEventSignificant(const BatteryInfo& info, uint32_t changedFields) const;
     bool PublishChangedEvent(const BatteryInfo& info);
     bool PublishChangedEventInner(const BatteryInfo& info) const;
     bool PublishLowEvent(const BatteryInfo& info) const;
@@ -54,13 +62,22 @@ private:
     void RotationMotionSubscriber() const;
     void RotationMotionUnsubscriber() const;
 
-    int32_t lowCapacity_ = -1;
     ChargeType batteryInfoChargeType_ = ChargeType::NONE;
     int32_t lastCapacity_ = -1;
     int32_t lastPluggedType_ = -1;
     int32_t lastTemperature_ = -1;
     int32_t lastHealthState_ = -1;
     BatteryPluggedType lastPowerPluggedType_ = BatteryPluggedType::PLUGGED_TYPE_BUTT;
+    // BATTERY_CHANGED publish policy, voltage and temperature jitter below the deltas is not broadcast
+    int32_t voltageDelta_ = 0;
+    int32_t temperatureDelta_ = 0;
+    int32_t minInterval_ = 0;
+    int32_t lastChangedVoltage_ = INVALID_BATT_INT_VALUE;
+    int32_t lastChangedTemperature_ = INVALID_BATT_TEMP_VALUE;
+    int64_t lastChangedTime_ = 0;
+    std::atomic<uint64_t> changedPublished_ { 0 };
+    std::atomic<uint64_t> changedSuppressed_ { 0 };
+    BatteryLogLimiter ueventLogLimiter_;
     std::mutex mutex_;
 };
 } // namespace PowerMgr
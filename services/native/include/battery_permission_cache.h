@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_PERMISSION_CACHE_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_PERMISSION_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS {
+namespace Security {
+namespace AccessToken {
+class PermStateChangeCallbackCustomize;
+}
+}
+
+namespace PowerMgr {
+/**
+ * Caches the permission decisions of the ipc callers, keyed by the calling full token id.
+ *
+ * The system app flag is part of the full token id, so IsSystem decisions never go stale. Grants of the
+ * permissions passed to Init are only cached once the access token service notifies their state changes,
+ * each change drops the decisions of the affected token. The least recently used token is evicted when
+ * the cache is full.
+ */
+class BatteryPermissionCache {
+public:
+    struct Stats {
+        uint64_t hits { 0 };
+        uint64_t misses { 0 };
+        uint64_t invalidations { 0 };
+        uint32_t size { 0 };
+    };
+    static constexpr uint32_t CAPACITY = 64;
+    static constexpr uint32_t MAX_PERMISSIONS = 31;
+
+    BatteryPermissionCache() = default;
+    ~BatteryPermissionCache();
+
+    bool Init(const std::vector<std::string>& permissions);
+    bool IsSystem();
+    bool IsNativePermissionGranted(const std::string& permission);
+    void Invalidate(uint32_t tokenId);
+    void Clear();
+    Stats GetStats();
+
+private:
+    // bit 0 holds the IsSystem decision, bit i + 1 the grant of permissions_[i]
+    struct Entry {
+        uint64_t tokenId { 0 };
+        uint32_t known { 0 };
+        uint32_t granted { 0 };
+    };
+    using EntryList = std::list<Entry>;
+    using Checker = std::function<bool()>;
+
+    bool Decide(uint32_t bit, const Checker& checker);
+    bool Lookup(uint64_t tokenId, uint32_t bit, bool& isGranted);
+    void Insert(uint64_t tokenId, uint32_t bit, bool isGranted, uint64_t generation);
+
+    std::mutex mutex_;
+    EntryList entries_; // most recently used first
+    std::unordered_map<uint64_t, EntryList::iterator> index_;
+    std::vector<std::string> permissions_;
+    std::atomic_bool enabled_ { true };
+    std::atomic_bool isSubscribed_ { false };
+    std::atomic<uint64_t> hits_ { 0 };
+    std::atomic<uint64_t> misses_ { 0 };
+    std::atomic<uint64_t> invalidations_ { 0 };
+    std::shared_ptr<Security::AccessToken::PermStateChangeCallbackCustomize> callback_ { nullptr };
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_PERMISSION_CACHE_H
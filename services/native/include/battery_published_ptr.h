@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_PUBLISHED_PTR_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_PUBLISHED_PTR_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * An immutable value replaced as a whole by the writers and read by the binder threads.
+ *
+ * The std::atomic_load and std::atomic_store overloads for shared_ptr lock a mutex from a global
+ * pool on every call, shared with every other shared_ptr atomic of the process. Here every Update
+ * takes a new version, each reader thread keeps the value it loaded last together with its version
+ * and takes mutex_ only to reload after an Update. Between two updates a read is one acquire load and
+ * a reference count increment, readers never wait for the writer and the writer only waits for the
+ * readers reloading right after its previous Update. A thread keeps its last value alive until its
+ * next reload. Versions are unique across the instances of T, one cache per thread and T serves all
+ * of them.
+ */
+template <typename T>
+class BatteryPublishedPtr {
+public:
+    explicit BatteryPublishedPtr(std::shared_ptr<const T> value) : value_(std::move(value)), version_(NextVersion())
+    {
+    }
+    BatteryPublishedPtr(const BatteryPublishedPtr&) = delete;
+    BatteryPublishedPtr& operator=(const BatteryPublishedPtr&) = delete;
+
+    std::shared_ptr<const T> Load() const
+    {
+        thread_local Cache cache;
+        if (cache.version == version_.load(std::memory_order_acquire)) {
+            return cache.value;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache.version = version_.load(std::memory_order_relaxed);
+        cache.value = value_;
+        return cache.value;
+    }
+
+    void Store(std::shared_ptr<const T> value)
+    {
+        (void)Update([&value](const std::shared_ptr<const T>&) { return std::move(value); });
+    }
+
+    // Replaces the value with make(current) unless it returns nullptr, the makers run one at a time
+    template <typename Maker>
+    bool Update(const Maker& make)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::shared_ptr<const T> value = make(value_);
+        if (value == nullptr) {
+            return false;
+        }
+        value_ = std::move(value);
+        version_.store(NextVersion(), std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct Cache {
+        uint64_t version { 0 };
+        std::shared_ptr<const T> value { nullptr };
+    };
+    static uint64_t NextVersion()
+    {
+        static std::atomic<uint64_t> lastVersion { 0 };
+        return lastVersion.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    mutable std::mutex mutex_;
+    std::shared_ptr<const T> value_;
+    std::atomic<uint64_t> version_;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_PUBLISHED_PTR_H
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_SCENE_CONFIG_CACHE_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_SCENE_CONFIG_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Caches the scene config answers of the battery hdi.
+ *
+ * Supported answers live as long as the hdi connection, values expire after maxAge ms so changes made
+ * on the hdi side are picked up, and SetBatteryConfig writes through by dropping the value of the scene.
+ * A lookup returns the generation to pass to the following Put, a Put is ignored when the cache was
+ * invalidated in between.
+ */
+class BatterySceneConfigCache {
+public:
+    struct Stats {
+        uint64_t hits { 0 };
+        uint64_t misses { 0 };
+        uint32_t values { 0 };
+        uint32_t supported { 0 };
+    };
+    static constexpr uint32_t CAPACITY = 64;
+
+    void SetMaxAge(int32_t maxAge);
+    bool GetValue(const std::string& sceneName, std::string& value, uint64_t& generation);
+    void PutValue(const std::string& sceneName, const std::string& value, uint64_t generation);
+    bool GetSupported(const std::string& sceneName, bool& isSupported, uint64_t& generation);
+    void PutSupported(const std::string& sceneName, bool isSupported, uint64_t generation);
+    void Invalidate(const std::string& sceneName);
+    void Clear();
+    Stats GetStats();
+
+private:
+    struct ValueEntry {
+        std::string value;
+        int64_t time { 0 };
+    };
+    static int64_t GetTickMs();
+    bool Miss(uint64_t& generation);
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, ValueEntry> values_;
+    std::unordered_map<std::string, bool> supported_;
+    uint64_t generation_ { 0 };
+    int32_t maxAge_ { 0 };
+    std::atomic<uint64_t> hits_ { 0 };
+    std::atomic<uint64_t> misses_ { 0 };
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_SCENE_CONFIG_CACHE_H
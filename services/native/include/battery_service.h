@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <iosfwd>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
 #include <vector>
@@ -35,11 +36,28 @@
 #include "refbase.h"
 #include "system_ability.h"
 
+#include "battery_charge_session_stats.h"
+#include "battery_charge_time_estimator.h"
+#include "battery_discharge_time_estimator.h"
+#include "battery_energy_integrator.h"
+#include "battery_listener_manager.h"
+#include "battery_event_log.h"
+#include "battery_event_pipeline.h"
+#include "battery_history.h"
+#include "battery_journal.h"
 #include "battery_info.h"
+#include "battery_info_snapshot.h"
+#include "battery_ipc_stats.h"
 #include "battery_light.h"
 #include "battery_notify.h"
+#include "battery_permission_cache.h"
+#include "battery_published_ptr.h"
+#include "battery_scene_config_cache.h"
+#include "battery_soc_table.h"
 #include "battery_srv_errors.h"
 #include "battery_srv_stub.h"
+#include "battery_startup_stats.h"
+#include "battery_stats_window.h"
 #include "battery_xcollie.h"
 #include "ibattery_srv.h"
 #include "sp_singleton.h"
@@ -69,8 +87,26 @@ public:
     }
 
     int32_t Dump(int fd, const std::vector<std::u16string> &args) override;
+    int32_t OnRemoteRequest(uint32_t code, MessageParcel& data, MessageParcel& reply,
+        MessageOption& option) override;
     ChargeType GetChargeType();
     bool ChangePath(const std::string path);
+    BatteryEventPipeline::Stats GetEventStats();
+    BatteryNotify::ChangedEventStats GetChangedEventStats();
+    BatteryPermissionCache::Stats GetPermissionCacheStats();
+    BatterySceneConfigCache::Stats GetSceneConfigCacheStats();
+    const BatteryStartupStats& GetStartupStats() const;
+    const BatteryEventLog& GetEventLog() const;
+    const BatteryHistory& GetHistory() const;
+    const BatteryChargeSessionStats& GetChargeSessionStats() const;
+    BatteryListenerManager::Stats GetListenerStats();
+    BatteryIpcStats& GetIpcStats();
+    BatteryCapacityLevel GetCapacityLevelByCapacity(int32_t capacity);
+    std::shared_ptr<const BatterySocTable> GetSocTable() const;
+    uint64_t GetHdiCallCount() const
+    {
+        return hdiCallCount_.load(std::memory_order_relaxed);
+    }
 private:
     int32_t GetCapacityInner();
     BatteryChargeState GetChargingStatusInner();
@@ -86,9 +122,21 @@ private:
     int32_t GetBatteryTemperatureInner();
     BatteryCapacityLevel GetCapacityLevelInner();
     int64_t GetRemainingChargeTimeInner();
+    int64_t GetRemainingDischargeTimeInner();
     BatteryError SetBatteryConfigInner(const std::string& sceneName, const std::string& value);
     BatteryError GetBatteryConfigInner(const std::string& sceneName, std::string& result);
     BatteryError IsBatteryConfigSupportedInner(const std::string& sceneName, bool& result);
+    BatteryError GetBatteryInfoSnapshotInner(BatteryInfoSnapshot& snapshot);
+    BatteryError SetBatteryConfigsInner(const std::vector<std::string>& sceneNames,
+        const std::vector<std::string>& values, std::vector<int32_t>& batteryErrs);
+    BatteryError GetBatteryConfigsInner(const std::vector<std::string>& sceneNames,
+        std::vector<std::string>& results, std::vector<int32_t>& batteryErrs);
+    BatteryError GetBatteryStatsInner(int32_t windowSeconds, BatteryWindowStats& stats);
+    BatteryError GetChargeSessionsInner(BatteryChargeSessions& sessions);
+    BatteryError GetEnergyCountersInner(BatteryEnergyCounters& counters);
+    BatteryError RegisterBatteryListenerInner(const sptr<IBatteryListener>& listener, uint32_t fieldMask,
+        int64_t minIntervalMs);
+    BatteryError UnregisterBatteryListenerInner(const sptr<IBatteryListener>& listener);
 public:
     int32_t GetCapacity(int32_t& capacity) override;
     int32_t GetChargingStatus(uint32_t& chargeState) override;
@@ -104,9 +152,21 @@ public:
     int32_t GetBatteryTemperature(int32_t& temperature) override;
     int32_t GetCapacityLevel(uint32_t& batteryCapacityLevel) override;
     int32_t GetRemainingChargeTime(int64_t& remainTime) override;
+    int32_t GetRemainingDischargeTime(int64_t& remainTime) override;
     int32_t SetBatteryConfig(const std::string& sceneName, const std::string& value, int32_t& batteryErr) override;
     int32_t GetBatteryConfig(const std::string& sceneName, std::string& result, int32_t& batteryErr) override;
     int32_t IsBatteryConfigSupported(const std::string& featureName, bool& result, int32_t& batteryErr) override;
+    int32_t GetBatteryInfoSnapshot(BatteryInfoSnapshot& snapshot, int32_t& batteryErr) override;
+    int32_t SetBatteryConfigs(const std::vector<std::string>& sceneNames, const std::vector<std::string>& values,
+        std::vector<int32_t>& batteryErrs, int32_t& batteryErr) override;
+    int32_t GetBatteryConfigs(const std::vector<std::string>& sceneNames, std::vector<std::string>& results,
+        std::vector<int32_t>& batteryErrs, int32_t& batteryErr) override;
+    int32_t GetBatteryStats(int32_t windowSeconds, BatteryWindowStats& stats, int32_t& batteryErr) override;
+    int32_t GetChargeSessions(BatteryChargeSessions& sessions, int32_t& batteryErr) override;
+    int32_t GetEnergyCounters(BatteryEnergyCounters& counters, int32_t& batteryErr) override;
+    int32_t RegisterBatteryListener(const sptr<IBatteryListener>& listener, uint32_t fieldMask, int64_t minIntervalMs,
+        int32_t& batteryErr) override;
+    int32_t UnregisterBatteryListener(const sptr<IBatteryListener>& listener, int32_t& batteryErr) override;
 
     void InitConfig();
     void HandleTemperature(int32_t temperature);
@@ -130,13 +190,25 @@ private:
     bool Init();
     void AddBootCommonEvents();
     bool FillCommonEvent(std::string& ueventName, std::string& type);
+    BatteryError DoSetBatteryConfig(const std::string& sceneName, const std::string& value);
+    BatteryError DoGetBatteryConfig(const std::string& sceneName, std::string& result);
+    void DoGetBatteryConfigs(const std::vector<std::string>& sceneNames, std::vector<std::string>& results,
+        std::vector<int32_t>& batteryErrs);
     void WakeupDevice(BatteryChargeState chargeState);
     void RegisterBootCompletedCallback();
     int32_t HandleBatteryCallbackEvent(const OHOS::HDI::Battery::V2_0::BatteryInfo& event);
-    void ConvertingEvent(const OHOS::HDI::Battery::V2_0::BatteryInfo &event);
+    uint32_t ConvertingEvent(const OHOS::HDI::Battery::V2_0::BatteryInfo &event);
     void InitBatteryInfo();
-    void HandleBatteryInfo();
-    void CalculateRemainingChargeTime(int32_t capacity, BatteryChargeState chargeState);
+    void HandleBatteryInfo(uint32_t changedFields = BatteryInfo::FIELD_ALL, bool deferBroadcast = false);
+    void HandleBroadcast(BatteryInfo& info, uint32_t changedFields);
+    void MarkFirstChanged();
+    bool DoRegisterHdiStatusListener(const sptr<OHOS::HDI::ServiceManager::V1_0::IServiceManager>& hdiServiceMgr);
+    void CalculateRemainingChargeTime(const BatteryInfo& info);
+    void CalculateRemainingDischargeTime(const BatteryInfo& info);
+    void HandleChargeSession(uint32_t changedFields, int64_t wallTimeMs);
+    void NotifyListeners(uint32_t changedFields);
+    void ScheduleJournalFlush();
+    void FlushJournal();
     void HandleCapacity(int32_t capacity, BatteryChargeState chargeState, bool isBatteryPresent);
 #ifdef BATTERY_MANAGER_SET_LOW_CAPACITY_THRESHOLD
     void HandleCapacityExt(int32_t capacity, BatteryChargeState chargeState, bool isBatteryPresent);
@@ -156,28 +228,60 @@ private:
 #ifdef BATTERY_MANAGER_SET_LOW_CAPACITY_THRESHOLD
     void SetLowCapacityThreshold();
 #endif
-    bool CapacityLevelCompare(int32_t capacity, int32_t minCapacity, int32_t maxCapacity);
+    void BuildSocTable();
+    bool FetchBatteryInfo(BatteryInfo& info);
+    void FillSnapshot(BatteryInfo info, bool isSystem, uint64_t sequence, int64_t timestamp,
+        BatteryInfoSnapshot& snapshot);
+    struct SnapshotEntry {
+        std::shared_ptr<const BatteryInfo> info { nullptr };
+        int64_t time { 0 };
+        uint64_t seq { 0 };
+    };
+    std::shared_ptr<const SnapshotEntry> LoadSnapshot() const;
+    bool IsSnapshotFresh(const std::shared_ptr<const SnapshotEntry>& entry) const;
+    std::shared_ptr<const SnapshotEntry> AcquireSnapshotEntry();
+    std::shared_ptr<const BatteryInfo> AcquireSnapshot();
+    std::shared_ptr<const SnapshotEntry> RefreshSnapshot();
+    bool StoreSnapshot(std::shared_ptr<SnapshotEntry> entry, bool onlyIfNewer);
+    void UpdateSnapshot(const BatteryInfo& info);
+    void InvalidateSnapshot();
+    std::shared_ptr<const BatteryInfo> LoadBatteryInfo() const;
+    void PublishBatteryInfo();
     bool ready_ { false };
     static std::atomic_bool isBootCompleted_;
     std::shared_mutex mutex_;
     std::unique_ptr<BatteryNotify> batteryNotify_ { nullptr };
+    std::unique_ptr<BatteryEventPipeline> eventPipeline_ { nullptr };
+    std::mutex broadcastMutex_; // serializes light updates and batteryNotify_ publications
     BatteryLight batteryLight_;
+    BatteryPermissionCache permissionCache_;
+    BatterySceneConfigCache sceneConfigCache_;
     sptr<HDI::Battery::V2_0::IBatteryInterface> iBatteryInterface_ { nullptr };
     sptr<OHOS::HDI::ServiceManager::V1_0::IServiceManager> hdiServiceMgr_ { nullptr };
     sptr<HdiServiceStatusListener::IServStatListener> hdiServStatListener_ { nullptr };
+    std::mutex hdiListenerMutex_; // guards hdiServiceMgr_ and hdiServStatListener_ registration
+    BatteryStartupStats startupStats_;
+    BatteryEventLog eventLog_;
+    BatteryLogLimiter infoLogLimiter_;
+    BatteryHistory history_;
+    BatteryJournal journal_;
+    BatteryStatsWindows statsWindows_;
+    BatteryChargeSessionStats chargeSessions_;
+    BatteryEnergyIntegrator energyIntegrator_;
+    BatteryListenerManager listenerManager_;
+    BatteryIpcStats ipcStats_;
 #ifdef BATTERY_MANAGER_SET_LOW_CAPACITY_THRESHOLD
     std::shared_ptr<EventFwk::CommonEventSubscriber> subscriberPtr_ {nullptr};
     bool isHibernateEnable_ { true };
 #endif
     bool isLowPower_ { false };
-    bool isMockUnplugged_ { false };
-    bool isMockCapacity_ { false };
-    bool isMockUevent_ { false };
-    bool chargeFlag_ { false };
+    std::atomic_bool isMockUnplugged_ { false };
+    std::atomic_bool isMockCapacity_ { false };
+    std::atomic_bool isMockUevent_ { false };
     std::atomic_bool isBatteryHdiReady_ { false };
     std::atomic_bool isCommonEventReady_ { false };
+    std::atomic<uint64_t> hdiCallCount_ { 0 };
     int32_t commEventRetryTimes_ { 0 };
-    int32_t lastCapacity_ { 0 };
     int32_t dialogId_ { INVALID_BATT_INT_VALUE };
     int32_t warnCapacity_ { INVALID_BATT_INT_VALUE };
     int32_t highTemperature_ { INT32_MAX };
@@ -189,11 +293,29 @@ private:
     int32_t normalCapacityThreshold_ = { INVALID_BATT_INT_VALUE };
     int32_t highCapacityThreshold_ = { INVALID_BATT_INT_VALUE };
     int32_t fullCapacityThreshold_ = { INVALID_BATT_INT_VALUE };
-    int64_t lastTime_ { 0 };
-    int64_t remainTime_ { 0 };
+    // Built from the thresholds above and the light conf, replaced as a whole on config load
+    BatteryPublishedPtr<BatterySocTable> socTable_ { std::make_shared<const BatterySocTable>() };
+    // Written by the writers under infoMutex_, read by binder threads
+    BatteryChargeTimeEstimator chargeTimeEstimator_;
+    std::atomic<int64_t> remainTime_ { 0 };
+    std::atomic<int32_t> remainTimeConfidence_ { 0 };
+    BatteryDischargeTimeEstimator dischargeTimeEstimator_;
+    std::atomic<int64_t> remainDischargeTime_ { 0 };
+    // batteryInfo_ and lastBatteryInfo_ belong to the writers (hdi events, mock and reset), serialized by
+    // infoMutex_. Binder threads only read the immutable copy in publishedInfo_, swapped by PublishBatteryInfo.
     BatteryInfo batteryInfo_;
     BatteryInfo lastBatteryInfo_;
+    std::mutex infoMutex_;
+    BatteryPublishedPtr<BatteryInfo> publishedInfo_ { std::make_shared<const BatteryInfo>() };
     std::mutex shutdownGuardMutex_;
+    // Last sample pushed by (or refreshed from) the battery hdi, served to the getters while
+    // it is younger than snapshotMaxAge_ ms. A non-positive max age queries the hdi per call.
+    // The entry is immutable and replaced as a whole, see BatteryPublishedPtr for what readers pay.
+    int32_t snapshotMaxAge_ { 0 };
+    BatteryPublishedPtr<SnapshotEntry> snapshot_ { std::make_shared<const SnapshotEntry>() };
+    std::mutex snapshotRefreshMutex_;
+    // Scene config values are served from sceneConfigCache_ for sceneConfigMaxAge_ ms, 0 disables it
+    int32_t sceneConfigMaxAge_ { 0 };
 };
 
 #ifdef BATTERY_MANAGER_SET_LOW_CAPACITY_THRESHOLD
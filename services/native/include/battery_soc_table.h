@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_SOC_TABLE_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_SOC_TABLE_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "battery_config.h"
+#include "battery_info.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Everything derived from the state of charge alone, precomputed for every capacity from 0 to 100.
+ *
+ * The table is immutable once built. The service builds it in InitConfig, which reads the soc
+ * configuration once per service start, and swaps it in as a whole. There is no runtime reload of
+ * the configuration, a reload path added later has to call BuildSocTable as well.
+ */
+class BatterySocTable {
+public:
+    struct Thresholds {
+        int32_t shutdown { INVALID_BATT_INT_VALUE };
+        int32_t critical { INVALID_BATT_INT_VALUE };
+        int32_t warning { INVALID_BATT_INT_VALUE };
+        int32_t low { INVALID_BATT_INT_VALUE };
+        int32_t normal { INVALID_BATT_INT_VALUE };
+        int32_t high { INVALID_BATT_INT_VALUE };
+        int32_t full { INVALID_BATT_INT_VALUE };
+    };
+    struct Entry {
+        BatteryCapacityLevel level { BatteryCapacityLevel::LEVEL_NONE };
+        bool hasColor { false };
+        uint32_t rgb { 0 };
+        // at or below the capacity of the battery low broadcast
+        bool isLow { false };
+    };
+    static constexpr int32_t MIN_SOC = 0;
+    static constexpr int32_t MAX_SOC = 100;
+    static constexpr int32_t DEFAULT_LOW_CAPACITY = 20;
+
+    BatterySocTable();
+    ~BatterySocTable() = default;
+
+    void Build(const Thresholds& thresholds, int32_t lowCapacity,
+        const std::vector<BatteryConfig::LightConf>& lightConf);
+    const Entry& Lookup(int32_t capacity) const
+    {
+        if (capacity < MIN_SOC || capacity > MAX_SOC) {
+            return outOfRange_;
+        }
+        return entries_[capacity];
+    }
+    // Out of range capacities are clamped, an invalid negative reading counts as low
+    bool IsLow(int32_t capacity) const
+    {
+        return entries_[std::clamp(capacity, MIN_SOC, MAX_SOC)].isLow;
+    }
+    static bool CapacityLevelCompare(int32_t capacity, int32_t minCapacity, int32_t maxCapacity);
+
+private:
+    static bool IsThresholdsValid(const Thresholds& thresholds);
+    static BatteryCapacityLevel GetLevel(const Thresholds& thresholds, int32_t capacity);
+    void Fill(const Thresholds& thresholds, int32_t lowCapacity,
+        const std::vector<BatteryConfig::LightConf>& lightConf);
+
+    std::array<Entry, MAX_SOC + 1> entries_ {};
+    Entry outOfRange_ {};
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_SOC_TABLE_H
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_STARTUP_STATS_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_STARTUP_STATS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Records when each battery SA startup phase completed, in ms since boot (CLOCK_BOOTTIME), so the
+ * time to the first BATTERY_CHANGED can be compared across builds. Only the first mark of a phase
+ * is kept, a later OnStart or hdi restart does not move the timestamps.
+ */
+class BatteryStartupStats {
+public:
+    enum Phase : uint32_t {
+        ON_START = 0,
+        CONFIG_LOADED,
+        VIBRATOR_LOADED,
+        PLUGINS_SCANNED,
+        PERMISSION_READY,
+        INIT_DONE,
+        HDI_LISTENER_REGISTERED,
+        PUBLISHED,
+        HDI_READY,
+        INFO_LOADED,
+        FIRST_CHANGED,
+        PHASE_COUNT
+    };
+
+    void Mark(Phase phase);
+    bool IsMarked(Phase phase) const;
+    int64_t GetTime(Phase phase) const;
+    void AddHdiListenerRetry();
+    uint32_t GetHdiListenerRetries() const;
+    static const char* GetName(Phase phase);
+    static int64_t GetBootTimeMs();
+
+private:
+    std::array<std::atomic<int64_t>, PHASE_COUNT> times_ {};
+    std::atomic<uint32_t> hdiListenerRetries_ { 0 };
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_STARTUP_STATS_H
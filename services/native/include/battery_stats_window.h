@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_STATS_WINDOW_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_STATS_WINDOW_H
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+#include "battery_window_stats.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Sliding window over the battery samples of the last windowMs.
+ *
+ * Keeps a running sum per metric for the average and a monotonic deque per metric for the min
+ * and the max, so adding a sample and dropping an expired one are amortized O(1) and reading an
+ * aggregate is O(1). The sample count is capped, the oldest sample is dropped first.
+ */
+class BatteryStatsWindow {
+public:
+    enum Metric : uint32_t {
+        METRIC_CURRENT = 0,
+        METRIC_VOLTAGE,
+        METRIC_TEMPERATURE,
+        METRIC_COUNT,
+    };
+    using Values = std::array<int32_t, METRIC_COUNT>;
+    static constexpr size_t MAX_SAMPLES = 4096;
+
+    explicit BatteryStatsWindow(int64_t windowMs) : windowMs_(windowMs) {}
+    void Add(int64_t time, const Values& values);
+    // Drops the samples older than now - windowMs
+    void Evict(int64_t now);
+    uint32_t GetSampleCount() const
+    {
+        return static_cast<uint32_t>(samples_.size());
+    }
+    BatteryWindowStats::Aggregate GetAggregate(Metric metric) const;
+
+private:
+    struct Sample {
+        uint64_t seq;
+        int64_t time;
+        Values values;
+    };
+    struct Extreme {
+        uint64_t seq;
+        int32_t value;
+    };
+    void PopFront();
+
+    int64_t windowMs_;
+    uint64_t nextSeq_ { 0 };
+    std::deque<Sample> samples_;
+    std::array<int64_t, METRIC_COUNT> sums_ {};
+    std::array<std::deque<Extreme>, METRIC_COUNT> minQueues_;
+    std::array<std::deque<Extreme>, METRIC_COUNT> maxQueues_;
+};
+
+/**
+ * The 1, 5 and 15 minute windows served by GetBatteryStats, fed from the battery event path.
+ */
+class BatteryStatsWindows {
+public:
+    static constexpr std::array<int32_t, 3> WINDOW_SECONDS = { 60, 300, 900 };
+
+    BatteryStatsWindows();
+    void Add(int64_t time, const BatteryStatsWindow::Values& values);
+    // Returns false if windowSeconds is not one of WINDOW_SECONDS
+    bool Get(int32_t windowSeconds, int64_t now, BatteryWindowStats& stats);
+
+private:
+    std::mutex mutex_;
+    std::array<BatteryStatsWindow, WINDOW_SECONDS.size()> windows_;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_STATS_WINDOW_H
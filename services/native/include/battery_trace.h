@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWERMGR_BATTERY_MANAGER_BATTERY_TRACE_H
+#define POWERMGR_BATTERY_MANAGER_BATTERY_TRACE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace OHOS {
+namespace PowerMgr {
+enum class BatteryTraceStage : uint32_t {
+    HDI_RECEIVE = 0,
+    CONVERT,
+    SHUTDOWN_CHECK,
+    WAKEUP,
+    LIGHT,
+    HOOK,
+    PUBLISH_UEVENT,
+    PUBLISH_CHANGED,
+    PUBLISH_CHANGED_INNER,
+    PUBLISH_CAPACITY,
+    PUBLISH_PLUGGED,
+    PUBLISH_CHARGING,
+    PUBLISH_CHARGE_TYPE,
+    COUNT
+};
+
+/**
+ * Per stage counters of the battery event path, from the hdi callback to the last common event.
+ *
+ * Stage durations are kept as count, total and max, publish stages also count their failures.
+ * Hdi pushes are counted in one second buckets to report the recent event rate.
+ */
+class BatteryTrace {
+public:
+    struct StageStats {
+        const char* name { nullptr };
+        uint64_t count { 0 };
+        uint64_t totalUs { 0 };
+        uint64_t maxUs { 0 };
+        uint64_t failures { 0 };
+    };
+    static constexpr uint32_t STAGE_COUNT = static_cast<uint32_t>(BatteryTraceStage::COUNT);
+    static constexpr int64_t RATE_WINDOW_S = 10;
+
+    static BatteryTrace& GetInstance();
+    static const char* GetStageName(BatteryTraceStage stage);
+    void Record(BatteryTraceStage stage, int64_t durationUs, bool isSuccess);
+    void CountEvent();
+    uint64_t GetEvents() const;
+    // events of the last RATE_WINDOW_S complete seconds
+    uint64_t GetRecentEvents() const;
+    uint64_t GetPublishFailures() const;
+    std::vector<StageStats> GetStageStats() const;
+    void Reset();
+
+private:
+    struct Stage {
+        std::atomic<uint64_t> count { 0 };
+        std::atomic<uint64_t> totalUs { 0 };
+        std::atomic<uint64_t> maxUs { 0 };
+        std::atomic<uint64_t> failures { 0 };
+    };
+    struct RateBucket {
+        std::atomic<int64_t> second { -1 };
+        std::atomic<uint64_t> count { 0 };
+    };
+    static constexpr uint32_t RATE_BUCKETS = 16;
+
+    std::array<Stage, STAGE_COUNT> stages_ {};
+    std::array<RateBucket, RATE_BUCKETS> rate_ {};
+    std::atomic<uint64_t> events_ { 0 };
+    std::atomic<uint64_t> publishFailures_ { 0 };
+};
+
+/**
+ * Times one stage into BatteryTrace and, in builds with hitrace, emits a trace span while the
+ * power tag is enabled.
+ */
+class BatteryTraceScope {
+public:
+    explicit BatteryTraceScope(BatteryTraceStage stage);
+    ~BatteryTraceScope();
+    BatteryTraceScope(const BatteryTraceScope&) = delete;
+    BatteryTraceScope& operator=(const BatteryTraceScope&) = delete;
+
+    bool Check(bool isSuccess)
+    {
+        isSuccess_ = isSuccess_ && isSuccess;
+        return isSuccess;
+    }
+
+private:
+    BatteryTraceStage stage_;
+    int64_t start_ { 0 };
+    bool isSuccess_ { true };
+    // only used with hitrace, kept in every build so the layout does not depend on the defines of the includer
+    [[maybe_unused]] bool isTracing_ { false };
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWERMGR_BATTERY_MANAGER_BATTERY_TRACE_H
@@ -17,12 +17,15 @@
 
 #include "hdf_base.h"
 #include "battery_log.h"
+#include "battery_trace.h"
 
 namespace OHOS {
 namespace PowerMgr {
 BatteryCallback::BatteryEventCallback BatteryCallback::eventCb_ = nullptr;
 int32_t BatteryCallback::Update(const HDI::Battery::V2_0::BatteryInfo& event)
 {
+    BatteryTrace::GetInstance().CountEvent();
+    BatteryTraceScope trace(BatteryTraceStage::HDI_RECEIVE);
     if (eventCb_ == nullptr) {
         BATTERY_HILOGW(FEATURE_BATT_INFO, "eventCb_ is nullptr, cannot update battery info");
         return HDF_FAILURE;
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_charge_session_stats.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr double MS_PER_HOUR = 3600000.0;
+constexpr double UV_PER_V = 1000000.0;
+}
+
+void BatteryChargeSessionStats::Begin(int64_t wallTimeMs, int64_t timeMs, const BatteryInfo& info)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_ = Session();
+    current_.startTime = wallTimeMs;
+    current_.pluggedType = info.GetPluggedType();
+    current_.startCapacity = info.GetCapacity();
+    current_.endCapacity = info.GetCapacity();
+    current_.peakCurrent = info.GetNowCurrent();
+    current_.minTemperature = info.GetTemperature();
+    current_.maxTemperature = info.GetTemperature();
+    current_.active = true;
+    running_ = true;
+    startMs_ = timeMs;
+    lastMs_ = timeMs;
+    lastCurrent_ = info.GetNowCurrent();
+    lastVoltage_ = info.GetVoltage();
+    lastChargeType_ = info.GetChargeType();
+    chargeMaMs_ = 0;
+    energyUvMaMs_ = 0;
+}
+
+void BatteryChargeSessionStats::Update(int64_t timeMs, const BatteryInfo& info)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    UpdateLocked(timeMs, info);
+}
+
+void BatteryChargeSessionStats::UpdateLocked(int64_t timeMs, const BatteryInfo& info)
+{
+    if (!running_) {
+        return;
+    }
+    if (timeMs > lastMs_) {
+        double interval = static_cast<double>(timeMs - lastMs_);
+        chargeMaMs_ += lastCurrent_ * interval;
+        energyUvMaMs_ += static_cast<double>(lastVoltage_) * lastCurrent_ * interval;
+        size_t type = static_cast<size_t>(lastChargeType_);
+        if (type < current_.chargeTypeTime.size()) {
+            current_.chargeTypeTime[type] += timeMs - lastMs_;
+        }
+        lastMs_ = timeMs;
+    }
+    lastCurrent_ = info.GetNowCurrent();
+    lastVoltage_ = info.GetVoltage();
+    lastChargeType_ = info.GetChargeType();
+
+    current_.duration = lastMs_ - startMs_;
+    current_.endCapacity = info.GetCapacity();
+    current_.peakCurrent = std::max(current_.peakCurrent, info.GetNowCurrent());
+    current_.minTemperature = std::min(current_.minTemperature, info.GetTemperature());
+    current_.maxTemperature = std::max(current_.maxTemperature, info.GetTemperature());
+    current_.chargeDelivered = static_cast<int32_t>(chargeMaMs_ / MS_PER_HOUR);
+    current_.energyDelivered = static_cast<int32_t>(energyUvMaMs_ / UV_PER_V / MS_PER_HOUR);
+    current_.averageCurrent = (current_.duration > 0) ?
+        static_cast<int32_t>(chargeMaMs_ / current_.duration) : lastCurrent_;
+}
+
+void BatteryChargeSessionStats::End(int64_t timeMs, const BatteryInfo& info)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+        return;
+    }
+    UpdateLocked(timeMs, info);
+    current_.active = false;
+    finished_[next_] = current_;
+    next_ = (next_ + 1) % MAX_SESSIONS;
+    count_ = std::min(count_ + 1, MAX_SESSIONS);
+    running_ = false;
+}
+
+std::vector<BatteryChargeSessionStats::Session> BatteryChargeSessionStats::GetSessions() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Session> sessions;
+    sessions.reserve(count_ + 1);
+    for (size_t i = 0; i < count_; i++) {
+        sessions.push_back(finished_[(next_ + MAX_SESSIONS - count_ + i) % MAX_SESSIONS]);
+    }
+    if (running_) {
+        sessions.push_back(current_);
+    }
+    return sessions;
+}
+} // namespace PowerMgr
+} // namespace OHOS
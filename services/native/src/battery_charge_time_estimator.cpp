@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_charge_time_estimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr int64_t MS_PER_SEC = 1000;
+constexpr double FULL_CAPACITY = 100.0;
+// capacity reads 100 from FULL_CAPACITY - FULL_MARGIN on, the exponential taper never reaches FULL_CAPACITY
+constexpr double FULL_MARGIN = 0.5;
+constexpr int64_t MAX_REMAINING_MS = 24 * 3600 * MS_PER_SEC;
+constexpr uint32_t MIN_COUNTER_SAMPLES = 4;
+constexpr uint32_t CONFIDENT_SAMPLES = 8;
+constexpr double CONFIDENT_SPAN_SEC = 300.0;
+constexpr double PERCENT = 100.0;
+}
+
+void BatteryChargeTimeEstimator::Fit::Add(int64_t x, int64_t y)
+{
+    if (count_ == WINDOW) {
+        int64_t oldX = xs_[next_];
+        int64_t oldY = ys_[next_];
+        sumX_ -= oldX;
+        sumY_ -= oldY;
+        sumXX_ -= oldX * oldX;
+        sumXY_ -= oldX * oldY;
+        sumYY_ -= oldY * oldY;
+    } else {
+        count_++;
+    }
+    xs_[next_] = x;
+    ys_[next_] = y;
+    next_ = (next_ + 1) % WINDOW;
+    sumX_ += x;
+    sumY_ += y;
+    sumXX_ += x * x;
+    sumXY_ += x * y;
+    sumYY_ += y * y;
+}
+
+void BatteryChargeTimeEstimator::Fit::Clear()
+{
+    *this = Fit();
+}
+
+int64_t BatteryChargeTimeEstimator::Fit::GetSpan() const
+{
+    if (count_ == 0) {
+        return 0;
+    }
+    uint32_t newest = (next_ + WINDOW - 1) % WINDOW;
+    uint32_t oldest = (count_ == WINDOW) ? next_ : 0;
+    return xs_[newest] - xs_[oldest];
+}
+
+bool BatteryChargeTimeEstimator::Fit::GetSlope(double& slope) const
+{
+    int64_t n = static_cast<int64_t>(count_);
+    int64_t varX = n * sumXX_ - sumX_ * sumX_;
+    if (n < 2 || varX <= 0) {
+        return false;
+    }
+    slope = static_cast<double>(n * sumXY_ - sumX_ * sumY_) / static_cast<double>(varX);
+    return true;
+}
+
+double BatteryChargeTimeEstimator::Fit::GetRSquared() const
+{
+    double n = static_cast<double>(count_);
+    double varX = n * static_cast<double>(sumXX_) - static_cast<double>(sumX_) * static_cast<double>(sumX_);
+    double varY = n * static_cast<double>(sumYY_) - static_cast<double>(sumY_) * static_cast<double>(sumY_);
+    if (varX <= 0 || varY <= 0) {
+        return 0;
+    }
+    double cov = n * static_cast<double>(sumXY_) - static_cast<double>(sumX_) * static_cast<double>(sumY_);
+    return std::min(1.0, (cov * cov) / (varX * varY));
+}
+
+double BatteryChargeTimeEstimator::Fit::GetLastFitted() const
+{
+    double slope = 0;
+    if (!GetSlope(slope)) {
+        return (count_ == 0) ? 0 : static_cast<double>(ys_[(next_ + WINDOW - 1) % WINDOW]);
+    }
+    double n = static_cast<double>(count_);
+    double lastX = static_cast<double>(xs_[(next_ + WINDOW - 1) % WINDOW]);
+    return static_cast<double>(sumY_) / n + slope * (lastX - static_cast<double>(sumX_) / n);
+}
+
+void BatteryChargeTimeEstimator::Reset()
+{
+    isCharging_ = false;
+    pluggedType_ = BatteryPluggedType::PLUGGED_TYPE_NONE;
+    capacityFit_.Clear();
+    counterFit_.Clear();
+    estimate_ = {};
+}
+
+void BatteryChargeTimeEstimator::Update(int64_t timeMs, const BatteryInfo& info)
+{
+    int32_t capacity = info.GetCapacity();
+    int32_t chargeCounter = info.GetChargeCounter();
+    if (info.GetChargeState() != BatteryChargeState::CHARGE_STATE_ENABLE || capacity < 0 ||
+        capacity > static_cast<int32_t>(FULL_CAPACITY)) {
+        Reset();
+        return;
+    }
+    if (!isCharging_ || info.GetPluggedType() != pluggedType_ || timeMs < lastSampleMs_ || capacity < lastCapacity_) {
+        Reset();
+        isCharging_ = true;
+        pluggedType_ = info.GetPluggedType();
+        startMs_ = timeMs;
+    } else if (capacity == lastCapacity_ && chargeCounter == lastChargeCounter_ &&
+        timeMs - lastSampleMs_ < MIN_SAMPLE_INTERVAL_MS) {
+        return;
+    }
+    lastSampleMs_ = timeMs;
+    lastCapacity_ = capacity;
+    lastChargeCounter_ = chargeCounter;
+    int64_t x = (timeMs - startMs_) / MS_PER_SEC;
+    capacityFit_.Add(x, capacity);
+    if (chargeCounter > 0) {
+        counterFit_.Add(x, chargeCounter);
+    }
+    UpdateEstimate(capacity, chargeCounter);
+}
+
+void BatteryChargeTimeEstimator::UpdateEstimate(int32_t capacity, int32_t chargeCounter)
+{
+    const Fit* fit = nullptr;
+    double rate = 0;
+    double level = capacity;
+    double slope = 0;
+    if (capacity > 0 && chargeCounter > 0 && counterFit_.GetCount() >= MIN_COUNTER_SAMPLES &&
+        counterFit_.GetSlope(slope) && slope > 0) {
+        // counter units per second to percent per second, the full counter is chargeCounter * 100 / capacity
+        fit = &counterFit_;
+        rate = slope * capacity / chargeCounter;
+    } else if (capacityFit_.GetSlope(slope) && slope > 0) {
+        // the fitted line places the sample inside its 1% step
+        fit = &capacityFit_;
+        rate = slope;
+        level = std::clamp(capacityFit_.GetLastFitted(), level - FULL_MARGIN, level + FULL_MARGIN);
+    }
+    if (fit == nullptr) {
+        estimate_ = {};
+        return;
+    }
+    double sampleFactor = std::min(1.0, static_cast<double>(fit->GetCount()) / CONFIDENT_SAMPLES);
+    double spanFactor = std::min(1.0, static_cast<double>(fit->GetSpan()) / CONFIDENT_SPAN_SEC);
+    estimate_.remainingMs = GetRemainingMs(level, rate);
+    estimate_.confidence = static_cast<int32_t>(std::lround(PERCENT * fit->GetRSquared() * sampleFactor * spanFactor));
+}
+
+int64_t BatteryChargeTimeEstimator::GetRemainingMs(double capacity, double ratePerSec)
+{
+    constexpr double taper = TAPER_CAPACITY;
+    if (capacity >= FULL_CAPACITY - FULL_MARGIN) {
+        return 0;
+    }
+    double seconds = 0;
+    if (capacity < taper) {
+        // linear up to the taper, then an exponential approach starting at the same rate
+        double tau = (FULL_CAPACITY - taper) / ratePerSec;
+        seconds = (taper - capacity) / ratePerSec + tau * std::log((FULL_CAPACITY - taper) / FULL_MARGIN);
+    } else {
+        // in the taper the rate is proportional to the distance to full
+        double tau = (FULL_CAPACITY - capacity) / ratePerSec;
+        seconds = tau * std::log((FULL_CAPACITY - capacity) / FULL_MARGIN);
+    }
+    double ms = seconds * MS_PER_SEC;
+    return (ms >= static_cast<double>(MAX_REMAINING_MS)) ? MAX_REMAINING_MS : static_cast<int64_t>(ms);
+}
+} // namespace PowerMgr
+} // namespace OHOS
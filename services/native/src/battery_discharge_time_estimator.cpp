@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_discharge_time_estimator.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr double MS_PER_HOUR = 3600000.0;
+constexpr int64_t MAX_REMAINING_MS = 30 * 24 * 3600000LL;
+// below this drain rate in mA the remaining time is meaningless
+constexpr double MIN_DRAIN_RATE = 1.0;
+}
+
+void BatteryDischargeTimeEstimator::Reset()
+{
+    isDischarging_ = false;
+    drainRate_ = 0;
+    remainingMs_ = 0;
+}
+
+void BatteryDischargeTimeEstimator::Update(int64_t timeMs, const BatteryInfo& info)
+{
+    if (info.GetPluggedType() != BatteryPluggedType::PLUGGED_TYPE_NONE) {
+        Reset();
+        return;
+    }
+    int32_t nowCurrent = info.GetNowCurrent();
+    if (nowCurrent != INVALID_BATT_INT_VALUE) {
+        // the sign of the current while discharging differs between devices
+        double drain = std::abs(static_cast<double>(nowCurrent));
+        if (!isDischarging_ || timeMs < lastSampleMs_) {
+            isDischarging_ = true;
+            drainRate_ = drain;
+            lastSampleMs_ = timeMs;
+        } else if (timeMs > lastSampleMs_) {
+            double weight = 1.0 - std::exp(-static_cast<double>(timeMs - lastSampleMs_) / TIME_CONSTANT_MS);
+            drainRate_ += weight * (drain - drainRate_);
+            lastSampleMs_ = timeMs;
+        }
+    }
+    int32_t remainEnergy = info.GetRemainEnergy();
+    if (!isDischarging_ || remainEnergy <= 0 || drainRate_ < MIN_DRAIN_RATE) {
+        remainingMs_ = 0;
+        return;
+    }
+    // remaining energy in mAh over the drain rate in mA
+    double remainingMs = remainEnergy / drainRate_ * MS_PER_HOUR;
+    remainingMs_ = (remainingMs >= static_cast<double>(MAX_REMAINING_MS)) ?
+        MAX_REMAINING_MS : static_cast<int64_t>(remainingMs);
+}
+} // namespace PowerMgr
+} // namespace OHOS
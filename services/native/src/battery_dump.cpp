@@ -15,11 +15,13 @@
 
 #include "battery_dump.h"
 
+#include <cstdint>
 #include <ctime>
 #include <iosfwd>
 #include <cstdio>
 #include "battery_info.h"
 #include "battery_log.h"
+#include "battery_trace.h"
 
 namespace OHOS {
 namespace PowerMgr {
@@ -29,6 +31,8 @@ constexpr int32_t CAPACITY_DUMP_PARAM_SIZE = 2;
 constexpr int32_t CAPACITY_LIMIT_MIN = 0;
 constexpr int32_t CAPACITY_LIMIT_MAX = 100;
 constexpr int32_t UEVENT_DUMP_PARAM_SIZE = 2;
+constexpr size_t HISTORY_DUMP_PARAM_MAX = 3;
+constexpr int64_t SEC_MS = 1000;
 }
 
 void BatteryDump::DumpBatteryHelp(int32_t fd)
@@ -36,6 +40,16 @@ void BatteryDump::DumpBatteryHelp(int32_t fd)
     dprintf(fd, "Usage:\n");
     dprintf(fd, "      -h: dump help\n");
     dprintf(fd, "      -i: dump battery info\n");
+    dprintf(fd, "      --event: dump battery event pipeline statistics\n");
+    dprintf(fd, "      --startup: dump battery service startup phase timestamps\n");
+    dprintf(fd, "      --eventlog: dump the binary battery event log\n");
+    dprintf(fd, "      --history [from [to]]: dump battery history, from/to are seconds before now\n");
+    dprintf(fd, "      --sessions: dump the statistics of the last charge sessions\n");
+    dprintf(fd, "      --listeners: dump battery listener delivery counters\n");
+    dprintf(fd, "      --stats: dump ipc call counters and latency percentiles\n");
+    dprintf(fd, "      --stats-reset: reset ipc call counters and latency histograms\n");
+    dprintf(fd, "      --trace: dump battery event stage counters\n");
+    dprintf(fd, "      --trace-reset: reset battery event stage counters\n");
 #ifndef BATTERY_USER_VERSION
     dprintf(fd, "      -u: unplug battery charging state\n");
     dprintf(fd, "      -r: reset battery state\n");
@@ -61,50 +75,32 @@ void BatteryDump::DumpCurrentTime(int32_t fd)
 
 void BatteryDump::DumpBatteryInfo(sptr<BatteryService> &service, int32_t fd)
 {
-    int32_t capacity = 0;
-    service->GetCapacity(capacity);
-    dprintf(fd, "capacity: %d \n", capacity);
-    uint32_t batteryLevel = static_cast<uint32_t>(BatteryCapacityLevel::LEVEL_NONE);
-    service->GetCapacityLevel(batteryLevel);
-    dprintf(fd, "batteryLevel: %u \n", batteryLevel);
-    uint32_t chargingStatus = static_cast<uint32_t>(BatteryChargeState::CHARGE_STATE_NONE);
-    service->GetChargingStatus(chargingStatus);
-    dprintf(fd, "chargingStatus: %u \n", chargingStatus);
-    uint32_t healthState = static_cast<uint32_t>(BatteryHealthState::HEALTH_STATE_UNKNOWN);
-    service->GetHealthStatus(healthState);
-    dprintf(fd, "healthState: %u \n", healthState);
-    uint32_t pluggedType = static_cast<uint32_t>(BatteryPluggedType::PLUGGED_TYPE_NONE);
-    service->GetPluggedType(pluggedType);
-    dprintf(fd, "pluggedType: %u \n", pluggedType);
-    int32_t voltage = INVALID_BATT_INT_VALUE;
-    service->GetVoltage(voltage);
-    dprintf(fd, "voltage: %d \n", voltage);
-    bool present = false;
-    service->GetPresent(present);
-    dprintf(fd, "present: %d \n", present);
-    std::string technology;
-    service->GetTechnology(technology);
-    dprintf(fd, "technology: %s \n", technology.c_str());
-    int32_t nowCurrent = INVALID_BATT_INT_VALUE;
-    service->GetNowCurrent(nowCurrent);
-    dprintf(fd, "nowCurrent: %d \n", nowCurrent);
-    int32_t currentAverage = INVALID_BATT_INT_VALUE;
-    service->GetCurrentAverage(currentAverage);
-    dprintf(fd, "currentAverage: %d \n", currentAverage);
-    int32_t totalEnergy = INVALID_BATT_INT_VALUE;
-    service->GetTotalEnergy(totalEnergy);
-    dprintf(fd, "totalEnergy: %d \n", totalEnergy);
-    int32_t remainEnergy = INVALID_BATT_INT_VALUE;
-    service->GetRemainEnergy(remainEnergy);
-    dprintf(fd, "remainingEnergy: %d \n", remainEnergy);
-    int64_t remainingChargeTime = INVALID_REMAINING_CHARGE_TIME_VALUE;
-    service->GetRemainingChargeTime(remainingChargeTime);
-    dprintf(fd, "remainingChargeTime: %ld \n", remainingChargeTime);
-    int32_t temperature = INVALID_BATT_INT_VALUE;
-    service->GetBatteryTemperature(temperature);
-    dprintf(fd, "temperature: %d \n", temperature);
-    ChargeType chargeType = service->GetChargeType();
-    dprintf(fd, "chargeType: %u \n", chargeType);
+    BatteryInfoSnapshot snapshot;
+    int32_t batteryErr = static_cast<int32_t>(BatteryError::ERR_FAILURE);
+    service->GetBatteryInfoSnapshot(snapshot, batteryErr);
+    if (batteryErr != static_cast<int32_t>(BatteryError::ERR_OK)) {
+        dprintf(fd, "battery info is not ready, err: %d \n", batteryErr);
+        return;
+    }
+    const BatteryInfo& info = snapshot.GetInfo();
+    dprintf(fd, "capacity: %d \n", info.GetCapacity());
+    dprintf(fd, "batteryLevel: %u \n", snapshot.GetCapacityLevel());
+    dprintf(fd, "chargingStatus: %u \n", info.GetChargeState());
+    dprintf(fd, "healthState: %u \n", info.GetHealthState());
+    dprintf(fd, "pluggedType: %u \n", info.GetPluggedType());
+    dprintf(fd, "voltage: %d \n", info.GetVoltage());
+    dprintf(fd, "present: %d \n", info.IsPresent());
+    dprintf(fd, "technology: %s \n", info.GetTechnology().c_str());
+    dprintf(fd, "nowCurrent: %d \n", info.GetNowCurrent());
+    dprintf(fd, "currentAverage: %d \n", info.GetCurAverage());
+    dprintf(fd, "totalEnergy: %d \n", info.GetTotalEnergy());
+    dprintf(fd, "remainingEnergy: %d \n", info.GetRemainEnergy());
+    dprintf(fd, "remainingChargeTime: %ld \n", snapshot.GetRemainingChargeTime());
+    dprintf(fd, "remainingChargeTimeConfidence: %d \n", snapshot.GetRemainingChargeTimeConfidence());
+    dprintf(fd, "temperature: %d \n", info.GetTemperature());
+    dprintf(fd, "chargeType: %u \n", info.GetChargeType());
+    dprintf(fd, "sequence: %llu \n", static_cast<unsigned long long>(snapshot.GetSequence()));
+    dprintf(fd, "sampleTime: %lld \n", static_cast<long long>(snapshot.GetTimestamp()));
 }
 
 bool BatteryDump::GetBatteryInfo(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args)
@@ -188,5 +184,236 @@ bool BatteryDump::MockUevent(int32_t fd, sptr<BatteryService> &service, const st
 #endif
     return true;
 }
+
+void BatteryDump::DumpStageLatency(int32_t fd, const char* stage,
+    const BatteryEventPipeline::StageLatency& latency)
+{
+    uint64_t avgUs = (latency.count == 0) ? 0 : (latency.totalUs / latency.count);
+    dprintf(fd, "%s: count=%llu lastUs=%llu avgUs=%llu maxUs=%llu \n", stage,
+        static_cast<unsigned long long>(latency.count), static_cast<unsigned long long>(latency.lastUs),
+        static_cast<unsigned long long>(avgUs), static_cast<unsigned long long>(latency.maxUs));
+}
+
+bool BatteryDump::DumpEventStats(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args)
+{
+    if ((args.empty()) || (args[0].compare(u"--event") != 0)) {
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "args cannot be empty or invalid");
+        return false;
+    }
+    BatteryEventPipeline::Stats stats = service->GetEventStats();
+    dprintf(fd, "received: %llu \n", static_cast<unsigned long long>(stats.received));
+    dprintf(fd, "coalesced: %llu \n", static_cast<unsigned long long>(stats.coalesced));
+    dprintf(fd, "processed: %llu \n", static_cast<unsigned long long>(stats.processed));
+    dprintf(fd, "dropped: %llu \n", static_cast<unsigned long long>(stats.dropped));
+    dprintf(fd, "pending: %u \n", stats.pending);
+    dprintf(fd, "maxPending: %u \n", stats.maxPending);
+    dprintf(fd, "broadcastPosted: %llu \n", static_cast<unsigned long long>(stats.broadcastPosted));
+    dprintf(fd, "broadcastCoalesced: %llu \n", static_cast<unsigned long long>(stats.broadcastCoalesced));
+    dprintf(fd, "broadcastPending: %u \n", stats.broadcastPending);
+    DumpStageLatency(fd, "decision", stats.decision);
+    DumpStageLatency(fd, "broadcastWait", stats.broadcastWait);
+    DumpStageLatency(fd, "broadcastRun", stats.broadcastRun);
+    dprintf(fd, "hdiCalls: %llu \n", static_cast<unsigned long long>(service->GetHdiCallCount()));
+    BatteryNotify::ChangedEventStats changedStats = service->GetChangedEventStats();
+    dprintf(fd, "changedPublished: %llu \n", static_cast<unsigned long long>(changedStats.published));
+    dprintf(fd, "changedSuppressed: %llu \n", static_cast<unsigned long long>(changedStats.suppressed));
+    BatteryPermissionCache::Stats permissionStats = service->GetPermissionCacheStats();
+    dprintf(fd, "permissionHits: %llu \n", static_cast<unsigned long long>(permissionStats.hits));
+    dprintf(fd, "permissionMisses: %llu \n", static_cast<unsigned long long>(permissionStats.misses));
+    dprintf(fd, "permissionInvalidations: %llu \n", static_cast<unsigned long long>(permissionStats.invalidations));
+    dprintf(fd, "permissionCached: %u \n", permissionStats.size);
+    BatterySceneConfigCache::Stats sceneConfigStats = service->GetSceneConfigCacheStats();
+    dprintf(fd, "sceneConfigHits: %llu \n", static_cast<unsigned long long>(sceneConfigStats.hits));
+    dprintf(fd, "sceneConfigMisses: %llu \n", static_cast<unsigned long long>(sceneConfigStats.misses));
+    dprintf(fd, "sceneConfigValues: %u \n", sceneConfigStats.values);
+    dprintf(fd, "sceneConfigSupported: %u \n", sceneConfigStats.supported);
+    return true;
+}
+
+bool BatteryDump::DumpStartupStats(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args)
+{
+    if ((args.empty()) || (args[0].compare(u"--startup") != 0)) {
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "args cannot be empty or invalid");
+        return false;
+    }
+    const BatteryStartupStats& stats = service->GetStartupStats();
+    int64_t onStart = stats.GetTime(BatteryStartupStats::ON_START);
+    // times are ms since boot, the offset is relative to OnStart
+    for (uint32_t i = 0; i < BatteryStartupStats::PHASE_COUNT; i++) {
+        auto phase = static_cast<BatteryStartupStats::Phase>(i);
+        int64_t time = stats.GetTime(phase);
+        if (time == 0) {
+            dprintf(fd, "%s: not reached \n", BatteryStartupStats::GetName(phase));
+            continue;
+        }
+        dprintf(fd, "%s: %lld ms (+%lld ms) \n", BatteryStartupStats::GetName(phase),
+            static_cast<long long>(time), static_cast<long long>(time - onStart));
+    }
+    dprintf(fd, "hdiListenerRetries: %u \n", stats.GetHdiListenerRetries());
+    return true;
+}
+
+bool BatteryDump::DumpEventLog(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args)
+{
+    if ((args.empty()) || (args[0].compare(u"--eventlog") != 0)) {
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "args cannot be empty or invalid");
+        return false;
+    }
+    const BatteryEventLog& eventLog = service->GetEventLog();
+    std::vector<BatteryEventLog::Record> records = eventLog.GetRecords();
+    dprintf(fd, "total: %llu, level: %d \n", static_cast<unsigned long long>(eventLog.GetTotal()),
+        BatteryEventLog::GetLevel());
+    for (const auto& record : records) {
+        dprintf(fd, "#%llu %lld src=%u changed=0x%x capacity=%d voltage=%d temperature=%d health=%u plugged=%u "
+            "maxCurrent=%d maxVoltage=%d chargeState=%u counter=%d present=%u currNow=%d totalEnergy=%d "
+            "curAverage=%d remainEnergy=%d chargeType=%u event=%s \n",
+            static_cast<unsigned long long>(record.seq), static_cast<long long>(record.time), record.source,
+            record.changedFields, record.capacity, record.voltage, record.temperature, record.healthState,
+            record.pluggedType, record.pluggedMaxCurrent, record.pluggedMaxVoltage, record.chargeState,
+            record.chargeCounter, record.present, record.nowCurrent, record.totalEnergy, record.curAverage,
+            record.remainEnergy, record.chargeType, record.uevent);
+    }
+    return true;
+}
+
+bool BatteryDump::DumpHistory(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args)
+{
+    if ((args.empty()) || args.size() > HISTORY_DUMP_PARAM_MAX || (args[0].compare(u"--history") != 0)) {
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "args cannot be empty or invalid");
+        return false;
+    }
+    int32_t fromSec = -1;
+    int32_t toSec = 0;
+    if ((args.size() > 1 && (!StrToInt(Str16ToStr8(args[1]), fromSec) || fromSec < 0)) ||
+        (args.size() > 2 && (!StrToInt(Str16ToStr8(args[2]), toSec) || toSec < 0 || toSec > fromSec))) {
+        dprintf(fd, "history range is invalid\n");
+        return true;
+    }
+    timespec curTime = { 0, 0 };
+    clock_gettime(CLOCK_REALTIME, &curTime);
+    int64_t now = static_cast<int64_t>(curTime.tv_sec) * SEC_MS + curTime.tv_nsec / MS_NS;
+    int64_t begin = (fromSec < 0) ? INT64_MIN : now - fromSec * SEC_MS;
+    int64_t end = (args.size() > 2) ? now - toSec * SEC_MS : INT64_MAX;
+
+    const BatteryHistory& history = service->GetHistory();
+    BatteryHistory::Stats stats = history.GetStats();
+    dprintf(fd, "samples: %llu, blocks: %u, bytes: %u \n", static_cast<unsigned long long>(stats.samples),
+        stats.blocks, stats.bytes);
+    for (const auto& sample : history.GetSamples(begin, end)) {
+        time_t sec = static_cast<time_t>(sample.time / SEC_MS);
+        struct tm timeinfo {};
+        if (localtime_r(&sec, &timeinfo) == nullptr) {
+            continue;
+        }
+        // Add 1900 to the year, add 1 to the month.
+        dprintf(fd, "%04d-%02d-%02d %02d:%02d:%02d.%03d capacity=%d voltage=%d current=%d temperature=%d "
+            "chargeState=%d \n", timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday,
+            timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec, static_cast<int32_t>(sample.time % SEC_MS),
+            sample.capacity, sample.voltage, sample.current, sample.temperature, sample.chargeState);
+    }
+    return true;
+}
+
+bool BatteryDump::DumpChargeSessions(int32_t fd, sptr<BatteryService> &service,
+    const std::vector<std::u16string> &args)
+{
+    if ((args.empty()) || (args[0].compare(u"--sessions") != 0)) {
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "args cannot be empty or invalid");
+        return false;
+    }
+    for (const auto& session : service->GetChargeSessionStats().GetSessions()) {
+        time_t sec = static_cast<time_t>(session.startTime / SEC_MS);
+        struct tm timeinfo {};
+        if (localtime_r(&sec, &timeinfo) == nullptr) {
+            continue;
+        }
+        // Add 1900 to the year, add 1 to the month.
+        dprintf(fd, "%04d-%02d-%02d %02d:%02d:%02d %s duration=%llds pluggedType=%d capacity=%d->%d charge=%dmAh "
+            "energy=%dmWh current=%d/%dmA temperature=%d..%d \n", timeinfo.tm_year + 1900, timeinfo.tm_mon + 1,
+            timeinfo.tm_mday, timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec, session.active ? "active" : "ended",
+            static_cast<long long>(session.duration / SEC_MS), static_cast<int32_t>(session.pluggedType),
+            session.startCapacity, session.endCapacity, session.chargeDelivered, session.energyDelivered,
+            session.averageCurrent, session.peakCurrent, session.minTemperature, session.maxTemperature);
+        dprintf(fd, "    chargeTypeSeconds:");
+        for (int64_t time : session.chargeTypeTime) {
+            dprintf(fd, " %lld", static_cast<long long>(time / SEC_MS));
+        }
+        dprintf(fd, " \n");
+    }
+    return true;
+}
+
+bool BatteryDump::DumpListeners(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args)
+{
+    if ((args.empty()) || (args[0].compare(u"--listeners") != 0)) {
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "args cannot be empty or invalid");
+        return false;
+    }
+    BatteryListenerManager::Stats stats = service->GetListenerStats();
+    dprintf(fd, "listeners=%u notified=%llu coalesced=%llu delivered=%llu died=%llu \n", stats.listeners,
+        static_cast<unsigned long long>(stats.notified), static_cast<unsigned long long>(stats.coalesced),
+        static_cast<unsigned long long>(stats.delivered), static_cast<unsigned long long>(stats.died));
+    return true;
+}
+
+bool BatteryDump::DumpIpcStats(int32_t fd, sptr<BatteryService> &service, const std::vector<std::u16string> &args)
+{
+    if (args.empty()) {
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "args cannot be empty or invalid");
+        return false;
+    }
+    BatteryIpcStats& ipcStats = service->GetIpcStats();
+    if (args[0].compare(u"--stats-reset") == 0) {
+        ipcStats.Reset();
+        dprintf(fd, "ipc stats reset \n");
+        return true;
+    }
+    if (args[0].compare(u"--stats") != 0) {
+        return false;
+    }
+    for (const auto& method : ipcStats.GetMethodStats()) {
+        dprintf(fd, "%s: calls=%llu avgUs=%llu p50Us=%llu p99Us=%llu maxUs=%llu \n", method.name,
+            static_cast<unsigned long long>(method.calls),
+            static_cast<unsigned long long>(method.totalUs / method.calls),
+            static_cast<unsigned long long>(method.p50Us), static_cast<unsigned long long>(method.p99Us),
+            static_cast<unsigned long long>(method.maxUs));
+    }
+    for (const auto& uid : ipcStats.GetUidStats()) {
+        dprintf(fd, "uid %d: calls=%llu \n", uid.uid, static_cast<unsigned long long>(uid.calls));
+    }
+    dprintf(fd, "uid overflow: calls=%llu \n", static_cast<unsigned long long>(ipcStats.GetUidOverflow()));
+    return true;
+}
+
+bool BatteryDump::DumpTraceStats(int32_t fd, const std::vector<std::u16string> &args)
+{
+    if (args.empty()) {
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "args cannot be empty or invalid");
+        return false;
+    }
+    BatteryTrace& trace = BatteryTrace::GetInstance();
+    if (args[0].compare(u"--trace-reset") == 0) {
+        trace.Reset();
+        dprintf(fd, "trace stats reset \n");
+        return true;
+    }
+    if (args[0].compare(u"--trace") != 0) {
+        return false;
+    }
+    // the rate window is 10 s, the remainder is the first decimal
+    uint64_t recentEvents = trace.GetRecentEvents();
+    dprintf(fd, "events: %llu \n", static_cast<unsigned long long>(trace.GetEvents()));
+    dprintf(fd, "eventsPerSecond: %llu.%01llu \n",
+        static_cast<unsigned long long>(recentEvents / BatteryTrace::RATE_WINDOW_S),
+        static_cast<unsigned long long>(recentEvents % BatteryTrace::RATE_WINDOW_S));
+    dprintf(fd, "publishFailures: %llu \n", static_cast<unsigned long long>(trace.GetPublishFailures()));
+    for (const auto& stage : trace.GetStageStats()) {
+        uint64_t avgUs = (stage.count == 0) ? 0 : (stage.totalUs / stage.count);
+        dprintf(fd, "%s: count=%llu avgUs=%llu maxUs=%llu failures=%llu \n", stage.name,
+            static_cast<unsigned long long>(stage.count), static_cast<unsigned long long>(avgUs),
+            static_cast<unsigned long long>(stage.maxUs), static_cast<unsigned long long>(stage.failures));
+    }
+    return true;
+}
 }  // namespace PowerMgr
 }  // namespace OHOS
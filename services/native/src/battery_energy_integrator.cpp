@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_energy_integrator.h"
+
+#include <cmath>
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr double MA_MS_PER_UAH = 3600.0;
+constexpr double UV_MA_MS_PER_UWH = 3600.0 * 1000000.0;
+
+int32_t ValidOrZero(int32_t value)
+{
+    return (value == INVALID_BATT_INT_VALUE) ? 0 : value;
+}
+}
+
+BatteryEnergyIntegrator::Totals BatteryEnergyIntegrator::ExtendLocked(int64_t timeMs) const
+{
+    Totals totals = totals_;
+    if (!started_ || timeMs <= lastMs_) {
+        return totals;
+    }
+    double interval = static_cast<double>(timeMs - lastMs_);
+    double charge = std::fabs(static_cast<double>(lastCurrent_)) * interval;
+    double energy = charge * lastVoltage_;
+    if (lastCurrent_ > 0) {
+        totals.chargeIn += charge;
+        totals.energyIn += energy;
+    } else {
+        totals.chargeOut += charge;
+        totals.energyOut += energy;
+    }
+    return totals;
+}
+
+void BatteryEnergyIntegrator::Update(int64_t timeMs, const BatteryInfo& info)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    totals_ = ExtendLocked(timeMs);
+    if (!started_ || timeMs > lastMs_) {
+        lastMs_ = timeMs;
+    }
+    started_ = true;
+    lastCurrent_ = ValidOrZero(info.GetNowCurrent());
+    lastVoltage_ = ValidOrZero(info.GetVoltage());
+    sampleCount_++;
+}
+
+BatteryEnergyIntegrator::Counters BatteryEnergyIntegrator::GetCounters(int64_t timeMs) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Totals totals = ExtendLocked(timeMs);
+    Counters counters;
+    counters.time = (started_ && timeMs > lastMs_) ? timeMs : lastMs_;
+    counters.sampleCount = sampleCount_;
+    counters.chargeIn = static_cast<int64_t>(totals.chargeIn / MA_MS_PER_UAH);
+    counters.chargeOut = static_cast<int64_t>(totals.chargeOut / MA_MS_PER_UAH);
+    counters.energyIn = static_cast<int64_t>(totals.energyIn / UV_MA_MS_PER_UWH);
+    counters.energyOut = static_cast<int64_t>(totals.energyOut / UV_MA_MS_PER_UWH);
+    return counters;
+}
+} // namespace PowerMgr
+} // namespace OHOS
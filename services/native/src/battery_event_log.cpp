@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_event_log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <parameter.h>
+#include <parameters.h>
+#include <string>
+
+#include "battery_log.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+const char* LOG_LEVEL_PARAM = "persist.battery.log_level";
+
+int64_t GetTickMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void OnLevelChanged(const char* key, const char* value, void* context)
+{
+    (void)key;
+    (void)context;
+    if (value == nullptr) {
+        return;
+    }
+    BatteryEventLog::SetLevel(static_cast<int32_t>(strtol(value, nullptr, 0)));
+}
+}
+
+std::atomic<int32_t> BatteryEventLog::level_ { BatteryEventLog::LEVEL_LIMITED };
+
+void BatteryEventLog::Append(Source source, const BatteryInfo& info, uint32_t changedFields)
+{
+    uint64_t seq = next_.fetch_add(1, std::memory_order_relaxed) + 1;
+    Slot& slot = slots_[seq % CAPACITY];
+    slot.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Record& record = slot.record;
+    record.seq = seq;
+    record.time = GetTickMs();
+    record.changedFields = changedFields;
+    record.capacity = info.GetCapacity();
+    record.voltage = info.GetVoltage();
+    record.temperature = info.GetTemperature();
+    record.nowCurrent = info.GetNowCurrent();
+    record.curAverage = info.GetCurAverage();
+    record.totalEnergy = info.GetTotalEnergy();
+    record.remainEnergy = info.GetRemainEnergy();
+    record.chargeCounter = info.GetChargeCounter();
+    record.pluggedMaxCurrent = info.GetPluggedMaxCurrent();
+    record.pluggedMaxVoltage = info.GetPluggedMaxVoltage();
+    record.source = static_cast<uint8_t>(source);
+    record.healthState = static_cast<uint8_t>(info.GetHealthState());
+    record.pluggedType = static_cast<uint8_t>(info.GetPluggedType());
+    record.chargeState = static_cast<uint8_t>(info.GetChargeState());
+    record.chargeType = static_cast<uint8_t>(info.GetChargeType());
+    record.present = info.IsPresent() ? 1 : 0;
+    const std::string& uevent = info.GetUevent();
+    size_t len = std::min(uevent.size(), static_cast<size_t>(UEVENT_LEN - 1));
+    uevent.copy(record.uevent, len);
+    record.uevent[len] = '\0';
+
+    slot.seq.store(seq, std::memory_order_release);
+}
+
+std::vector<BatteryEventLog::Record> BatteryEventLog::GetRecords() const
+{
+    std::vector<Record> records;
+    uint64_t last = next_.load(std::memory_order_acquire);
+    uint64_t first = (last > CAPACITY) ? (last - CAPACITY + 1) : 1;
+    records.reserve(last - first + 1);
+    for (uint64_t seq = first; seq <= last; seq++) {
+        const Slot& slot = slots_[seq % CAPACITY];
+        if (slot.seq.load(std::memory_order_acquire) != seq) {
+            continue;
+        }
+        Record record = slot.record;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq) {
+            continue;
+        }
+        records.push_back(record);
+    }
+    return records;
+}
+
+uint64_t BatteryEventLog::GetTotal() const
+{
+    return next_.load(std::memory_order_relaxed);
+}
+
+int32_t BatteryEventLog::GetLevel()
+{
+    return level_.load(std::memory_order_relaxed);
+}
+
+void BatteryEventLog::SetLevel(int32_t level)
+{
+    if (level < LEVEL_BINARY || level > LEVEL_FULL) {
+        BATTERY_HILOGW(COMP_SVC, "invalid battery log level %{public}d", level);
+        return;
+    }
+    level_.store(level, std::memory_order_relaxed);
+}
+
+void BatteryEventLog::WatchLevel()
+{
+    static std::atomic_bool isWatching { false };
+    SetLevel(OHOS::system::GetIntParameter(LOG_LEVEL_PARAM, static_cast<int32_t>(LEVEL_LIMITED)));
+    if (isWatching.exchange(true)) {
+        return;
+    }
+    int32_t ret = WatchParameter(LOG_LEVEL_PARAM, OnLevelChanged, nullptr);
+    if (ret != 0) {
+        isWatching.store(false);
+        BATTERY_HILOGW(COMP_SVC, "watch %{public}s failed, ret=%{public}d", LOG_LEVEL_PARAM, ret);
+    }
+}
+
+bool BatteryLogLimiter::Allow(uint32_t& suppressed)
+{
+    suppressed = 0;
+    int32_t level = BatteryEventLog::GetLevel();
+    if (level == BatteryEventLog::LEVEL_BINARY) {
+        return false;
+    }
+    if (level != BatteryEventLog::LEVEL_FULL) {
+        int64_t now = GetTickMs();
+        int64_t start = windowStart_.load(std::memory_order_relaxed);
+        if ((now - start >= WINDOW_MS) &&
+            windowStart_.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+            count_.store(0, std::memory_order_relaxed);
+        }
+        if (count_.fetch_add(1, std::memory_order_relaxed) >= BURST) {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+} // namespace PowerMgr
+} // namespace OHOS
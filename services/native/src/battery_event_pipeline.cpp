@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_event_pipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include "battery_info.h"
+#include "battery_log.h"
+#include "ffrt_utils.h"
+
+using namespace OHOS::HDI::Battery;
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+const std::string POWER_SUPPLY = "SUBSYSTEM=power_supply";
+}
+
+BatteryEventPipeline::BatteryEventPipeline(const EventHandler& handler, const BroadcastHandler& broadcastHandler)
+    : handler_(handler),
+      broadcastHandler_(broadcastHandler),
+      queue_(std::make_shared<ffrt::queue>("battery_event_pipeline",
+          ffrt::queue_attr().qos(ffrt::qos_user_initiated))),
+      broadcastQueue_(std::make_shared<ffrt::queue>("battery_event_broadcast",
+          ffrt::queue_attr().qos(ffrt::qos_utility)))
+{
+}
+
+int64_t BatteryEventPipeline::GetTickUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void BatteryEventPipeline::LatencyRecorder::Record(int64_t latencyUs)
+{
+    uint64_t latency = static_cast<uint64_t>(std::max<int64_t>(latencyUs, 0));
+    lastUs_.store(latency, std::memory_order_relaxed);
+    totalUs_.fetch_add(latency, std::memory_order_relaxed);
+    uint64_t maxUs = maxUs_.load(std::memory_order_relaxed);
+    while (latency > maxUs && !maxUs_.compare_exchange_weak(maxUs, latency, std::memory_order_relaxed)) {
+    }
+    count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+BatteryEventPipeline::StageLatency BatteryEventPipeline::LatencyRecorder::Load() const
+{
+    StageLatency latency;
+    latency.count = count_.load(std::memory_order_relaxed);
+    latency.lastUs = lastUs_.load(std::memory_order_relaxed);
+    latency.maxUs = maxUs_.load(std::memory_order_relaxed);
+    latency.totalUs = totalUs_.load(std::memory_order_relaxed);
+    return latency;
+}
+
+bool BatteryEventPipeline::IsCoalescable(const V2_0::BatteryInfo& event)
+{
+    return event.uevent.empty() || event.uevent == POWER_SUPPLY || event.uevent == INVALID_STRING_VALUE;
+}
+
+void BatteryEventPipeline::Push(const V2_0::BatteryInfo& event)
+{
+    received_++;
+    bool needDrain = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t last = (head_ + count_ + CAPACITY - 1) % CAPACITY;
+        if (count_ > 0 && IsCoalescable(event) && IsCoalescable(ring_[last])) {
+            // every sample carries the full battery state, the newer one supersedes the pending one,
+            // the push time of the pending one is kept so the decision latency covers the whole wait
+            ring_[last] = event;
+            coalesced_++;
+        } else {
+            if (count_ == CAPACITY) {
+                DropOldest();
+            }
+            ring_[(head_ + count_) % CAPACITY] = event;
+            pushTime_[(head_ + count_) % CAPACITY] = GetTickUs();
+            count_++;
+            maxPending_ = std::max(maxPending_, count_);
+        }
+        if (!draining_) {
+            draining_ = true;
+            needDrain = true;
+        }
+    }
+    if (needDrain) {
+        queue_->submit([this] { Drain(); });
+    }
+}
+
+void BatteryEventPipeline::DropOldest()
+{
+    uint32_t victim = 0;
+    while (victim < count_ && !IsCoalescable(ring_[(head_ + victim) % CAPACITY])) {
+        victim++;
+    }
+    if (victim < count_) {
+        coalesced_++;
+    } else {
+        victim = 0;
+        dropped_++;
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "event ring is full, drop uevent %{public}s",
+            ring_[head_].uevent.c_str());
+    }
+    for (uint32_t i = victim; i + 1 < count_; i++) {
+        ring_[(head_ + i) % CAPACITY] = std::move(ring_[(head_ + i + 1) % CAPACITY]);
+        pushTime_[(head_ + i) % CAPACITY] = pushTime_[(head_ + i + 1) % CAPACITY];
+    }
+    count_--;
+}
+
+bool BatteryEventPipeline::PopFront(V2_0::BatteryInfo& event, int64_t& pushTime)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (count_ == 0) {
+        draining_ = false;
+        return false;
+    }
+    event = std::move(ring_[head_]);
+    pushTime = pushTime_[head_];
+    head_ = (head_ + 1) % CAPACITY;
+    count_--;
+    return true;
+}
+
+void BatteryEventPipeline::Drain()
+{
+    V2_0::BatteryInfo event;
+    int64_t pushTime = 0;
+    while (PopFront(event, pushTime)) {
+        if (handler_) {
+            handler_(event);
+        }
+        decision_.Record(GetTickUs() - pushTime);
+        processed_++;
+    }
+}
+
+void BatteryEventPipeline::PostBroadcast(const BatteryInfo& info, uint32_t changedFields)
+{
+    {
+        std::lock_guard<std::mutex> lock(broadcastMutex_);
+        broadcastInfo_ = info;
+        if (broadcastScheduled_) {
+            // the waiting task publishes the latest info with every field changed since the last run,
+            // the post time of the first post is kept so the wait covers the whole stall
+            broadcastFields_ |= changedFields;
+            broadcastCoalesced_++;
+            return;
+        }
+        broadcastFields_ = changedFields;
+        broadcastPostTime_ = GetTickUs();
+        broadcastScheduled_ = true;
+        broadcastPosted_++;
+    }
+    broadcastQueue_->submit([this] { RunBroadcast(); });
+}
+
+void BatteryEventPipeline::RunBroadcast()
+{
+    BatteryInfo info;
+    uint32_t changedFields = 0;
+    int64_t postTime = 0;
+    {
+        std::lock_guard<std::mutex> lock(broadcastMutex_);
+        info = std::move(broadcastInfo_);
+        changedFields = broadcastFields_;
+        postTime = broadcastPostTime_;
+        broadcastFields_ = 0;
+        broadcastScheduled_ = false;
+    }
+    int64_t startTime = GetTickUs();
+    broadcastWait_.Record(startTime - postTime);
+    if (broadcastHandler_) {
+        broadcastHandler_(info, changedFields);
+    }
+    broadcastRun_.Record(GetTickUs() - startTime);
+}
+
+BatteryEventPipeline::Stats BatteryEventPipeline::GetStats()
+{
+    Stats stats;
+    stats.received = received_.load();
+    stats.coalesced = coalesced_.load();
+    stats.processed = processed_.load();
+    stats.dropped = dropped_.load();
+    stats.decision = decision_.Load();
+    stats.broadcastWait = broadcastWait_.Load();
+    stats.broadcastRun = broadcastRun_.Load();
+    {
+        std::lock_guard<std::mutex> lock(broadcastMutex_);
+        stats.broadcastPosted = broadcastPosted_;
+        stats.broadcastCoalesced = broadcastCoalesced_;
+        stats.broadcastPending = broadcastScheduled_ ? 1 : 0;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.pending = count_;
+    stats.maxPending = maxPending_;
+    return stats;
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_history.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr uint32_t VARINT_SHIFT = 7;
+constexpr uint8_t VARINT_MASK = 0x7F;
+constexpr uint8_t VARINT_MORE = 0x80;
+constexpr uint32_t VARINT_MAX_SHIFT = 63;
+
+uint32_t PutVarint(uint8_t* out, uint64_t value)
+{
+    uint32_t size = 0;
+    while (value > VARINT_MASK) {
+        out[size++] = static_cast<uint8_t>(value & VARINT_MASK) | VARINT_MORE;
+        value >>= VARINT_SHIFT;
+    }
+    out[size++] = static_cast<uint8_t>(value);
+    return size;
+}
+
+bool GetVarint(const uint8_t* data, uint32_t size, uint32_t& pos, uint64_t& value)
+{
+    value = 0;
+    for (uint32_t shift = 0; pos < size && shift <= VARINT_MAX_SHIFT; shift += VARINT_SHIFT) {
+        uint8_t byte = data[pos++];
+        value |= static_cast<uint64_t>(byte & VARINT_MASK) << shift;
+        if ((byte & VARINT_MORE) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t ZigZag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> VARINT_MAX_SHIFT);
+}
+
+int64_t UnZigZag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+}
+
+void BatteryHistory::StartBlock(const Sample& sample)
+{
+    if (hasLast_) {
+        current_ = (current_ + 1) % BLOCK_COUNT;
+    }
+    Block& block = blocks_[current_];
+    block.generation.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    block.used.store(0, std::memory_order_relaxed);
+    block.seq.store(nextSeq_++, std::memory_order_relaxed);
+    Write(sample, Sample {}, true);
+    block.generation.fetch_add(1, std::memory_order_release);
+}
+
+void BatteryHistory::Write(const Sample& sample, const Sample& base, bool isKeyframe)
+{
+    Block& block = blocks_[current_];
+    uint32_t used = block.used.load(std::memory_order_relaxed);
+    uint8_t* out = block.data.data() + used;
+    uint32_t size = 0;
+    size += PutVarint(out + size, isKeyframe ? ZigZag(sample.time) : static_cast<uint64_t>(sample.time - base.time));
+    size += PutVarint(out + size, ZigZag(static_cast<int64_t>(sample.capacity) - base.capacity));
+    size += PutVarint(out + size, ZigZag(static_cast<int64_t>(sample.voltage) - base.voltage));
+    size += PutVarint(out + size, ZigZag(static_cast<int64_t>(sample.current) - base.current));
+    size += PutVarint(out + size, ZigZag(static_cast<int64_t>(sample.temperature) - base.temperature));
+    size += PutVarint(out + size, ZigZag(static_cast<int64_t>(sample.chargeState) - base.chargeState));
+    block.used.store(used + size, std::memory_order_release);
+    last_ = sample;
+    hasLast_ = true;
+}
+
+void BatteryHistory::Append(const Sample& sample)
+{
+    samples_.fetch_add(1, std::memory_order_relaxed);
+    // a clock set backwards restarts the block, deltas in a block are never negative in time
+    if (!hasLast_ || sample.time < last_.time ||
+        blocks_[current_].used.load(std::memory_order_relaxed) + MAX_SAMPLE_SIZE > BLOCK_SIZE) {
+        StartBlock(sample);
+        return;
+    }
+    Write(sample, last_, false);
+}
+
+void BatteryHistory::DecodeBlock(const uint8_t* data, uint32_t size, int64_t begin, int64_t end,
+    std::vector<Sample>& samples)
+{
+    uint32_t pos = 0;
+    Sample last;
+    bool isKeyframe = true;
+    uint64_t values[FIELD_COUNT + 1] = { 0 };
+    while (pos < size) {
+        for (auto& value : values) {
+            if (!GetVarint(data, size, pos, value)) {
+                return;
+            }
+        }
+        Sample sample;
+        uint32_t index = 0;
+        sample.time = isKeyframe ? UnZigZag(values[index++]) : last.time + static_cast<int64_t>(values[index++]);
+        sample.capacity = static_cast<int32_t>(last.capacity + UnZigZag(values[index++]));
+        sample.voltage = static_cast<int32_t>(last.voltage + UnZigZag(values[index++]));
+        sample.current = static_cast<int32_t>(last.current + UnZigZag(values[index++]));
+        sample.temperature = static_cast<int32_t>(last.temperature + UnZigZag(values[index++]));
+        sample.chargeState = static_cast<int32_t>(last.chargeState + UnZigZag(values[index++]));
+        if (sample.time >= begin && sample.time <= end) {
+            samples.push_back(sample);
+        }
+        last = sample;
+        isKeyframe = false;
+    }
+}
+
+std::vector<BatteryHistory::Sample> BatteryHistory::GetSamples(int64_t begin, int64_t end) const
+{
+    std::vector<std::pair<uint64_t, uint32_t>> order;
+    for (uint32_t i = 0; i < BLOCK_COUNT; i++) {
+        uint64_t seq = blocks_[i].seq.load(std::memory_order_relaxed);
+        if (seq != 0) {
+            order.emplace_back(seq, i);
+        }
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<Sample> samples;
+    std::array<uint8_t, BLOCK_SIZE> copy {};
+    for (const auto& [seq, index] : order) {
+        const Block& block = blocks_[index];
+        uint64_t generation = block.generation.load(std::memory_order_acquire);
+        if ((generation & 1) != 0 || block.seq.load(std::memory_order_relaxed) != seq) {
+            continue;
+        }
+        uint32_t used = std::min(block.used.load(std::memory_order_acquire), BLOCK_SIZE);
+        std::copy(block.data.begin(), block.data.begin() + used, copy.begin());
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (block.generation.load(std::memory_order_relaxed) != generation) {
+            continue;
+        }
+        DecodeBlock(copy.data(), used, begin, end, samples);
+    }
+    return samples;
+}
+
+BatteryHistory::Stats BatteryHistory::GetStats() const
+{
+    Stats stats;
+    stats.samples = samples_.load(std::memory_order_relaxed);
+    for (const auto& block : blocks_) {
+        if (block.seq.load(std::memory_order_relaxed) != 0) {
+            stats.blocks++;
+            stats.bytes += block.used.load(std::memory_order_relaxed);
+        }
+    }
+    return stats;
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_ipc_stats.h"
+
+#include <algorithm>
+
+#include "ibattery_srv.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr uint32_t PERCENT_50 = 50;
+constexpr uint32_t PERCENT_99 = 99;
+constexpr uint32_t PERCENT_ALL = 100;
+struct MethodName {
+    IBatterySrvIpcCode code;
+    const char* name;
+};
+const MethodName METHOD_NAMES[] = {
+    { IBatterySrvIpcCode::COMMAND_GET_CAPACITY, "GetCapacity" },
+    { IBatterySrvIpcCode::COMMAND_GET_CHARGING_STATUS, "GetChargingStatus" },
+    { IBatterySrvIpcCode::COMMAND_GET_HEALTH_STATUS, "GetHealthStatus" },
+    { IBatterySrvIpcCode::COMMAND_GET_PLUGGED_TYPE, "GetPluggedType" },
+    { IBatterySrvIpcCode::COMMAND_GET_VOLTAGE, "GetVoltage" },
+    { IBatterySrvIpcCode::COMMAND_GET_PRESENT, "GetPresent" },
+    { IBatterySrvIpcCode::COMMAND_GET_BATTERY_TEMPERATURE, "GetBatteryTemperature" },
+    { IBatterySrvIpcCode::COMMAND_GET_TECHNOLOGY, "GetTechnology" },
+    { IBatterySrvIpcCode::COMMAND_GET_CAPACITY_LEVEL, "GetCapacityLevel" },
+    { IBatterySrvIpcCode::COMMAND_GET_REMAINING_CHARGE_TIME, "GetRemainingChargeTime" },
+    { IBatterySrvIpcCode::COMMAND_GET_TOTAL_ENERGY, "GetTotalEnergy" },
+    { IBatterySrvIpcCode::COMMAND_GET_CURRENT_AVERAGE, "GetCurrentAverage" },
+    { IBatterySrvIpcCode::COMMAND_GET_NOW_CURRENT, "GetNowCurrent" },
+    { IBatterySrvIpcCode::COMMAND_GET_REMAIN_ENERGY, "GetRemainEnergy" },
+    { IBatterySrvIpcCode::COMMAND_SET_BATTERY_CONFIG, "SetBatteryConfig" },
+    { IBatterySrvIpcCode::COMMAND_GET_BATTERY_CONFIG, "GetBatteryConfig" },
+    { IBatterySrvIpcCode::COMMAND_IS_BATTERY_CONFIG_SUPPORTED, "IsBatteryConfigSupported" },
+    { IBatterySrvIpcCode::COMMAND_GET_BATTERY_INFO_SNAPSHOT, "GetBatteryInfoSnapshot" },
+    { IBatterySrvIpcCode::COMMAND_SET_BATTERY_CONFIGS, "SetBatteryConfigs" },
+    { IBatterySrvIpcCode::COMMAND_GET_BATTERY_CONFIGS, "GetBatteryConfigs" },
+    { IBatterySrvIpcCode::COMMAND_GET_BATTERY_STATS, "GetBatteryStats" },
+    { IBatterySrvIpcCode::COMMAND_GET_REMAINING_DISCHARGE_TIME, "GetRemainingDischargeTime" },
+    { IBatterySrvIpcCode::COMMAND_GET_CHARGE_SESSIONS, "GetChargeSessions" },
+    { IBatterySrvIpcCode::COMMAND_GET_ENERGY_COUNTERS, "GetEnergyCounters" },
+    { IBatterySrvIpcCode::COMMAND_REGISTER_BATTERY_LISTENER, "RegisterBatteryListener" },
+    { IBatterySrvIpcCode::COMMAND_UNREGISTER_BATTERY_LISTENER, "UnregisterBatteryListener" },
+};
+}
+
+const char* BatteryIpcStats::GetMethodName(uint32_t code)
+{
+    for (const auto& method : METHOD_NAMES) {
+        if (static_cast<uint32_t>(method.code) == code) {
+            return method.name;
+        }
+    }
+    return "Unknown";
+}
+
+uint32_t BatteryIpcStats::GetBucket(uint64_t latencyUs)
+{
+    // bucket 0 holds [0, 2) us, bucket i holds [2^i, 2^(i+1)) us, the last one is open ended
+    uint32_t bucket = 0;
+    while ((latencyUs >>= 1) != 0 && bucket < BUCKETS - 1) {
+        bucket++;
+    }
+    return bucket;
+}
+
+void BatteryIpcStats::Record(uint32_t code, int32_t uid, int64_t latencyUs)
+{
+    uint64_t latency = (latencyUs > 0) ? static_cast<uint64_t>(latencyUs) : 0;
+    Method& method = methods_[std::min(code, MAX_METHODS)];
+    method.calls.fetch_add(1, std::memory_order_relaxed);
+    method.totalUs.fetch_add(latency, std::memory_order_relaxed);
+    method.buckets[GetBucket(latency)].fetch_add(1, std::memory_order_relaxed);
+    uint64_t maxUs = method.maxUs.load(std::memory_order_relaxed);
+    while (latency > maxUs && !method.maxUs.compare_exchange_weak(maxUs, latency, std::memory_order_relaxed)) {
+    }
+    RecordUid(uid);
+}
+
+void BatteryIpcStats::RecordUid(int32_t uid)
+{
+    if (uid < 0) {
+        uidOverflow_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    uint32_t start = static_cast<uint32_t>(uid) % MAX_UIDS;
+    for (uint32_t i = 0; i < MAX_UIDS; i++) {
+        Uid& entry = uids_[(start + i) % MAX_UIDS];
+        int32_t current = entry.uid.load(std::memory_order_relaxed);
+        if (current == Uid::EMPTY &&
+            entry.uid.compare_exchange_strong(current, uid, std::memory_order_relaxed)) {
+            current = uid;
+        }
+        if (current == uid) {
+            entry.calls.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    uidOverflow_.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t BatteryIpcStats::GetPercentile(const std::array<uint64_t, BUCKETS>& buckets, uint64_t calls,
+    uint32_t percent)
+{
+    uint64_t rank = (calls * percent + PERCENT_ALL - 1) / PERCENT_ALL;
+    uint64_t count = 0;
+    for (uint32_t i = 0; i < BUCKETS; i++) {
+        count += buckets[i];
+        if (count >= rank) {
+            return (static_cast<uint64_t>(1) << (i + 1)) - 1;
+        }
+    }
+    return (static_cast<uint64_t>(1) << BUCKETS) - 1;
+}
+
+std::vector<BatteryIpcStats::MethodStats> BatteryIpcStats::GetMethodStats() const
+{
+    std::vector<MethodStats> result;
+    for (uint32_t code = 0; code <= MAX_METHODS; code++) {
+        const Method& method = methods_[code];
+        uint64_t calls = method.calls.load(std::memory_order_relaxed);
+        if (calls == 0) {
+            continue;
+        }
+        std::array<uint64_t, BUCKETS> buckets {};
+        uint64_t bucketCalls = 0;
+        for (uint32_t i = 0; i < BUCKETS; i++) {
+            buckets[i] = method.buckets[i].load(std::memory_order_relaxed);
+            bucketCalls += buckets[i];
+        }
+        MethodStats stats;
+        stats.code = code;
+        stats.name = (code == MAX_METHODS) ? "Other" : GetMethodName(code);
+        stats.calls = calls;
+        stats.totalUs = method.totalUs.load(std::memory_order_relaxed);
+        stats.maxUs = method.maxUs.load(std::memory_order_relaxed);
+        // the buckets are read after calls, concurrent records can make them differ slightly
+        stats.p50Us = GetPercentile(buckets, bucketCalls, PERCENT_50);
+        stats.p99Us = GetPercentile(buckets, bucketCalls, PERCENT_99);
+        result.push_back(stats);
+    }
+    return result;
+}
+
+std::vector<BatteryIpcStats::UidStats> BatteryIpcStats::GetUidStats() const
+{
+    std::vector<UidStats> result;
+    for (const auto& entry : uids_) {
+        int32_t uid = entry.uid.load(std::memory_order_relaxed);
+        uint64_t calls = entry.calls.load(std::memory_order_relaxed);
+        if (uid != Uid::EMPTY && calls != 0) {
+            result.push_back({ uid, calls });
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const UidStats& lhs, const UidStats& rhs) {
+        return lhs.calls > rhs.calls;
+    });
+    return result;
+}
+
+uint64_t BatteryIpcStats::GetUidOverflow() const
+{
+    return uidOverflow_.load(std::memory_order_relaxed);
+}
+
+void BatteryIpcStats::Reset()
+{
+    // uids keep their slot so a concurrent RecordUid never sees a half cleared entry
+    for (auto& method : methods_) {
+        method.calls.store(0, std::memory_order_relaxed);
+        method.totalUs.store(0, std::memory_order_relaxed);
+        method.maxUs.store(0, std::memory_order_relaxed);
+        for (auto& bucket : method.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (auto& entry : uids_) {
+        entry.calls.store(0, std::memory_order_relaxed);
+    }
+    uidOverflow_.store(0, std::memory_order_relaxed);
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_journal.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "battery_log.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr mode_t JOURNAL_FILE_MODE = 0640;
+}
+
+BatteryJournal::~BatteryJournal()
+{
+    Close();
+}
+
+bool BatteryJournal::Map(int32_t fd, size_t size)
+{
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        BATTERY_HILOGE(COMP_SVC, "mmap battery journal failed, errno=%{public}d", errno);
+        return false;
+    }
+    base_ = static_cast<uint8_t*>(base);
+    size_ = size;
+    return true;
+}
+
+bool BatteryJournal::Open(const std::string& path, uint32_t capacity)
+{
+    Close();
+    std::lock_guard<std::mutex> lock(syncMutex_);
+    int32_t fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, JOURNAL_FILE_MODE);
+    if (fd < 0) {
+        BATTERY_HILOGE(COMP_SVC, "open battery journal failed, errno=%{public}d", errno);
+        return false;
+    }
+    struct stat st {};
+    bool isReady = false;
+    if (fstat(fd, &st) == 0 && st.st_size >= static_cast<off_t>(sizeof(BatteryJournalFormat::Header)) &&
+        Map(fd, static_cast<size_t>(st.st_size))) {
+        auto header = reinterpret_cast<BatteryJournalFormat::Header*>(base_);
+        if (BatteryJournalFormat::IsValidHeader(*header, size_) && header->capacity == capacity) {
+            isReady = true;
+        } else {
+            BATTERY_HILOGW(COMP_SVC, "battery journal header mismatch, recreate it");
+            munmap(base_, size_);
+            base_ = nullptr;
+            size_ = 0;
+        }
+    }
+    if (!isReady) {
+        // A fresh sparse file, the record slots read as zero and fail the crc check
+        size_t size = BatteryJournalFormat::HEADER_SIZE + static_cast<size_t>(capacity) *
+            sizeof(BatteryJournalFormat::Record);
+        if (ftruncate(fd, 0) != 0 || ftruncate(fd, static_cast<off_t>(size)) != 0 || !Map(fd, size)) {
+            BATTERY_HILOGE(COMP_SVC, "create battery journal failed, errno=%{public}d", errno);
+            close(fd);
+            return false;
+        }
+        auto header = reinterpret_cast<BatteryJournalFormat::Header*>(base_);
+        header->magic = BatteryJournalFormat::MAGIC;
+        header->version = BatteryJournalFormat::VERSION;
+        header->recordSize = sizeof(BatteryJournalFormat::Record);
+        header->capacity = capacity;
+        header->nextSeq = 1;
+    }
+    // kept open for Flush, fdatasync writes back the pages dirtied through the shared mapping
+    fd_ = fd;
+    auto header = reinterpret_cast<BatteryJournalFormat::Header*>(base_);
+    nextSeq_ = BatteryJournalFormat::RecoverNextSeq(base_, *header);
+    header->nextSeq = nextSeq_;
+    BATTERY_HILOGI(COMP_SVC, "battery journal opened, nextSeq=%{public}llu",
+        static_cast<unsigned long long>(nextSeq_));
+    return true;
+}
+
+void BatteryJournal::Close()
+{
+    std::lock_guard<std::mutex> lock(syncMutex_);
+    if (base_ == nullptr) {
+        return;
+    }
+    if (fdatasync(fd_) != 0) {
+        BATTERY_HILOGW(COMP_SVC, "sync battery journal failed, errno=%{public}d", errno);
+    }
+    munmap(base_, size_);
+    close(fd_);
+    fd_ = -1;
+    base_ = nullptr;
+    size_ = 0;
+}
+
+bool BatteryJournal::Flush()
+{
+    std::lock_guard<std::mutex> lock(syncMutex_);
+    if (fd_ < 0) {
+        return false;
+    }
+    if (fdatasync(fd_) != 0) {
+        BATTERY_HILOGW(COMP_SVC, "sync battery journal failed, errno=%{public}d", errno);
+    }
+    return true;
+}
+
+void BatteryJournal::Append(int64_t time, const BatteryInfo& info, uint32_t changedFields)
+{
+    if (base_ == nullptr) {
+        return;
+    }
+    auto header = reinterpret_cast<BatteryJournalFormat::Header*>(base_);
+    BatteryJournalFormat::Record record {};
+    record.seq = nextSeq_;
+    record.time = time;
+    record.capacity = info.GetCapacity();
+    record.voltage = info.GetVoltage();
+    record.current = info.GetNowCurrent();
+    record.temperature = info.GetTemperature();
+    record.chargeState = static_cast<int32_t>(info.GetChargeState());
+    record.pluggedType = static_cast<int32_t>(info.GetPluggedType());
+    record.healthState = static_cast<int32_t>(info.GetHealthState());
+    record.chargeCounter = info.GetChargeCounter();
+    record.remainEnergy = info.GetRemainEnergy();
+    record.changedFields = changedFields;
+    record.crc = BatteryJournalFormat::RecordCrc(record);
+    BatteryJournalFormat::GetRecord(base_, *header, nextSeq_) = record;
+    header->nextSeq = ++nextSeq_;
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -106,6 +106,17 @@ bool BatteryLight::UpdateColor(BatteryChargeState chargeState, int32_t capacity)
     }
 
     RETURN_IF_WITH_RET(!available_, false);
+    std::shared_ptr<const BatterySocTable> socTable = std::atomic_load(&socTable_);
+    if (socTable != nullptr) {
+        const auto& entry = socTable->Lookup(capacity);
+        RETURN_IF_WITH_RET(!entry.hasColor, false);
+        RETURN_IF_WITH_RET(lightColor_ == entry.rgb, true);
+#ifdef HAS_SENSORS_MISCDEVICE_PART
+        TurnOff();
+        TurnOn(entry.rgb);
+#endif
+        return true;
+    }
     const auto& lightConf = BatteryConfig::GetInstance().GetLightConf();
     for (const auto& it : lightConf) {
         if ((capacity >= it.beginSoc) && (capacity <= it.endSoc)) {
@@ -120,6 +131,11 @@ bool BatteryLight::UpdateColor(BatteryChargeState chargeState, int32_t capacity)
     return false;
 }
 
+void BatteryLight::SetSocTable(const std::shared_ptr<const BatterySocTable>& socTable)
+{
+    std::atomic_store(&socTable_, socTable);
+}
+
 bool BatteryLight::isAvailable() const
 {
     return available_;
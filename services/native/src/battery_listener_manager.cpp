@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_listener_manager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <new>
+
+#include "battery_log.h"
+#include "ffrt_utils.h"
+#include "power_common.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr int64_t US_PER_MS = 1000;
+}
+
+BatteryListenerManager::BatteryListenerManager()
+    : queue_(std::make_shared<ffrt::queue>("battery_listener", ffrt::queue_attr().qos(ffrt::qos_utility)))
+{
+}
+
+int64_t BatteryListenerManager::GetTickMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+BatteryError BatteryListenerManager::Register(const sptr<IBatteryListener>& listener, uint32_t fieldMask,
+    int64_t minIntervalMs, int32_t pid, bool isSystem)
+{
+    sptr<IRemoteObject> remote = (listener == nullptr) ? nullptr : listener->AsObject();
+    if ((remote == nullptr) || (fieldMask == BatteryInfo::FIELD_NONE) || (minIntervalMs < 0) ||
+        (minIntervalMs > MAX_INTERVAL_MS)) {
+        BATTERY_HILOGW(COMP_SVC, "invalid listener, fieldMask=%{public}u, minIntervalMs=%{public}lld", fieldMask,
+            static_cast<long long>(minIntervalMs));
+        return BatteryError::ERR_PARAM_INVALID;
+    }
+    if (!isSystem) {
+        fieldMask &= ~SYSTEM_FIELDS;
+        if (fieldMask == BatteryInfo::FIELD_NONE) {
+            return BatteryError::ERR_SYSTEM_API_DENIED;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = subscribers_.find(remote.GetRefPtr());
+    if (it != subscribers_.end()) {
+        // registering again only changes the subscription, the pending change is kept
+        it->second.fieldMask = fieldMask;
+        it->second.minIntervalMs = minIntervalMs;
+        it->second.isSystem = isSystem;
+        return BatteryError::ERR_OK;
+    }
+    size_t pidCount = static_cast<size_t>(std::count_if(subscribers_.begin(), subscribers_.end(),
+        [pid](const auto& entry) { return entry.second.pid == pid; }));
+    if ((subscribers_.size() >= MAX_LISTENERS) || (pidCount >= MAX_LISTENERS_PER_PID)) {
+        BATTERY_HILOGW(COMP_SVC, "too many listeners, pid=%{public}d, total=%{public}zu", pid, subscribers_.size());
+        return BatteryError::ERR_FAILURE;
+    }
+    if (deathRecipient_ == nullptr) {
+        deathRecipient_ = new (std::nothrow) ListenerDeathRecipient(*this);
+        RETURN_IF_WITH_RET(deathRecipient_ == nullptr, BatteryError::ERR_FAILURE);
+    }
+    if (remote->IsProxyObject() && !remote->AddDeathRecipient(deathRecipient_)) {
+        BATTERY_HILOGW(COMP_SVC, "add listener death recipient failed, pid=%{public}d", pid);
+        return BatteryError::ERR_FAILURE;
+    }
+    Subscriber& subscriber = subscribers_[remote.GetRefPtr()];
+    subscriber.listener = listener;
+    subscriber.remote = remote;
+    subscriber.fieldMask = fieldMask;
+    subscriber.minIntervalMs = minIntervalMs;
+    subscriber.pid = pid;
+    subscriber.isSystem = isSystem;
+    count_ = static_cast<uint32_t>(subscribers_.size());
+    BATTERY_HILOGI(COMP_SVC, "listener registered, pid=%{public}d, fieldMask=0x%{public}x, total=%{public}zu", pid,
+        fieldMask, subscribers_.size());
+    return BatteryError::ERR_OK;
+}
+
+BatteryError BatteryListenerManager::Unregister(const sptr<IBatteryListener>& listener)
+{
+    sptr<IRemoteObject> remote = (listener == nullptr) ? nullptr : listener->AsObject();
+    RETURN_IF_WITH_RET(remote == nullptr, BatteryError::ERR_PARAM_INVALID);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = subscribers_.find(remote.GetRefPtr());
+    if (it == subscribers_.end()) {
+        return BatteryError::ERR_OK;
+    }
+    if (remote->IsProxyObject() && (deathRecipient_ != nullptr)) {
+        remote->RemoveDeathRecipient(deathRecipient_);
+    }
+    subscribers_.erase(it);
+    count_ = static_cast<uint32_t>(subscribers_.size());
+    return BatteryError::ERR_OK;
+}
+
+bool BatteryListenerManager::HasListeners() const
+{
+    return count_.load(std::memory_order_relaxed) > 0;
+}
+
+void BatteryListenerManager::Notify(uint32_t changedFields, const BatteryInfoSnapshot& systemSnapshot,
+    const BatteryInfoSnapshot& publicSnapshot)
+{
+    std::shared_ptr<const BatteryInfoSnapshot> systemShared = nullptr;
+    std::shared_ptr<const BatteryInfoSnapshot> publicShared = nullptr;
+    int64_t nowMs = GetTickMs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [key, subscriber] : subscribers_) {
+        uint32_t fields = changedFields & subscriber.fieldMask;
+        if (fields == BatteryInfo::FIELD_NONE) {
+            continue;
+        }
+        auto& shared = subscriber.isSystem ? systemShared : publicShared;
+        if (shared == nullptr) {
+            shared = std::make_shared<const BatteryInfoSnapshot>(subscriber.isSystem ? systemSnapshot :
+                publicSnapshot);
+        }
+        if (subscriber.pending != nullptr) {
+            coalesced_++;
+        }
+        subscriber.pendingFields |= fields;
+        subscriber.pending = shared;
+        notified_++;
+        ScheduleLocked(key, subscriber, nowMs);
+    }
+}
+
+void BatteryListenerManager::ScheduleLocked(IRemoteObject* key, Subscriber& subscriber, int64_t nowMs)
+{
+    if (subscriber.scheduled) {
+        return;
+    }
+    int64_t delayMs = 0;
+    if (subscriber.delivered) {
+        delayMs = std::max<int64_t>(subscriber.lastDeliveryMs + subscriber.minIntervalMs - nowMs, 0);
+    }
+    subscriber.scheduled = true;
+    queue_->submit([this, key] { Deliver(key); },
+        ffrt::task_attr().delay(static_cast<uint64_t>(delayMs * US_PER_MS)));
+}
+
+void BatteryListenerManager::Deliver(IRemoteObject* key)
+{
+    sptr<IBatteryListener> listener = nullptr;
+    uint32_t fields = 0;
+    std::shared_ptr<const BatteryInfoSnapshot> snapshot = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = subscribers_.find(key);
+        if (it == subscribers_.end()) {
+            return;
+        }
+        Subscriber& subscriber = it->second;
+        subscriber.scheduled = false;
+        if (subscriber.pending == nullptr) {
+            return;
+        }
+        listener = subscriber.listener;
+        fields = subscriber.pendingFields;
+        snapshot = std::move(subscriber.pending);
+        subscriber.pending = nullptr;
+        subscriber.pendingFields = 0;
+        subscriber.lastDeliveryMs = GetTickMs();
+        subscriber.delivered = true;
+    }
+    // oneway, outside the lock so Notify never waits for a client
+    listener->OnBatteryChanged(fields, *snapshot);
+    delivered_++;
+}
+
+void BatteryListenerManager::OnListenerDied(const wptr<IRemoteObject>& remote)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = subscribers_.find(remote.GetRefPtr());
+    if (it == subscribers_.end()) {
+        return;
+    }
+    BATTERY_HILOGI(COMP_SVC, "listener died, pid=%{public}d", it->second.pid);
+    subscribers_.erase(it);
+    count_ = static_cast<uint32_t>(subscribers_.size());
+    died_++;
+}
+
+void BatteryListenerManager::ListenerDeathRecipient::OnRemoteDied(const wptr<IRemoteObject>& remote)
+{
+    manager_.OnListenerDied(remote);
+}
+
+BatteryListenerManager::Stats BatteryListenerManager::GetStats()
+{
+    Stats stats;
+    stats.listeners = count_.load();
+    stats.notified = notified_.load();
+    stats.coalesced = coalesced_.load();
+    stats.delivered = delivered_.load();
+    stats.died = died_.load();
+    return stats;
+}
+} // namespace PowerMgr
+} // namespace OHOS
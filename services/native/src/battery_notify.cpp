@@ -14,6 +14,8 @@
  */
 
 #include "battery_notify.h"
+#include <chrono>
+#include <cstdlib>
 #include <regex>
 
 #ifdef BATTERY_MANAGER_ENABLE_CHARGING_SOUND
@@ -46,6 +48,7 @@
 #include "battery_config.h"
 #include "battery_log.h"
 #include "battery_service.h"
+#include "battery_trace.h"
 #include "power_vibrator.h"
 #include "power_mgr_client.h"
 #include <dlfcn.h>
@@ -76,15 +79,45 @@ const std::string PRODUCT_TYPE_THREE = "RVS_ADAPTER_PRODUCT_TYPE=3";
 const std::string PRODUCT_TYPE_FOUR = "RVS_ADAPTER_PRODUCT_TYPE=4";
 const std::string PRODUCT_TYPE_FIVE = "RVS_ADAPTER_PRODUCT_TYPE=5";
 sptr<BatteryService> g_service = DelayedSpSingleton<BatteryService>::GetInstance();
+// Fields each publisher reads, it is skipped when none of them changed since the last sample
+constexpr uint32_t CHANGED_EVENT_FIELDS = BatteryInfo::FIELD_CAPACITY | BatteryInfo::FIELD_VOLTAGE |
+    BatteryInfo::FIELD_TEMPERATURE | BatteryInfo::FIELD_HEALTH_STATE | BatteryInfo::FIELD_PLUGGED_TYPE |
+    BatteryInfo::FIELD_CHARGE_STATE | BatteryInfo::FIELD_PRESENT | BatteryInfo::FIELD_TECHNOLOGY |
+    BatteryInfo::FIELD_UEVENT;
+constexpr uint32_t CHANGED_INNER_EVENT_FIELDS = BatteryInfo::FIELD_PLUGGED_MAX_CURRENT |
+    BatteryInfo::FIELD_PLUGGED_MAX_VOLTAGE | BatteryInfo::FIELD_NOW_CURRENT | BatteryInfo::FIELD_CHARGE_COUNTER;
+constexpr uint32_t CAPACITY_EVENT_FIELDS = BatteryInfo::FIELD_CAPACITY;
+constexpr uint32_t PLUGGED_EVENT_FIELDS = BatteryInfo::FIELD_PLUGGED_TYPE;
+constexpr uint32_t CHARGING_EVENT_FIELDS = BatteryInfo::FIELD_CHARGE_STATE;
+constexpr uint32_t CHARGE_TYPE_EVENT_FIELDS = BatteryInfo::FIELD_CHARGE_TYPE;
+// Discrete BATTERY_CHANGED fields, a change of any of them is always broadcast
+constexpr uint32_t CHANGED_EVENT_TRIGGER_FIELDS = BatteryInfo::FIELD_CAPACITY | BatteryInfo::FIELD_PLUGGED_TYPE |
+    BatteryInfo::FIELD_CHARGE_STATE | BatteryInfo::FIELD_HEALTH_STATE | BatteryInfo::FIELD_PRESENT |
+    BatteryInfo::FIELD_TECHNOLOGY | BatteryInfo::FIELD_UEVENT;
+
+static int64_t GetTickMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool IsDeltaSignificant(int32_t value, int32_t lastValue, int32_t delta)
+{
+    int64_t diff = std::llabs(static_cast<int64_t>(value) - static_cast<int64_t>(lastValue));
+    return diff != 0 && diff >= delta;
+}
 
 BatteryNotify::BatteryNotify()
 {
-    const int32_t DEFAULT_LOW_CAPACITY = 20;
-    lowCapacity_ = BatteryConfig::GetInstance().GetInt("soc.low", DEFAULT_LOW_CAPACITY);
-    BATTERY_HILOGI(COMP_SVC, "Low broadcast power=%{public}d", lowCapacity_);
+    auto& batteryConfig = BatteryConfig::GetInstance();
+    voltageDelta_ = batteryConfig.GetInt("publish.voltage_delta", voltageDelta_);
+    temperatureDelta_ = batteryConfig.GetInt("publish.temperature_delta", temperatureDelta_);
+    minInterval_ = batteryConfig.GetInt("publish.min_interval", minInterval_);
+    BATTERY_HILOGI(COMP_SVC, "changed event policy, voltageDelta=%{public}d, temperatureDelta=%{public}d, "
+        "minInterval=%{public}d", voltageDelta_, temperatureDelta_, minInterval_);
 }
 
-int32_t BatteryNotify::PublishEvents(BatteryInfo& info)
+int32_t BatteryNotify::PublishEvents(BatteryInfo& info, uint32_t changedFields)
 {
     if (!g_commonEventInitSuccess) {
         if (!IsCommonEventServiceAbilityExist()) {
@@ -93,42 +126,79 @@ int32_t BatteryNotify::PublishEvents(BatteryInfo& info)
     }
     if (info.GetUevent() != POWER_SUPPLY && info.GetUevent() != "" &&
         info.GetUevent() != INVALID_STRING_VALUE) {
+        BatteryTraceScope trace(BatteryTraceStage::PUBLISH_UEVENT);
         HandleUevent(info);
         return ERR_OK;
     }
 
     bool isAllSuccess = true;
-    bool ret = PublishChangedEvent(info);
-    isAllSuccess &= ret;
-    ret = PublishChangedEventInner(info);
-    isAllSuccess &= ret;
+    if ((changedFields & CHANGED_EVENT_FIELDS) != 0) {
+        if (IsChangedEventSignificant(info, changedFields)) {
+            BatteryTraceScope trace(BatteryTraceStage::PUBLISH_CHANGED);
+            isAllSuccess &= trace.Check(PublishChangedEvent(info));
+        } else {
+            changedSuppressed_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if ((changedFields & CHANGED_INNER_EVENT_FIELDS) != 0) {
+        BatteryTraceScope trace(BatteryTraceStage::PUBLISH_CHANGED_INNER);
+        isAllSuccess &= trace.Check(PublishChangedEventInner(info));
+    }
     std::lock_guard<std::mutex> lock(mutex_);
-    ret = PublishLowEvent(info);
-    isAllSuccess &= ret;
-    ret = PublishOkayEvent(info);
-    isAllSuccess &= ret;
+    if ((changedFields & CAPACITY_EVENT_FIELDS) != 0) {
+        BatteryTraceScope trace(BatteryTraceStage::PUBLISH_CAPACITY);
+        isAllSuccess &= trace.Check(PublishLowEvent(info));
+        isAllSuccess &= trace.Check(PublishOkayEvent(info));
+    }
 
+    if ((changedFields & PLUGGED_EVENT_FIELDS) != 0) {
 #ifdef BATTERY_MANAGER_ENABLE_WIRELESS_CHARGE
-    PublishEventContext context {.pluggedType = info.GetPluggedType(),
-        .lastPluggedType = lastPowerPluggedType_,
-        .wirelessChargerEnable = BatteryConfig::GetInstance().GetWirelessChargerConf()};
-    HookMgrExecute(
-        GetBatteryHookMgr(), static_cast<int32_t>(BatteryHookStage::BATTERY_PUBLISH_EVENT), &context, nullptr);
+        {
+            BatteryTraceScope hookTrace(BatteryTraceStage::HOOK);
+            PublishEventContext context {.pluggedType = info.GetPluggedType(),
+                .lastPluggedType = lastPowerPluggedType_,
+                .wirelessChargerEnable = BatteryConfig::GetInstance().GetWirelessChargerConf()};
+            HookMgrExecute(GetBatteryHookMgr(), static_cast<int32_t>(BatteryHookStage::BATTERY_PUBLISH_EVENT),
+                &context, nullptr);
+        }
 #endif
-    ret = PublishPowerConnectedEvent(info);
-    isAllSuccess &= ret;
-    ret = PublishPowerDisconnectedEvent(info);
-    isAllSuccess &= ret;
-    ret = PublishChargingEvent(info);
-    isAllSuccess &= ret;
-    ret = PublishDischargingEvent(info);
-    isAllSuccess &= ret;
-    ret = PublishChargeTypeChangedEvent(info);
-    isAllSuccess &= ret;
+        BatteryTraceScope trace(BatteryTraceStage::PUBLISH_PLUGGED);
+        isAllSuccess &= trace.Check(PublishPowerConnectedEvent(info));
+        isAllSuccess &= trace.Check(PublishPowerDisconnectedEvent(info));
+    }
+    if ((changedFields & CHARGING_EVENT_FIELDS) != 0) {
+        BatteryTraceScope trace(BatteryTraceStage::PUBLISH_CHARGING);
+        isAllSuccess &= trace.Check(PublishChargingEvent(info));
+        isAllSuccess &= trace.Check(PublishDischargingEvent(info));
+    }
+    if ((changedFields & CHARGE_TYPE_EVENT_FIELDS) != 0) {
+        BatteryTraceScope trace(BatteryTraceStage::PUBLISH_CHARGE_TYPE);
+        isAllSuccess &= trace.Check(PublishChargeTypeChangedEvent(info));
+    }
     lastPowerPluggedType_ = info.GetPluggedType();
     return isAllSuccess ? ERR_OK : ERR_NO_INIT;
 }
 
+bool BatteryNotify::IsChangedEventSignificant(const BatteryInfo& info, uint32_t changedFields) const
+{
+    if ((changedFields & CHANGED_EVENT_TRIGGER_FIELDS) != 0) {
+        return true;
+    }
+    if ((GetTickMs() - lastChangedTime_) < minInterval_) {
+        return false;
+    }
+    return IsDeltaSignificant(info.GetVoltage(), lastChangedVoltage_, voltageDelta_) ||
+        IsDeltaSignificant(info.GetTemperature(), lastChangedTemperature_, temperatureDelta_);
+}
+
+BatteryNotify::ChangedEventStats BatteryNotify::GetChangedEventStats() const
+{
+    ChangedEventStats stats;
+    stats.published = changedPublished_.load(std::memory_order_relaxed);
+    stats.suppressed = changedSuppressed_.load(std::memory_order_relaxed);
+    return stats;
+}
+
 void BatteryNotify::HandleUevent(BatteryInfo& info)
 {
     std::string uevent = info.GetUevent();
@@ -161,7 +231,13 @@ void BatteryNotify::HandleUevent(BatteryInfo& info)
             BATTERY_HILOGE(COMP_SVC, "undefine uevent act %{public}s", ueventAct.c_str());
         }
     }
-    BATTERY_HILOGI(COMP_SVC, "handle uevent info %{public}s", uevent.c_str());
+    uint32_t suppressed = 0;
+    if (ueventLogLimiter_.Allow(suppressed)) {
+        if (suppressed > 0) {
+            BATTERY_HILOGI(COMP_SVC, "%{public}u similar lines suppressed", suppressed);
+        }
+        BATTERY_HILOGI(COMP_SVC, "handle uevent info %{public}s", uevent.c_str());
+    }
 }
 
 bool BatteryNotify::PublishChargeTypeChangedEvent(const BatteryInfo& info)
@@ -229,11 +305,10 @@ bool BatteryNotify::PublishChangedEvent(const BatteryInfo& info)
     want.SetParam(BatteryInfo::COMMON_EVENT_KEY_TECHNOLOGY, info.GetTechnology());
     want.SetParam(BatteryInfo::COMMON_EVENT_KEY_UEVENT, info.GetUevent());
 
-    auto capacityLevel = static_cast<uint32_t>(BatteryCapacityLevel::LEVEL_NONE);
-    g_service->GetCapacityLevel(capacityLevel);
-    if (static_cast<BatteryCapacityLevel>(capacityLevel) != g_lastCapacityLevel) {
+    BatteryCapacityLevel capacityLevel = g_service->GetCapacityLevelByCapacity(capacity);
+    if (capacityLevel != g_lastCapacityLevel) {
         want.SetParam(BatteryInfo::COMMON_EVENT_KEY_CAPACITY_LEVEL, static_cast<int32_t>(capacityLevel));
-        g_lastCapacityLevel = static_cast<BatteryCapacityLevel>(capacityLevel);
+        g_lastCapacityLevel = capacityLevel;
     }
 
     want.SetAction(CommonEventSupport::COMMON_EVENT_BATTERY_CHANGED);
@@ -258,6 +333,10 @@ bool BatteryNotify::PublishChangedEvent(const BatteryInfo& info)
     if (!isSuccess) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "failed to publish BATTERY_CHANGED event");
     }
+    lastChangedVoltage_ = info.GetVoltage();
+    lastChangedTemperature_ = temperature;
+    lastChangedTime_ = GetTickMs();
+    changedPublished_.fetch_add(1, std::memory_order_relaxed);
     return isSuccess;
 }
 
@@ -289,7 +368,7 @@ bool BatteryNotify::PublishLowEvent(const BatteryInfo& info) const
 {
     bool isSuccess = true;
 
-    if (info.GetCapacity() > lowCapacity_) {
+    if (!g_service->GetSocTable()->IsLow(info.GetCapacity())) {
         g_batteryLowOnce = false;
         return isSuccess;
     }
@@ -318,7 +397,7 @@ bool BatteryNotify::PublishOkayEvent(const BatteryInfo& info) const
 {
     bool isSuccess = true;
 
-    if (info.GetCapacity() <= lowCapacity_) {
+    if (g_service->GetSocTable()->IsLow(info.GetCapacity())) {
         g_batteryOkOnce = false;
         return isSuccess;
     }
@@ -626,8 +705,12 @@ bool BatteryNotify::PublishCustomEvent(const BatteryInfo& info, const std::strin
         .UeventName = info.GetUevent(),
         .checkResult = true
     };
-    int ret = HookMgrExecute(GetBatteryHookMgr(), static_cast<int32_t>(BatteryHookStage::BATTERY_UEVENT_CHECK),
-        (void*)&ueventCheckInfo, nullptr);
+    int ret = 0;
+    {
+        BatteryTraceScope trace(BatteryTraceStage::HOOK);
+        ret = HookMgrExecute(GetBatteryHookMgr(), static_cast<int32_t>(BatteryHookStage::BATTERY_UEVENT_CHECK),
+            (void*)&ueventCheckInfo, nullptr);
+    }
     if (ret == 0 && !ueventCheckInfo.checkResult) {
         BATTERY_HILOGW(FEATURE_BATT_INFO, "PublishCustomEvent fail, uevent=%{public}s, checkResult=%{public}d",
             ueventCheckInfo.UeventName.c_str(), ueventCheckInfo.checkResult);
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_permission_cache.h"
+
+#include "accesstoken_kit.h"
+#include "ipc_skeleton.h"
+#include "perm_state_change_callback_customize.h"
+#include "permission.h"
+
+#include "battery_log.h"
+
+using namespace OHOS::Security::AccessToken;
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr uint32_t SYSTEM_BIT = 1;
+constexpr uint64_t TOKEN_ID_MASK = 0xFFFFFFFF;
+
+class PermissionChangeCallback : public PermStateChangeCallbackCustomize {
+public:
+    PermissionChangeCallback(const PermStateChangeScope& scope, BatteryPermissionCache& cache)
+        : PermStateChangeCallbackCustomize(scope), cache_(cache)
+    {
+    }
+    ~PermissionChangeCallback() override = default;
+
+    void PermStateChangeCallback(PermStateChangeInfo& result) override
+    {
+        BATTERY_HILOGI(COMP_SVC, "permission %{public}s changed, tokenId=%{public}u",
+            result.permissionName.c_str(), result.tokenID);
+        cache_.Invalidate(result.tokenID);
+    }
+
+private:
+    BatteryPermissionCache& cache_;
+};
+}
+
+BatteryPermissionCache::~BatteryPermissionCache()
+{
+    if (callback_ != nullptr) {
+        AccessTokenKit::UnRegisterPermStateChangeCallback(callback_);
+    }
+}
+
+bool BatteryPermissionCache::Init(const std::vector<std::string>& permissions)
+{
+    if (callback_ != nullptr || permissions.size() > MAX_PERMISSIONS) {
+        return callback_ != nullptr;
+    }
+    PermStateChangeScope scope;
+    scope.permList = permissions;
+    auto callback = std::make_shared<PermissionChangeCallback>(scope, *this);
+    int32_t ret = AccessTokenKit::RegisterPermStateChangeCallback(callback);
+    if (ret != RET_SUCCESS) {
+        // without notifications a revoked grant could stay cached, so only IsSystem is cached
+        BATTERY_HILOGW(COMP_SVC, "register permission state callback failed, ret=%{public}d", ret);
+        return false;
+    }
+    permissions_ = permissions;
+    callback_ = callback;
+    isSubscribed_.store(true, std::memory_order_release);
+    return true;
+}
+
+bool BatteryPermissionCache::IsSystem()
+{
+    return Decide(SYSTEM_BIT, [] { return Permission::IsSystem(); });
+}
+
+bool BatteryPermissionCache::IsNativePermissionGranted(const std::string& permission)
+{
+    uint32_t bit = 0;
+    if (isSubscribed_.load(std::memory_order_acquire)) {
+        for (size_t i = 0; i < permissions_.size(); i++) {
+            if (permissions_[i] == permission) {
+                bit = SYSTEM_BIT << (i + 1);
+                break;
+            }
+        }
+    }
+    if (bit == 0) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return Permission::IsNativePermissionGranted(permission);
+    }
+    return Decide(bit, [&permission] { return Permission::IsNativePermissionGranted(permission); });
+}
+
+bool BatteryPermissionCache::Decide(uint32_t bit, const Checker& checker)
+{
+    uint64_t tokenId = IPCSkeleton::GetCallingFullTokenID();
+    bool isGranted = false;
+    if (Lookup(tokenId, bit, isGranted)) {
+        return isGranted;
+    }
+    uint64_t generation = invalidations_.load(std::memory_order_acquire);
+    isGranted = checker();
+    Insert(tokenId, bit, isGranted, generation);
+    return isGranted;
+}
+
+bool BatteryPermissionCache::Lookup(uint64_t tokenId, uint32_t bit, bool& isGranted)
+{
+    if (enabled_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = index_.find(tokenId);
+        if (iter != index_.end() && (iter->second->known & bit) != 0) {
+            entries_.splice(entries_.begin(), entries_, iter->second);
+            isGranted = (iter->second->granted & bit) != 0;
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void BatteryPermissionCache::Insert(uint64_t tokenId, uint32_t bit, bool isGranted, uint64_t generation)
+{
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (invalidations_.load(std::memory_order_relaxed) != generation) {
+        // a permission changed while the decision was taken, it may already be stale
+        return;
+    }
+    auto iter = index_.find(tokenId);
+    if (iter == index_.end()) {
+        if (entries_.size() >= CAPACITY) {
+            index_.erase(entries_.back().tokenId);
+            entries_.pop_back();
+        }
+        entries_.push_front(Entry { tokenId, 0, 0 });
+        iter = index_.emplace(tokenId, entries_.begin()).first;
+    } else {
+        entries_.splice(entries_.begin(), entries_, iter->second);
+    }
+    Entry& entry = *iter->second;
+    entry.known |= bit;
+    entry.granted = isGranted ? (entry.granted | bit) : (entry.granted & ~bit);
+}
+
+void BatteryPermissionCache::Invalidate(uint32_t tokenId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto iter = entries_.begin(); iter != entries_.end();) {
+        if ((iter->tokenId & TOKEN_ID_MASK) != tokenId) {
+            ++iter;
+            continue;
+        }
+        index_.erase(iter->tokenId);
+        iter = entries_.erase(iter);
+    }
+    invalidations_.fetch_add(1, std::memory_order_release);
+}
+
+void BatteryPermissionCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+}
+
+BatteryPermissionCache::Stats BatteryPermissionCache::GetStats()
+{
+    Stats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.invalidations = invalidations_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.size = static_cast<uint32_t>(entries_.size());
+    return stats;
+}
+} // namespace PowerMgr
+} // namespace OHOS
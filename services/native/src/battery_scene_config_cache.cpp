@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_scene_config_cache.h"
+
+#include <chrono>
+
+namespace OHOS {
+namespace PowerMgr {
+int64_t BatterySceneConfigCache::GetTickMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void BatterySceneConfigCache::SetMaxAge(int32_t maxAge)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxAge_ = maxAge;
+    values_.clear();
+    generation_++;
+}
+
+bool BatterySceneConfigCache::Miss(uint64_t& generation)
+{
+    generation = generation_;
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool BatterySceneConfigCache::GetValue(const std::string& sceneName, std::string& value, uint64_t& generation)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = values_.find(sceneName);
+    if (iter == values_.end()) {
+        return Miss(generation);
+    }
+    if ((GetTickMs() - iter->second.time) > maxAge_) {
+        values_.erase(iter);
+        return Miss(generation);
+    }
+    value = iter->second.value;
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void BatterySceneConfigCache::PutValue(const std::string& sceneName, const std::string& value, uint64_t generation)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (maxAge_ <= 0 || generation != generation_) {
+        return;
+    }
+    if (values_.size() >= CAPACITY && values_.find(sceneName) == values_.end()) {
+        values_.clear();
+    }
+    values_[sceneName] = ValueEntry { value, GetTickMs() };
+}
+
+bool BatterySceneConfigCache::GetSupported(const std::string& sceneName, bool& isSupported, uint64_t& generation)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = supported_.find(sceneName);
+    if (iter == supported_.end()) {
+        return Miss(generation);
+    }
+    isSupported = iter->second;
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void BatterySceneConfigCache::PutSupported(const std::string& sceneName, bool isSupported, uint64_t generation)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (generation != generation_) {
+        return;
+    }
+    if (supported_.size() >= CAPACITY && supported_.find(sceneName) == supported_.end()) {
+        supported_.clear();
+    }
+    supported_[sceneName] = isSupported;
+}
+
+void BatterySceneConfigCache::Invalidate(const std::string& sceneName)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    values_.erase(sceneName);
+    generation_++;
+}
+
+void BatterySceneConfigCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    values_.clear();
+    supported_.clear();
+    generation_++;
+}
+
+BatterySceneConfigCache::Stats BatterySceneConfigCache::GetStats()
+{
+    Stats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.values = static_cast<uint32_t>(values_.size());
+    stats.supported = static_cast<uint32_t>(supported_.size());
+    return stats;
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -15,8 +15,11 @@
 
 #include "battery_service.h"
 
+#include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <ctime>
+#include <dirent.h>
 #include <functional>
 #include <new>
 #include <modulemgr.h>
@@ -27,7 +30,6 @@
 #include "hdf_service_status.h"
 #include "ipc_skeleton.h"
 #include "iremote_object.h"
-#include "permission.h"
 #include "power_common.h"
 #include "power_mgr_client.h"
 #include "ffrt_utils.h"
@@ -39,6 +41,7 @@
 #include "battery_config.h"
 #include "battery_dump.h"
 #include "battery_log.h"
+#include "battery_trace.h"
 #include "power_vibrator.h"
 #include "v2_0/ibattery_callback.h"
 
@@ -59,10 +62,22 @@ constexpr int32_t BATTERY_FULL_CAPACITY = 100;
 constexpr uint32_t RETRY_TIME = 1000;
 constexpr uint32_t SHUTDOWN_DELAY_TIME_MS = 60000;
 constexpr uint32_t SHUTDOWN_GUARD_TIMEOUT_MS = SHUTDOWN_DELAY_TIME_MS + 30000;
+// bounds the journal records a power cut can lose
+constexpr uint32_t JOURNAL_FLUSH_INTERVAL_MS = 30000;
+const std::string POWER_OPTIMIZATION_PERMISSION = "ohos.permission.POWER_OPTIMIZATION";
+constexpr size_t MAX_BATTERY_CONFIG_BATCH = 32;
 const std::string BATTERY_VIBRATOR_CONFIG_FILE = "etc/battery/battery_vibrator.json";
 const std::string VENDOR_BATTERY_VIBRATOR_CONFIG_FILE = "/vendor/etc/battery/battery_vibrator.json";
 const std::string SYSTEM_BATTERY_VIBRATOR_CONFIG_FILE = "/system/etc/battery/battery_vibrator.json";
 const std::string COMMON_EVENT_BATTERY_CHANGED = "usual.event.BATTERY_CHANGED";
+constexpr const char* POWER_SUPPLY_PATH = "/sys/class/power_supply";
+// Fields read by the light, remaining charge time and low capacity handlers of HandleBatteryInfo
+constexpr uint32_t CHARGE_PROGRESS_FIELDS = BatteryInfo::FIELD_CAPACITY | BatteryInfo::FIELD_CHARGE_STATE;
+constexpr uint32_t LOW_CAPACITY_FIELDS = CHARGE_PROGRESS_FIELDS | BatteryInfo::FIELD_PRESENT;
+// while charging every event goes to the estimator, it drops the ones that add nothing
+constexpr uint32_t CHARGE_TIME_FIELDS = CHARGE_PROGRESS_FIELDS | BatteryInfo::FIELD_PLUGGED_TYPE;
+constexpr uint32_t DISCHARGE_TIME_FIELDS =
+    BatteryInfo::FIELD_NOW_CURRENT | BatteryInfo::FIELD_REMAIN_ENERGY | BatteryInfo::FIELD_PLUGGED_TYPE;
 sptr<BatteryService> g_service = DelayedSpSingleton<BatteryService>::GetInstance();
 FFRTQueue g_queue("battery_service");
 FFRTHandle g_lowCapacityShutdownHandle = nullptr;
@@ -72,6 +87,43 @@ std::shared_ptr<RunningLock> g_shutdownGuard = nullptr;
 #ifdef BATTERY_MANAGER_SET_LOW_CAPACITY_THRESHOLD
 std::shared_ptr<FFRTTimer> g_ffrtTimer = nullptr;
 #endif
+
+bool HasPowerSupplyDevice()
+{
+    DIR* dir = opendir(POWER_SUPPLY_PATH);
+    if (dir == nullptr) {
+        return false;
+    }
+    bool found = false;
+    struct dirent* entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) {
+            found = true;
+            break;
+        }
+    }
+    closedir(dir);
+    return found;
+}
+
+void FillBatteryInfo(const V2_0::BatteryInfo& event, BatteryInfo& info)
+{
+    info.SetCapacity(event.capacity);
+    info.SetPluggedType(BatteryPluggedType(event.pluggedType));
+    info.SetPluggedMaxCurrent(event.pluggedMaxCurrent);
+    info.SetPluggedMaxVoltage(event.pluggedMaxVoltage);
+    info.SetChargeState(BatteryChargeState(event.chargeState));
+    info.SetVoltage(event.voltage);
+    info.SetTemperature(event.temperature);
+    info.SetHealthState(BatteryHealthState(event.healthState));
+    info.SetChargeCounter(event.chargeCounter);
+    info.SetTotalEnergy(event.totalEnergy);
+    info.SetCurAverage(event.curAverage);
+    info.SetRemainEnergy(event.remainEnergy);
+    info.SetPresent(event.present);
+    info.SetTechnology(event.technology);
+    info.SetNowCurrent(event.curNow);
+}
 }
 std::atomic_bool BatteryService::isBootCompleted_ = false;
 
@@ -101,35 +153,65 @@ void BatteryService::OnStart()
         BATTERY_HILOGD(COMP_SVC, "Service is ready, nothing to do");
         return;
     }
+    startupStats_.Mark(BatteryStartupStats::ON_START);
     if (!(Init())) {
         BATTERY_HILOGE(COMP_SVC, "Call init failed");
         return;
     }
     RegisterHdiStatusListener();
-    g_moduleMgr = ModuleMgrScan(BATTERY_PLUGIN_AUTORUN_PATH);
     if (!Publish(this)) {
         BATTERY_HILOGE(COMP_SVC, "Register to system ability manager failed");
         return;
     }
+    startupStats_.Mark(BatteryStartupStats::PUBLISHED);
     AddSystemAbilityListener(MISCDEVICE_SERVICE_ABILITY_ID);
     AddSystemAbilityListener(COMMON_EVENT_SERVICE_ID);
+    // The hdi service manager registers with samgr, a listener registration it missed is retried from there
+    AddSystemAbilityListener(DEVICE_SERVICE_MANAGER_SA_ID);
     ready_ = true;
 }
 
 bool BatteryService::Init()
 {
+    // The vibrator config, the autorun plugins and the permission subscription don't depend on the
+    // battery config, they are loaded on ffrt while this thread parses it
+    ffrt::submit([this] {
+        BatteryEventLog::WatchLevel();
+        VibratorInit();
+        startupStats_.Mark(BatteryStartupStats::VIBRATOR_LOADED);
+    });
+    ffrt::submit([this] {
+        g_moduleMgr = ModuleMgrScan(BATTERY_PLUGIN_AUTORUN_PATH);
+        startupStats_.Mark(BatteryStartupStats::PLUGINS_SCANNED);
+    });
+    ffrt::submit([this] {
+        if (journal_.Open(BatteryJournalFormat::DEFAULT_PATH)) {
+            ScheduleJournalFlush();
+        }
+    });
+    ffrt::submit([this] {
+        permissionCache_.Init({ POWER_OPTIMIZATION_PERMISSION });
+        RegisterBootCompletedCallback();
+        startupStats_.Mark(BatteryStartupStats::PERMISSION_READY);
+    });
     InitConfig();
+    startupStats_.Mark(BatteryStartupStats::CONFIG_LOADED);
     if (!batteryNotify_) {
         batteryNotify_ = std::make_unique<BatteryNotify>();
     }
+    if (!eventPipeline_) {
+        eventPipeline_ = std::make_unique<BatteryEventPipeline>(
+            [this](const V2_0::BatteryInfo& event) { (void)HandleBatteryCallbackEvent(event); },
+            [this](BatteryInfo& info, uint32_t changedFields) { HandleBroadcast(info, changedFields); });
+    }
 #ifdef BATTERY_MANAGER_SET_LOW_CAPACITY_THRESHOLD
     if (!g_ffrtTimer) {
         g_ffrtTimer = std::make_shared<FFRTTimer>("battery_manager_ffrt_queue");
     }
     isHibernateEnable_ = system::GetBoolParameter("const.power.enable_s4", true);
 #endif
-    VibratorInit();
-    RegisterBootCompletedCallback();
+    ffrt::wait();
+    startupStats_.Mark(BatteryStartupStats::INIT_DONE);
     return true;
 }
 
@@ -148,6 +230,10 @@ void BatteryService::OnAddSystemAbility(int32_t systemAbilityId, const std::stri
         batteryLight_.InitLight();
     }
 
+    if (systemAbilityId == DEVICE_SERVICE_MANAGER_SA_ID) {
+        (void)RegisterHdiStatusListener();
+    }
+
     if (systemAbilityId == COMMON_EVENT_SERVICE_ID && !isCommonEventReady_.load()) {
 #ifdef BATTERY_MANAGER_SET_LOW_CAPACITY_THRESHOLD
         SubscribeCommonEvent();
@@ -156,21 +242,32 @@ void BatteryService::OnAddSystemAbility(int32_t systemAbilityId, const std::stri
             BATTERY_HILOGE(COMP_SVC, "battery hdi interface is not ready, return");
             return;
         }
-        OHOS::PowerMgr::BatteryInfo info = batteryInfo_;
+        OHOS::PowerMgr::BatteryInfo info = *LoadBatteryInfo();
         info.SetUevent("");
-        BATTERY_HILOGI(FEATURE_BATT_INFO, "cesready!capacity=%{public}d, voltage=%{public}d, "
-            "temperature=%{public}d, healthState=%{public}d, pluggedType=%{public}d, "
-            "pluggedMaxCurrent=%{public}d, pluggedMaxVoltage=%{public}d, "
-            "chargeState=%{public}d, chargeCounter=%{public}d, present=%{public}d, "
-            "technology=%{public}s, currNow=%{public}d, totalEnergy=%{public}d, curAverage=%{public}d, "
-            "remainEnergy=%{public}d, chargeType=%{public}d, event=%{public}s", info.GetCapacity(),
-            info.GetVoltage(), info.GetTemperature(), info.GetHealthState(),
-            info.GetPluggedType(), info.GetPluggedMaxCurrent(), info.GetPluggedMaxVoltage(),
-            info.GetChargeState(), info.GetChargeCounter(), info.IsPresent(),
-            info.GetTechnology().c_str(), info.GetNowCurrent(), info.GetTotalEnergy(),
-            info.GetCurAverage(), info.GetRemainEnergy(), info.GetChargeType(),
-            info.GetUevent().c_str());
-        batteryNotify_->PublishEvents(info);
+        eventLog_.Append(BatteryEventLog::SOURCE_CES_READY, info, BatteryInfo::FIELD_ALL);
+        uint32_t suppressed = 0;
+        if (infoLogLimiter_.Allow(suppressed)) {
+            if (suppressed > 0) {
+                BATTERY_HILOGI(FEATURE_BATT_INFO, "%{public}u similar lines suppressed", suppressed);
+            }
+            BATTERY_HILOGI(FEATURE_BATT_INFO, "cesready!capacity=%{public}d, voltage=%{public}d, "
+                "temperature=%{public}d, healthState=%{public}d, pluggedType=%{public}d, "
+                "pluggedMaxCurrent=%{public}d, pluggedMaxVoltage=%{public}d, "
+                "chargeState=%{public}d, chargeCounter=%{public}d, present=%{public}d, "
+                "technology=%{public}s, currNow=%{public}d, totalEnergy=%{public}d, curAverage=%{public}d, "
+                "remainEnergy=%{public}d, chargeType=%{public}d, event=%{public}s",
+                info.GetCapacity(), info.GetVoltage(), info.GetTemperature(), info.GetHealthState(),
+                info.GetPluggedType(), info.GetPluggedMaxCurrent(), info.GetPluggedMaxVoltage(),
+                info.GetChargeState(), info.GetChargeCounter(), info.IsPresent(),
+                info.GetTechnology().c_str(), info.GetNowCurrent(), info.GetTotalEnergy(),
+                info.GetCurAverage(), info.GetRemainEnergy(), info.GetChargeType(),
+                info.GetUevent().c_str());
+        }
+        {
+            std::lock_guard<std::mutex> broadcastLock(broadcastMutex_);
+            batteryNotify_->PublishEvents(info);
+            MarkFirstChanged();
+        }
         isCommonEventReady_.store(true, std::memory_order_relaxed);
     }
 }
@@ -184,14 +281,21 @@ bool BatteryService::RegisterBatteryHdiCallback()
         RETURN_IF_WITH_RET(iBatteryInterface_ == nullptr, false);
     }
     sptr<V2_0::IBatteryCallback> callback = new BatteryCallback();
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     ErrCode ret = iBatteryInterface_->Register(callback);
     if (ret < 0) {
         BATTERY_HILOGE(COMP_SVC, "register callback failed");
         return false;
     }
 
-    BatteryCallback::BatteryEventCallback eventCb =
-        [this](const V2_0::BatteryInfo& event) -> int32_t { return this->HandleBatteryCallbackEvent(event); };
+    // The hdi callback thread only enqueues, the events are handled on the pipeline queue
+    BatteryCallback::BatteryEventCallback eventCb = [this](const V2_0::BatteryInfo& event) -> int32_t {
+        if (eventPipeline_ == nullptr) {
+            return this->HandleBatteryCallbackEvent(event);
+        }
+        eventPipeline_->Push(event);
+        return ERR_OK;
+    };
     BatteryCallback::RegisterBatteryEvent(eventCb);
     return true;
 }
@@ -213,6 +317,14 @@ void BatteryService::InitConfig()
     normalCapacityThreshold_ = batteryConfig.GetInt("soc.normal", normalCapacityThreshold_);
     highCapacityThreshold_ = batteryConfig.GetInt("soc.high", highCapacityThreshold_);
     fullCapacityThreshold_ = batteryConfig.GetInt("soc.full", fullCapacityThreshold_);
+    snapshotMaxAge_ = batteryConfig.GetInt("snapshot.max_age", snapshotMaxAge_);
+    sceneConfigMaxAge_ = batteryConfig.GetInt("scene_config.max_age", sceneConfigMaxAge_);
+    sceneConfigCache_.SetMaxAge(sceneConfigMaxAge_);
+    if (snapshotMaxAge_ > 0 && !HasPowerSupplyDevice()) {
+        // without a kernel power supply class the hdi reads the mock path and never pushes uevents
+        BATTERY_HILOGW(COMP_SVC, "no power supply device, query battery hdi per call");
+        snapshotMaxAge_ = 0;
+    }
     BATTERY_HILOGI(COMP_SVC, "warnCapacity_=%{public}d, highTemperature_=%{public}d,\
         lowTemperature_=%{public}d, shutdownCapacityThreshold_=%{public}d,\
         criticalCapacityThreshold_=%{public}d, warningCapacityThreshold_=%{public}d, lowCapacityThreshold_=%{public}d,\
@@ -220,6 +332,10 @@ void BatteryService::InitConfig()
         warnCapacity_, highTemperature_, lowTemperature_, shutdownCapacityThreshold_, criticalCapacityThreshold_,
         warningCapacityThreshold_, lowCapacityThreshold_, normalCapacityThreshold_, highCapacityThreshold_,
         fullCapacityThreshold_);
+    BATTERY_HILOGI(COMP_SVC, "snapshotMaxAge_=%{public}d, sceneConfigMaxAge_=%{public}d", snapshotMaxAge_,
+        sceneConfigMaxAge_);
+    // the soc table is derived from the thresholds above, rebuild it whenever they are reloaded
+    BuildSocTable();
 }
 
 int32_t BatteryService::HandleBatteryCallbackEvent(const V2_0::BatteryInfo& event)
@@ -228,13 +344,19 @@ int32_t BatteryService::HandleBatteryCallbackEvent(const V2_0::BatteryInfo& even
         return ERR_OK;
     }
 
-    ConvertingEvent(event);
-    RETURN_IF_WITH_RET(lastBatteryInfo_ == batteryInfo_, ERR_OK);
-    HandleBatteryInfo();
+    std::lock_guard<std::mutex> infoLock(infoMutex_);
+    uint32_t changedFields = BatteryInfo::FIELD_NONE;
+    {
+        BatteryTraceScope trace(BatteryTraceStage::CONVERT);
+        changedFields = ConvertingEvent(event);
+    }
+    UpdateSnapshot(batteryInfo_);
+    RETURN_IF_WITH_RET(changedFields == BatteryInfo::FIELD_NONE, ERR_OK);
+    HandleBatteryInfo(changedFields, true);
     return ERR_OK;
 }
 
-void BatteryService::ConvertingEvent(const V2_0::BatteryInfo& event)
+uint32_t BatteryService::ConvertingEvent(const V2_0::BatteryInfo& event)
 {
     if (!isMockCapacity_) {
         batteryInfo_.SetCapacity(event.capacity);
@@ -255,27 +377,44 @@ void BatteryService::ConvertingEvent(const V2_0::BatteryInfo& event)
     batteryInfo_.SetPresent(event.present);
     batteryInfo_.SetTechnology(event.technology);
     batteryInfo_.SetNowCurrent(event.curNow);
-    batteryInfo_.SetChargeType(GetChargeType());
+    // The charge type only changes with the charger, skip the hdi query on steady-state samples
+    if ((batteryInfo_.GetPluggedType() != lastBatteryInfo_.GetPluggedType()) ||
+        (batteryInfo_.GetChargeState() != lastBatteryInfo_.GetChargeState())) {
+        batteryInfo_.SetChargeType(GetChargeType());
+    }
     if (!isMockUevent_) {
         batteryInfo_.SetUevent(event.uevent);
     }
+    return batteryInfo_.GetChangedFields(lastBatteryInfo_);
 }
 
 void BatteryService::InitBatteryInfo()
 {
-    batteryInfo_.SetCapacity(GetCapacityInner());
-    batteryInfo_.SetPluggedType(GetPluggedTypeInner());
-    batteryInfo_.SetChargeState(GetChargingStatusInner());
-    batteryInfo_.SetVoltage(GetVoltageInner());
-    batteryInfo_.SetTemperature(GetBatteryTemperatureInner());
-    batteryInfo_.SetHealthState(GetHealthStatusInner());
-    batteryInfo_.SetTotalEnergy(GetTotalEnergyInner());
-    batteryInfo_.SetCurAverage(GetCurrentAverageInner());
-    batteryInfo_.SetRemainEnergy(GetRemainEnergyInner());
-    batteryInfo_.SetPresent(GetPresentInner());
-    batteryInfo_.SetTechnology(GetTechnologyInner());
-    batteryInfo_.SetNowCurrent(GetNowCurrentInner());
-    batteryInfo_.SetChargeType(GetChargeType());
+    V2_0::BatteryInfo event;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        if (iBatteryInterface_ == nullptr) {
+            BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
+            return;
+        }
+        hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
+        if (iBatteryInterface_->GetBatteryInfo(event) != ERR_OK) {
+            BATTERY_HILOGE(FEATURE_BATT_INFO, "get initial battery info failed");
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> infoLock(infoMutex_);
+    uint32_t changedFields = ConvertingEvent(event);
+    // ConvertingEvent only queries the charge type when the charger changed
+    if ((changedFields & (BatteryInfo::FIELD_PLUGGED_TYPE | BatteryInfo::FIELD_CHARGE_STATE)) == 0) {
+        batteryInfo_.SetChargeType(GetChargeType());
+    }
+    if (!isMockUevent_) {
+        batteryInfo_.SetUevent("");
+    }
+    UpdateSnapshot(batteryInfo_);
+    startupStats_.Mark(BatteryStartupStats::INFO_LOADED);
     AddBootCommonEvents();
     HandleBatteryInfo();
 }
@@ -304,14 +443,22 @@ bool BatteryService::FillCommonEvent(std::string& ueventName, std::string& commo
         BATTERY_HILOGI(COMP_SVC, "don't need send common event, config is empty!");
         return false;
     }
+    // internal read, neither the permission check nor the ipc batch limit applies
+    std::vector<std::string> sceneNames;
     for (const auto& iter : commonEventConf) {
+        sceneNames.push_back(iter.sceneConfigName);
+    }
+    std::vector<std::string> results;
+    std::vector<int32_t> errors;
+    DoGetBatteryConfigs(sceneNames, results, errors);
+    for (size_t i = 0; i < commonEventConf.size(); i++) {
+        const auto& iter = commonEventConf[i];
         commonEventName = iter.eventName;
         ueventName = iter.uevent;
-        std::string result;
-        BatteryError error = GetBatteryConfigInner(iter.sceneConfigName, result);
-        if (error != BatteryError::ERR_OK) {
+        if (errors[i] != static_cast<int32_t>(BatteryError::ERR_OK)) {
             continue;
         }
+        const std::string& result = results[i];
         bool isEqual = iter.sceneConfigEqual;
         std::string configValue = iter.sceneConfigValue;
         ueventName += result;
@@ -323,46 +470,121 @@ bool BatteryService::FillCommonEvent(std::string& ueventName, std::string& commo
     return false;
 }
 
-void BatteryService::HandleBatteryInfo()
-{
-    BATTERY_HILOGI(FEATURE_BATT_INFO, "capacity=%{public}d, voltage=%{public}d, temperature=%{public}d, "
-        "healthState=%{public}d, pluggedType=%{public}d, pluggedMaxCurrent=%{public}d, "
-        "pluggedMaxVoltage=%{public}d, chargeState=%{public}d, chargeCounter=%{public}d, present=%{public}d, "
-        "technology=%{public}s, currNow=%{public}d, totalEnergy=%{public}d, curAverage=%{public}d, "
-        "remainEnergy=%{public}d, chargeType=%{public}d, event=%{public}s", batteryInfo_.GetCapacity(),
-        batteryInfo_.GetVoltage(), batteryInfo_.GetTemperature(), batteryInfo_.GetHealthState(),
-        batteryInfo_.GetPluggedType(), batteryInfo_.GetPluggedMaxCurrent(), batteryInfo_.GetPluggedMaxVoltage(),
-        batteryInfo_.GetChargeState(), batteryInfo_.GetChargeCounter(), batteryInfo_.IsPresent(),
-        batteryInfo_.GetTechnology().c_str(), batteryInfo_.GetNowCurrent(), batteryInfo_.GetTotalEnergy(),
-        batteryInfo_.GetCurAverage(), batteryInfo_.GetRemainEnergy(), batteryInfo_.GetChargeType(),
-        batteryInfo_.GetUevent().c_str());
-
-    batteryLight_.UpdateColor(batteryInfo_.GetChargeState(), batteryInfo_.GetCapacity());
-    WakeupDevice(batteryInfo_.GetPluggedType());
-    CalculateRemainingChargeTime(batteryInfo_.GetCapacity(), batteryInfo_.GetChargeState());
-
-    batteryNotify_->PublishEvents(batteryInfo_);
-    HandleTemperature(batteryInfo_.GetTemperature());
+void BatteryService::HandleBatteryInfo(uint32_t changedFields, bool deferBroadcast)
+{
+    // Every event goes to the binary log, the text line is rate limited (hidumper --eventlog decodes the ring)
+    eventLog_.Append(BatteryEventLog::SOURCE_EVENT, batteryInfo_, changedFields);
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    journal_.Append(now, batteryInfo_, changedFields);
+    BatteryHistory::Sample sample;
+    sample.time = now;
+    sample.capacity = batteryInfo_.GetCapacity();
+    sample.voltage = batteryInfo_.GetVoltage();
+    sample.current = batteryInfo_.GetNowCurrent();
+    sample.temperature = batteryInfo_.GetTemperature();
+    sample.chargeState = static_cast<int32_t>(batteryInfo_.GetChargeState());
+    history_.Append(sample);
+    int64_t bootTimeMs = BatteryStartupStats::GetBootTimeMs();
+    statsWindows_.Add(bootTimeMs,
+        { batteryInfo_.GetNowCurrent(), batteryInfo_.GetVoltage(), batteryInfo_.GetTemperature() });
+    energyIntegrator_.Update(bootTimeMs, batteryInfo_);
+    uint32_t suppressed = 0;
+    if (infoLogLimiter_.Allow(suppressed)) {
+        if (suppressed > 0) {
+            BATTERY_HILOGI(FEATURE_BATT_INFO, "%{public}u similar lines suppressed", suppressed);
+        }
+        BATTERY_HILOGI(FEATURE_BATT_INFO, "changed=0x%{public}x, capacity=%{public}d, voltage=%{public}d, "
+            "temperature=%{public}d, healthState=%{public}d, pluggedType=%{public}d, pluggedMaxCurrent=%{public}d, "
+            "pluggedMaxVoltage=%{public}d, chargeState=%{public}d, chargeCounter=%{public}d, present=%{public}d, "
+            "technology=%{public}s, currNow=%{public}d, totalEnergy=%{public}d, curAverage=%{public}d, "
+            "remainEnergy=%{public}d, chargeType=%{public}d, event=%{public}s", changedFields,
+            batteryInfo_.GetCapacity(), batteryInfo_.GetVoltage(), batteryInfo_.GetTemperature(),
+            batteryInfo_.GetHealthState(), batteryInfo_.GetPluggedType(), batteryInfo_.GetPluggedMaxCurrent(),
+            batteryInfo_.GetPluggedMaxVoltage(),
+            batteryInfo_.GetChargeState(), batteryInfo_.GetChargeCounter(), batteryInfo_.IsPresent(),
+            batteryInfo_.GetTechnology().c_str(), batteryInfo_.GetNowCurrent(), batteryInfo_.GetTotalEnergy(),
+            batteryInfo_.GetCurAverage(), batteryInfo_.GetRemainEnergy(), batteryInfo_.GetChargeType(),
+            batteryInfo_.GetUevent().c_str());
+    }
+
+    // Decision stage, completes before any light or common event work is started
+    PublishBatteryInfo();
+    if ((changedFields & (BatteryInfo::FIELD_TEMPERATURE | LOW_CAPACITY_FIELDS)) != 0) {
+        BatteryTraceScope trace(BatteryTraceStage::SHUTDOWN_CHECK);
+        if ((changedFields & BatteryInfo::FIELD_TEMPERATURE) != 0) {
+            HandleTemperature(batteryInfo_.GetTemperature());
+        }
+        if ((changedFields & LOW_CAPACITY_FIELDS) != 0) {
 #ifdef BATTERY_MANAGER_SET_LOW_CAPACITY_THRESHOLD
-    HandleCapacityExt(batteryInfo_.GetCapacity(), batteryInfo_.GetChargeState(), batteryInfo_.IsPresent());
+            HandleCapacityExt(batteryInfo_.GetCapacity(), batteryInfo_.GetChargeState(), batteryInfo_.IsPresent());
 #else
-    HandleCapacity(batteryInfo_.GetCapacity(), batteryInfo_.GetChargeState(), batteryInfo_.IsPresent());
+            HandleCapacity(batteryInfo_.GetCapacity(), batteryInfo_.GetChargeState(), batteryInfo_.IsPresent());
 #endif
+        }
+    }
+    HandleChargeSession(changedFields, now);
+    if ((changedFields & BatteryInfo::FIELD_PLUGGED_TYPE) != 0) {
+        BatteryTraceScope trace(BatteryTraceStage::WAKEUP);
+        WakeupDevice(batteryInfo_.GetPluggedType());
+    }
+    if ((changedFields & CHARGE_TIME_FIELDS) != 0 ||
+        batteryInfo_.GetChargeState() == BatteryChargeState::CHARGE_STATE_ENABLE) {
+        CalculateRemainingChargeTime(batteryInfo_);
+    }
+    if ((changedFields & DISCHARGE_TIME_FIELDS) != 0) {
+        CalculateRemainingDischargeTime(batteryInfo_);
+    }
     lastBatteryInfo_ = batteryInfo_;
+    NotifyListeners(changedFields);
+
+    // Broadcast stage, hdi pushes hand it to the utility qos lane of the pipeline
+    if (!deferBroadcast || eventPipeline_ == nullptr) {
+        HandleBroadcast(batteryInfo_, changedFields);
+        return;
+    }
+    eventPipeline_->PostBroadcast(batteryInfo_, changedFields);
+}
+
+void BatteryService::HandleBroadcast(BatteryInfo& info, uint32_t changedFields)
+{
+    std::lock_guard<std::mutex> broadcastLock(broadcastMutex_);
+    if ((changedFields & CHARGE_PROGRESS_FIELDS) != 0) {
+        BatteryTraceScope trace(BatteryTraceStage::LIGHT);
+        batteryLight_.UpdateColor(info.GetChargeState(), info.GetCapacity());
+    }
+    if (batteryNotify_ != nullptr) {
+        batteryNotify_->PublishEvents(info, changedFields);
+        MarkFirstChanged();
+    }
+}
+
+void BatteryService::MarkFirstChanged()
+{
+    if (!startupStats_.IsMarked(BatteryStartupStats::FIRST_CHANGED) &&
+        batteryNotify_->GetChangedEventStats().published > 0) {
+        startupStats_.Mark(BatteryStartupStats::FIRST_CHANGED);
+    }
 }
 
 bool BatteryService::RegisterHdiStatusListener()
 {
-    hdiServiceMgr_ = OHOS::HDI::ServiceManager::V1_0::IServiceManager::Get();
-    if (hdiServiceMgr_ == nullptr) {
-        BATTERY_HILOGW(COMP_SVC, "hdi service manager is nullptr, Try again after %{public}u second", RETRY_TIME);
-        FFRTTask retryTask = [this] {
-            return RegisterHdiStatusListener();
-        };
-        FFRTUtils::SubmitDelayTask(retryTask, RETRY_TIME, g_queue);
+    std::lock_guard<std::mutex> listenerLock(hdiListenerMutex_);
+    if (hdiServiceMgr_ != nullptr) {
+        return true;
+    }
+    sptr<OHOS::HDI::ServiceManager::V1_0::IServiceManager> hdiServiceMgr =
+        OHOS::HDI::ServiceManager::V1_0::IServiceManager::Get();
+    if (hdiServiceMgr == nullptr) {
+        // retried when samgr reports DEVICE_SERVICE_MANAGER_SA_ID
+        startupStats_.AddHdiListenerRetry();
+        BATTERY_HILOGW(COMP_SVC, "hdi service manager is nullptr, wait for it to be added");
         return false;
     }
 
+    if (hdiServStatListener_ != nullptr) {
+        return DoRegisterHdiStatusListener(hdiServiceMgr);
+    }
     hdiServStatListener_ = new HdiServiceStatusListener(HdiServiceStatusListener::StatusCallback(
         [this](const OHOS::HDI::ServiceManager::V1_0::ServiceStatus &status) {
             RETURN_IF(status.serviceName != BATTERY_HDI_NAME || status.deviceClass != DEVICE_CLASS_DEFAULT);
@@ -370,6 +592,7 @@ bool BatteryService::RegisterHdiStatusListener()
             std::lock_guard<std::shared_mutex> lock(mutex_);
             if (status.status == SERVIE_STATUS_START) {
                 FFRTTask task = [this] {
+                    startupStats_.Mark(BatteryStartupStats::HDI_READY);
                     (void)RegisterBatteryHdiCallback();
 #ifdef BATTERY_MANAGER_SET_LOW_CAPACITY_THRESHOLD
                     SetLowCapacityThreshold();
@@ -381,22 +604,34 @@ bool BatteryService::RegisterHdiStatusListener()
                 FFRTUtils::SubmitTask(task);
                 BATTERY_HILOGD(COMP_SVC, "battery interface service start");
             } else if (status.status == SERVIE_STATUS_STOP && iBatteryInterface_) {
+                hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
                 iBatteryInterface_->UnRegister();
                 iBatteryInterface_ = nullptr;
+                InvalidateSnapshot();
+                sceneConfigCache_.Clear();
                 BATTERY_HILOGW(COMP_SVC, "battery interface service stop, unregister interface");
             }
         }
     ));
+    return DoRegisterHdiStatusListener(hdiServiceMgr);
+}
 
-    int32_t status = hdiServiceMgr_->RegisterServiceStatusListener(hdiServStatListener_, DEVICE_CLASS_DEFAULT);
+bool BatteryService::DoRegisterHdiStatusListener(
+    const sptr<OHOS::HDI::ServiceManager::V1_0::IServiceManager>& hdiServiceMgr)
+{
+    int32_t status = hdiServiceMgr->RegisterServiceStatusListener(hdiServStatListener_, DEVICE_CLASS_DEFAULT);
     if (status != ERR_OK) {
-        BATTERY_HILOGW(COMP_SVC, "Register hdi failed, Try again after %{public}u second", RETRY_TIME);
+        // the manager is already up and samgr won't notify again, only this path still retries on a timer
+        startupStats_.AddHdiListenerRetry();
+        BATTERY_HILOGW(COMP_SVC, "Register hdi failed, Try again after %{public}u ms", RETRY_TIME);
         FFRTTask retryTask = [this] {
             return RegisterHdiStatusListener();
         };
         FFRTUtils::SubmitDelayTask(retryTask, RETRY_TIME, g_queue);
         return false;
     }
+    hdiServiceMgr_ = hdiServiceMgr;
+    startupStats_.Mark(BatteryStartupStats::HDI_LISTENER_REGISTERED);
     return true;
 }
 
@@ -408,15 +643,24 @@ void BatteryService::OnStop()
     ready_ = false;
     isBootCompleted_ = false;
 
+    {
+        std::lock_guard<std::mutex> listenerLock(hdiListenerMutex_);
+        if (hdiServiceMgr_ != nullptr) {
+            hdiServiceMgr_->UnregisterServiceStatusListener(hdiServStatListener_);
+            hdiServiceMgr_ = nullptr;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> infoLock(infoMutex_);
+        journal_.Close();
+    }
     std::lock_guard<std::shared_mutex> lock(mutex_);
     if (iBatteryInterface_ != nullptr) {
+        hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
         iBatteryInterface_->UnRegister();
         iBatteryInterface_ = nullptr;
     }
-    if (hdiServiceMgr_ != nullptr) {
-        hdiServiceMgr_->UnregisterServiceStatusListener(hdiServStatListener_);
-        hdiServiceMgr_ = nullptr;
-    }
+    InvalidateSnapshot();
     if (g_moduleMgr != nullptr) {
         ModuleMgrDestroy(g_moduleMgr);
         g_moduleMgr = nullptr;
@@ -482,10 +726,62 @@ void BatteryService::WakeupDevice(BatteryPluggedType pluggedType)
     g_lastPluggedType = pluggedType;
 }
 
+void BatteryService::HandleChargeSession(uint32_t changedFields, int64_t wallTimeMs)
+{
+    // runs before WakeupDevice records the new plugged type
+    int64_t timeMs = BatteryStartupStats::GetBootTimeMs();
+    if ((changedFields & BatteryInfo::FIELD_PLUGGED_TYPE) != 0) {
+        BatteryPluggedType pluggedType = batteryInfo_.GetPluggedType();
+        if (IsUnplugged(pluggedType)) {
+            chargeSessions_.End(timeMs, batteryInfo_);
+            return;
+        }
+        if (IsPlugged(pluggedType)) {
+            chargeSessions_.Begin(wallTimeMs, timeMs, batteryInfo_);
+            return;
+        }
+    }
+    chargeSessions_.Update(timeMs, batteryInfo_);
+}
+
+void BatteryService::NotifyListeners(uint32_t changedFields)
+{
+    // the listeners are served from their own queue, this only fills their pending slots
+    if (!listenerManager_.HasListeners()) {
+        return;
+    }
+    uint64_t sequence = LoadSnapshot()->seq;
+    int64_t timestamp = GetCurrentTime();
+    BatteryInfoSnapshot systemSnapshot;
+    FillSnapshot(batteryInfo_, true, sequence, timestamp, systemSnapshot);
+    BatteryInfoSnapshot publicSnapshot;
+    FillSnapshot(batteryInfo_, false, sequence, timestamp, publicSnapshot);
+    listenerManager_.Notify(changedFields, systemSnapshot, publicSnapshot);
+}
+
+void BatteryService::ScheduleJournalFlush()
+{
+    FFRTTask task = [this] {
+        // the journal serializes Flush with Close itself, appends on the event path are not blocked
+        // the chain ends once OnStop closed the journal
+        if (journal_.Flush()) {
+            ScheduleJournalFlush();
+        }
+    };
+    FFRTUtils::SubmitDelayTask(task, JOURNAL_FLUSH_INTERVAL_MS, g_queue);
+}
+
+void BatteryService::FlushJournal()
+{
+    // synchronous, the records are on the device when the shutdown is requested
+    journal_.Flush();
+}
+
 void BatteryService::HandleTemperature(int32_t temperature)
 {
     if (((temperature <= lowTemperature_) || (temperature >= highTemperature_)) &&
         (highTemperature_ != lowTemperature_)) {
+        FlushJournal();
         PowerMgrClient::GetInstance().ShutDownDevice("TemperatureOutOfRange");
     }
 }
@@ -500,6 +796,7 @@ void BatteryService::HandleCapacity(int32_t capacity, BatteryChargeState chargeS
         FFRTTask task = [&] {
             if (!IsInExtremePowerSaveMode()) {
                 BATTERY_HILOGI(COMP_SVC, "HandleCapacity begin to shutdown");
+                FlushJournal();
                 PowerMgrClient::GetInstance().ShutDownDevice("LowCapacity");
             }
         };
@@ -519,6 +816,7 @@ void BatteryService::HandleCapacity(int32_t capacity, BatteryChargeState chargeS
 void BatteryService::DoHibernateOrShutdown()
 {
     if (!IsInExtremePowerSaveMode()) {
+        FlushJournal();
         if (isHibernateEnable_) {
             BATTERY_HILOGI(COMP_SVC, "HandleCapacityExt begin to hibernate");
             PowerMgrClient::GetInstance().Hibernate(false, "LowCapacity");
@@ -662,7 +960,11 @@ int32_t BatteryService::GetCapacityInner()
 {
     if (isMockCapacity_) {
         BATTERY_HILOGD(FEATURE_BATT_INFO, "Return mock battery capacity");
-        return batteryInfo_.GetCapacity();
+        return LoadBatteryInfo()->GetCapacity();
+    }
+    auto snapshot = AcquireSnapshot();
+    if (snapshot != nullptr) {
+        return snapshot->GetCapacity();
     }
     std::shared_lock<std::shared_mutex> lock(mutex_);
     int32_t capacity = BATTERY_FULL_CAPACITY;
@@ -670,6 +972,7 @@ int32_t BatteryService::GetCapacityInner()
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
         return capacity;
     }
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetCapacity(capacity);
     return capacity;
 }
@@ -682,7 +985,9 @@ bool BatteryService::ChangePath(const std::string path)
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
         return false;
     }
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->ChangePath(path);
+    InvalidateSnapshot();
     return true;
 }
 
@@ -696,17 +1001,43 @@ void BatteryService::SetLowCapacityThreshold()
     }
     BATTERY_HILOGI(FEATURE_BATT_INFO, "set low capacity thres: shutdownCapacityThreshold_ = %{public}d",
         shutdownCapacityThreshold_);
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->SetBatteryConfig(thers, std::to_string(shutdownCapacityThreshold_));
+    sceneConfigCache_.Invalidate(thers);
 }
 #endif
 
 BatteryError BatteryService::SetBatteryConfigInner(const std::string& sceneName, const std::string& value)
 {
-    if (!Permission::IsSystem() || !Permission::IsNativePermissionGranted("ohos.permission.POWER_OPTIMIZATION")) {
+    if (!permissionCache_.IsSystem() || !permissionCache_.IsNativePermissionGranted(POWER_OPTIMIZATION_PERMISSION)) {
         BATTERY_HILOGI(FEATURE_BATT_INFO, "SetBatteryConfig failed, System permission intercept");
         return BatteryError::ERR_SYSTEM_API_DENIED;
     }
 
+    return DoSetBatteryConfig(sceneName, value);
+}
+
+BatteryError BatteryService::SetBatteryConfigsInner(const std::vector<std::string>& sceneNames,
+    const std::vector<std::string>& values, std::vector<int32_t>& batteryErrs)
+{
+    batteryErrs.clear();
+    if (!permissionCache_.IsSystem() || !permissionCache_.IsNativePermissionGranted(POWER_OPTIMIZATION_PERMISSION)) {
+        BATTERY_HILOGI(FEATURE_BATT_INFO, "SetBatteryConfigs failed, System permission intercept");
+        return BatteryError::ERR_SYSTEM_API_DENIED;
+    }
+    if (sceneNames.size() != values.size() || sceneNames.size() > MAX_BATTERY_CONFIG_BATCH) {
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "SetBatteryConfigs failed, size:%{public}zu values:%{public}zu",
+            sceneNames.size(), values.size());
+        return BatteryError::ERR_PARAM_INVALID;
+    }
+    for (size_t i = 0; i < sceneNames.size(); i++) {
+        batteryErrs.push_back(static_cast<int32_t>(DoSetBatteryConfig(sceneNames[i], values[i])));
+    }
+    return BatteryError::ERR_OK;
+}
+
+BatteryError BatteryService::DoSetBatteryConfig(const std::string& sceneName, const std::string& value)
+{
     BATTERY_HILOGI(FEATURE_BATT_INFO, "Enter SetBatteryConfig sceneName:%{public}s value:%{public}s",
         sceneName.c_str(), value.c_str());
     std::shared_lock<std::shared_mutex> lock(mutex_);
@@ -714,52 +1045,95 @@ BatteryError BatteryService::SetBatteryConfigInner(const std::string& sceneName,
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
         return BatteryError::ERR_FAILURE;
     }
-    return iBatteryInterface_->SetBatteryConfig(sceneName, value) == ERR_OK ?
-        BatteryError::ERR_OK : BatteryError::ERR_FAILURE;
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
+    int32_t ret = iBatteryInterface_->SetBatteryConfig(sceneName, value);
+    // write-through, the next read fetches the value the hdi actually applied
+    sceneConfigCache_.Invalidate(sceneName);
+    return ret == ERR_OK ? BatteryError::ERR_OK : BatteryError::ERR_FAILURE;
 }
 
 BatteryError BatteryService::GetBatteryConfigInner(const std::string& sceneName, std::string& result)
 {
-    if (!Permission::IsSystem()) {
+    if (!permissionCache_.IsSystem()) {
         BATTERY_HILOGI(FEATURE_BATT_INFO, "GetBatteryConfig failed, System permission intercept");
         return BatteryError::ERR_SYSTEM_API_DENIED;
     }
 
     BATTERY_HILOGD(FEATURE_BATT_INFO, "Enter GetBatteryConfig");
+    return DoGetBatteryConfig(sceneName, result);
+}
+
+BatteryError BatteryService::GetBatteryConfigsInner(const std::vector<std::string>& sceneNames,
+    std::vector<std::string>& results, std::vector<int32_t>& batteryErrs)
+{
+    results.clear();
+    batteryErrs.clear();
+    if (!permissionCache_.IsSystem()) {
+        BATTERY_HILOGI(FEATURE_BATT_INFO, "GetBatteryConfigs failed, System permission intercept");
+        return BatteryError::ERR_SYSTEM_API_DENIED;
+    }
+    DoGetBatteryConfigs(sceneNames, results, batteryErrs);
+    return BatteryError::ERR_OK;
+}
+
+void BatteryService::DoGetBatteryConfigs(const std::vector<std::string>& sceneNames,
+    std::vector<std::string>& results, std::vector<int32_t>& batteryErrs)
+{
+    results.assign(sceneNames.size(), "");
+    batteryErrs.clear();
+    for (size_t i = 0; i < sceneNames.size(); i++) {
+        batteryErrs.push_back(static_cast<int32_t>(DoGetBatteryConfig(sceneNames[i], results[i])));
+    }
+}
+
+BatteryError BatteryService::DoGetBatteryConfig(const std::string& sceneName, std::string& result)
+{
+    uint64_t generation = 0;
+    if (sceneConfigCache_.GetValue(sceneName, result, generation)) {
+        return BatteryError::ERR_OK;
+    }
     std::shared_lock<std::shared_mutex> lock(mutex_);
     if (iBatteryInterface_ == nullptr) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
         return BatteryError::ERR_FAILURE;
     }
 
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     int32_t ret = iBatteryInterface_->GetBatteryConfig(sceneName, result);
     if (ret != ERR_OK) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "get charge config failed, key:%{public}s", sceneName.c_str());
         return BatteryError::ERR_FAILURE;
     }
+    sceneConfigCache_.PutValue(sceneName, result, generation);
 
     return BatteryError::ERR_OK;
 }
 
 BatteryError BatteryService::IsBatteryConfigSupportedInner(const std::string& sceneName, bool& result)
 {
-    if (!Permission::IsSystem()) {
+    if (!permissionCache_.IsSystem()) {
         BATTERY_HILOGI(FEATURE_BATT_INFO, "IsBatteryConfigSupported failed, System permission intercept");
         return BatteryError::ERR_SYSTEM_API_DENIED;
     }
 
     BATTERY_HILOGD(FEATURE_BATT_INFO, "Enter IsBatteryConfigSupported");
+    uint64_t generation = 0;
+    if (sceneConfigCache_.GetSupported(sceneName, result, generation)) {
+        return BatteryError::ERR_OK;
+    }
     std::shared_lock<std::shared_mutex> lock(mutex_);
     if (iBatteryInterface_ == nullptr) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
         return BatteryError::ERR_FAILURE;
     }
 
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     int32_t ret = iBatteryInterface_->IsBatteryConfigSupported(sceneName, result);
     if (ret != ERR_OK) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "get support charge config failed, key:%{public}s", sceneName.c_str());
         return BatteryError::ERR_FAILURE;
     }
+    sceneConfigCache_.PutSupported(sceneName, result, generation);
     return BatteryError::ERR_OK;
 }
 
@@ -767,7 +1141,11 @@ BatteryChargeState BatteryService::GetChargingStatusInner()
 {
     if (isMockUnplugged_) {
         BATTERY_HILOGD(FEATURE_BATT_INFO, "Return mock charge status");
-        return batteryInfo_.GetChargeState();
+        return LoadBatteryInfo()->GetChargeState();
+    }
+    auto snapshot = AcquireSnapshot();
+    if (snapshot != nullptr) {
+        return snapshot->GetChargeState();
     }
     std::shared_lock<std::shared_mutex> lock(mutex_);
     V2_0::BatteryChargeState chargeState = V2_0::BatteryChargeState(0);
@@ -775,6 +1153,7 @@ BatteryChargeState BatteryService::GetChargingStatusInner()
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
         return BatteryChargeState(chargeState);
     }
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetChargeState(chargeState);
     return BatteryChargeState(chargeState);
 }
@@ -782,6 +1161,10 @@ BatteryChargeState BatteryService::GetChargingStatusInner()
 BatteryHealthState BatteryService::GetHealthStatusInner()
 {
     BATTERY_HILOGD(FEATURE_BATT_INFO, "Enter");
+    auto snapshot = AcquireSnapshot();
+    if (snapshot != nullptr) {
+        return snapshot->GetHealthState();
+    }
     std::shared_lock<std::shared_mutex> lock(mutex_);
     V2_0::BatteryHealthState healthState = V2_0::BatteryHealthState(0);
     if (iBatteryInterface_ == nullptr) {
@@ -789,6 +1172,7 @@ BatteryHealthState BatteryService::GetHealthStatusInner()
         return BatteryHealthState(healthState);
     }
 
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetHealthState(healthState);
     return BatteryHealthState(healthState);
 }
@@ -797,7 +1181,11 @@ BatteryPluggedType BatteryService::GetPluggedTypeInner()
 {
     if (isMockUnplugged_) {
         BATTERY_HILOGD(FEATURE_BATT_INFO, "Return mock plugged type");
-        return batteryInfo_.GetPluggedType();
+        return LoadBatteryInfo()->GetPluggedType();
+    }
+    auto snapshot = AcquireSnapshot();
+    if (snapshot != nullptr) {
+        return snapshot->GetPluggedType();
     }
     std::shared_lock<std::shared_mutex> lock(mutex_);
     V2_0::BatteryPluggedType pluggedType = V2_0::BatteryPluggedType(0);
@@ -805,24 +1193,34 @@ BatteryPluggedType BatteryService::GetPluggedTypeInner()
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
         return BatteryPluggedType(pluggedType);
     }
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetPluggedType(pluggedType);
     return BatteryPluggedType(pluggedType);
 }
 
 int32_t BatteryService::GetVoltageInner()
 {
+    auto snapshot = AcquireSnapshot();
+    if (snapshot != nullptr) {
+        return snapshot->GetVoltage();
+    }
     std::shared_lock<std::shared_mutex> lock(mutex_);
     if (iBatteryInterface_ == nullptr) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
         return ERR_NO_INIT;
     }
     int32_t voltage = INVALID_BATT_INT_VALUE;
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetVoltage(voltage);
     return voltage;
 }
 
 bool BatteryService::GetPresentInner()
 {
+    auto snapshot = AcquireSnapshot();
+    if (snapshot != nullptr) {
+        return snapshot->IsPresent();
+    }
     std::shared_lock<std::shared_mutex> lock(mutex_);
     bool present = false;
     if (iBatteryInterface_ == nullptr) {
@@ -830,12 +1228,17 @@ bool BatteryService::GetPresentInner()
         return present;
     }
 
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetPresent(present);
     return present;
 }
 
 std::string BatteryService::GetTechnologyInner()
 {
+    auto snapshot = AcquireSnapshot();
+    if (snapshot != nullptr) {
+        return snapshot->GetTechnology();
+    }
     std::shared_lock<std::shared_mutex> lock(mutex_);
     if (iBatteryInterface_ == nullptr) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
@@ -843,18 +1246,24 @@ std::string BatteryService::GetTechnologyInner()
     }
 
     std::string technology;
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetTechnology(technology);
     return technology;
 }
 
 int32_t BatteryService::GetBatteryTemperatureInner()
 {
+    auto snapshot = AcquireSnapshot();
+    if (snapshot != nullptr) {
+        return snapshot->GetTemperature();
+    }
     std::shared_lock<std::shared_mutex> lock(mutex_);
     if (iBatteryInterface_ == nullptr) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
-        return batteryInfo_.GetTemperature();
+        return LoadBatteryInfo()->GetTemperature();
     }
     int32_t temperature = INVALID_BATT_INT_VALUE;
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetTemperature(temperature);
     return temperature;
 }
@@ -862,39 +1271,54 @@ int32_t BatteryService::GetBatteryTemperatureInner()
 int32_t BatteryService::GetTotalEnergyInner()
 {
     int32_t totalEnergy = INVALID_BATT_INT_VALUE;
-    if (!Permission::IsSystem()) {
+    if (!permissionCache_.IsSystem()) {
         BATTERY_HILOGD(FEATURE_BATT_INFO, "GetTotalEnergy totalEnergy: %{public}d", totalEnergy);
         return totalEnergy;
     }
+    auto snapshot = AcquireSnapshot();
+    if (snapshot != nullptr) {
+        return snapshot->GetTotalEnergy();
+    }
     std::shared_lock<std::shared_mutex> lock(mutex_);
     if (iBatteryInterface_ == nullptr) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
-        return batteryInfo_.GetTotalEnergy();
+        return LoadBatteryInfo()->GetTotalEnergy();
     }
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetTotalEnergy(totalEnergy);
     return totalEnergy;
 }
 
 int32_t BatteryService::GetCurrentAverageInner()
 {
+    auto snapshot = AcquireSnapshot();
+    if (snapshot != nullptr) {
+        return snapshot->GetCurAverage();
+    }
     std::shared_lock<std::shared_mutex> lock(mutex_);
     if (iBatteryInterface_ == nullptr) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
-        return batteryInfo_.GetCurAverage();
+        return LoadBatteryInfo()->GetCurAverage();
     }
     int32_t curAverage = INVALID_BATT_INT_VALUE;
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetCurrentAverage(curAverage);
     return curAverage;
 }
 
 int32_t BatteryService::GetNowCurrentInner()
 {
+    auto snapshot = AcquireSnapshot();
+    if (snapshot != nullptr) {
+        return snapshot->GetNowCurrent();
+    }
     int32_t nowCurr = INVALID_BATT_INT_VALUE;
     std::shared_lock<std::shared_mutex> lock(mutex_);
     if (iBatteryInterface_ == nullptr) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
-        return batteryInfo_.GetNowCurrent();
+        return LoadBatteryInfo()->GetNowCurrent();
     }
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetCurrentNow(nowCurr);
     return nowCurr;
 }
@@ -902,19 +1326,202 @@ int32_t BatteryService::GetNowCurrentInner()
 int32_t BatteryService::GetRemainEnergyInner()
 {
     int32_t remainEnergy = INVALID_BATT_INT_VALUE;
-    if (!Permission::IsSystem()) {
+    if (!permissionCache_.IsSystem()) {
         BATTERY_HILOGD(FEATURE_BATT_INFO, "GetRemainEnergy remainEnergy: %{public}d", remainEnergy);
         return remainEnergy;
     }
+    auto snapshot = AcquireSnapshot();
+    if (snapshot != nullptr) {
+        return snapshot->GetRemainEnergy();
+    }
     std::shared_lock<std::shared_mutex> lock(mutex_);
     if (iBatteryInterface_ == nullptr) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
-        return batteryInfo_.GetRemainEnergy();
+        return LoadBatteryInfo()->GetRemainEnergy();
     }
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetRemainEnergy(remainEnergy);
     return remainEnergy;
 }
 
+BatteryEventPipeline::Stats BatteryService::GetEventStats()
+{
+    if (eventPipeline_ == nullptr) {
+        return BatteryEventPipeline::Stats();
+    }
+    return eventPipeline_->GetStats();
+}
+
+int32_t BatteryService::OnRemoteRequest(uint32_t code, MessageParcel& data, MessageParcel& reply,
+    MessageOption& option)
+{
+    auto start = std::chrono::steady_clock::now();
+    int32_t ret = BatterySrvStub::OnRemoteRequest(code, data, reply, option);
+    int64_t latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    ipcStats_.Record(code, IPCSkeleton::GetCallingUid(), latencyUs);
+    return ret;
+}
+
+BatteryIpcStats& BatteryService::GetIpcStats()
+{
+    return ipcStats_;
+}
+
+const BatteryEventLog& BatteryService::GetEventLog() const
+{
+    return eventLog_;
+}
+
+const BatteryHistory& BatteryService::GetHistory() const
+{
+    return history_;
+}
+
+const BatteryChargeSessionStats& BatteryService::GetChargeSessionStats() const
+{
+    return chargeSessions_;
+}
+
+BatteryListenerManager::Stats BatteryService::GetListenerStats()
+{
+    return listenerManager_.GetStats();
+}
+
+const BatteryStartupStats& BatteryService::GetStartupStats() const
+{
+    return startupStats_;
+}
+
+BatterySceneConfigCache::Stats BatteryService::GetSceneConfigCacheStats()
+{
+    return sceneConfigCache_.GetStats();
+}
+
+BatteryPermissionCache::Stats BatteryService::GetPermissionCacheStats()
+{
+    return permissionCache_.GetStats();
+}
+
+BatteryNotify::ChangedEventStats BatteryService::GetChangedEventStats()
+{
+    if (batteryNotify_ == nullptr) {
+        return BatteryNotify::ChangedEventStats();
+    }
+    return batteryNotify_->GetChangedEventStats();
+}
+
+std::shared_ptr<const BatteryService::SnapshotEntry> BatteryService::LoadSnapshot() const
+{
+    return snapshot_.Load();
+}
+
+bool BatteryService::IsSnapshotFresh(const std::shared_ptr<const SnapshotEntry>& entry) const
+{
+    return (entry->info != nullptr) && ((GetCurrentTime() - entry->time) <= snapshotMaxAge_);
+}
+
+std::shared_ptr<const BatteryService::SnapshotEntry> BatteryService::AcquireSnapshotEntry()
+{
+    if (snapshotMaxAge_ <= 0) {
+        return nullptr;
+    }
+    auto entry = LoadSnapshot();
+    if (IsSnapshotFresh(entry)) {
+        return entry;
+    }
+    return RefreshSnapshot();
+}
+
+std::shared_ptr<const BatteryInfo> BatteryService::AcquireSnapshot()
+{
+    auto entry = AcquireSnapshotEntry();
+    return (entry == nullptr) ? nullptr : entry->info;
+}
+
+std::shared_ptr<const BatteryService::SnapshotEntry> BatteryService::RefreshSnapshot()
+{
+    // Only one caller goes to the hdi, the others wait and take its result
+    std::lock_guard<std::mutex> refreshLock(snapshotRefreshMutex_);
+    auto current = LoadSnapshot();
+    if (IsSnapshotFresh(current)) {
+        return current;
+    }
+    std::shared_ptr<BatteryInfo> info = std::make_shared<BatteryInfo>();
+    if (current->info != nullptr) {
+        *info = *current->info;
+    }
+
+    int64_t fetchTime = GetCurrentTime();
+    if (!FetchBatteryInfo(*info)) {
+        return nullptr;
+    }
+
+    auto entry = std::make_shared<SnapshotEntry>();
+    entry->info = info;
+    entry->time = fetchTime;
+    if (!StoreSnapshot(entry, true)) {
+        // A sample pushed while the hdi was queried is newer than ours
+        current = LoadSnapshot();
+        return (current->info != nullptr) ? current : nullptr;
+    }
+    return entry;
+}
+
+bool BatteryService::StoreSnapshot(std::shared_ptr<SnapshotEntry> entry, bool onlyIfNewer)
+{
+    return snapshot_.Update([&entry, onlyIfNewer](const std::shared_ptr<const SnapshotEntry>& current) {
+        if (onlyIfNewer && current->time > entry->time) {
+            return std::shared_ptr<const SnapshotEntry>(nullptr);
+        }
+        // an invalidated entry (time 0) carries no sample and keeps the sequence
+        entry->seq = (entry->time == 0) ? current->seq : current->seq + 1;
+        return std::shared_ptr<const SnapshotEntry>(entry);
+    });
+}
+
+bool BatteryService::FetchBatteryInfo(BatteryInfo& info)
+{
+    V2_0::BatteryInfo event;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (iBatteryInterface_ == nullptr) {
+        BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
+        return false;
+    }
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
+    if (iBatteryInterface_->GetBatteryInfo(event) != ERR_OK) {
+        BATTERY_HILOGE(FEATURE_BATT_INFO, "get battery info failed");
+        return false;
+    }
+    FillBatteryInfo(event, info);
+    return true;
+}
+
+void BatteryService::UpdateSnapshot(const BatteryInfo& info)
+{
+    auto entry = std::make_shared<SnapshotEntry>();
+    if (snapshotMaxAge_ > 0) {
+        entry->info = std::make_shared<const BatteryInfo>(info);
+    }
+    entry->time = GetCurrentTime();
+    (void)StoreSnapshot(entry, false);
+}
+
+void BatteryService::InvalidateSnapshot()
+{
+    (void)StoreSnapshot(std::make_shared<SnapshotEntry>(), false);
+}
+
+std::shared_ptr<const BatteryInfo> BatteryService::LoadBatteryInfo() const
+{
+    return publishedInfo_.Load();
+}
+
+void BatteryService::PublishBatteryInfo()
+{
+    publishedInfo_.Store(std::make_shared<const BatteryInfo>(batteryInfo_));
+}
+
 ChargeType BatteryService::GetChargeType()
 {
     std::shared_lock<std::shared_mutex> lock(mutex_);
@@ -924,90 +1531,172 @@ ChargeType BatteryService::GetChargeType()
         return ChargeType(chargeType);
     }
 
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetChargeType(chargeType);
     return ChargeType(chargeType);
 }
 
-void BatteryService::CalculateRemainingChargeTime(int32_t capacity, BatteryChargeState chargeState)
+void BatteryService::CalculateRemainingChargeTime(const BatteryInfo& info)
 {
-    if (capacity > BATTERY_FULL_CAPACITY) {
-        BATTERY_HILOGE(FEATURE_BATT_INFO, "capacity error");
-        return;
-    }
+    // boot time keeps counting while the device sleeps on the charger
+    chargeTimeEstimator_.Update(BatteryStartupStats::GetBootTimeMs(), info);
+    const BatteryChargeTimeEstimator::Estimate& estimate = chargeTimeEstimator_.GetEstimate();
+    remainTime_.store(estimate.remainingMs, std::memory_order_relaxed);
+    remainTimeConfidence_.store(estimate.confidence, std::memory_order_relaxed);
+}
 
-    if (chargeState != BatteryChargeState::CHARGE_STATE_ENABLE) {
-        remainTime_ = 0;
-        chargeFlag_ = false;
-        return;
-    }
+void BatteryService::CalculateRemainingDischargeTime(const BatteryInfo& info)
+{
+    dischargeTimeEstimator_.Update(BatteryStartupStats::GetBootTimeMs(), info);
+    remainDischargeTime_.store(dischargeTimeEstimator_.GetRemainingMs(), std::memory_order_relaxed);
+}
 
-    if (!chargeFlag_) {
-        lastCapacity_ = capacity;
-        lastTime_ = GetCurrentTime();
-        chargeFlag_ = true;
+int64_t BatteryService::GetRemainingChargeTimeInner()
+{
+    if (!permissionCache_.IsSystem()) {
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "system permission denied.");
+        return INVALID_REMAINING_CHARGE_TIME_VALUE;
     }
+    return remainTime_.load(std::memory_order_relaxed);
+}
 
-    if (capacity < lastCapacity_) {
-        lastCapacity_ = capacity;
+int64_t BatteryService::GetRemainingDischargeTimeInner()
+{
+    // derived from the remaining energy, so it is system only like GetRemainEnergy
+    if (!permissionCache_.IsSystem()) {
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "system permission denied.");
+        return INVALID_REMAINING_CHARGE_TIME_VALUE;
     }
+    return remainDischargeTime_.load(std::memory_order_relaxed);
+}
 
-    if (((capacity - lastCapacity_) >= 1) && (lastCapacity_ >= 0) && chargeFlag_) {
-        int64_t onceTime = (GetCurrentTime() - lastTime_) / (capacity - lastCapacity_);
-        remainTime_ = (BATTERY_FULL_CAPACITY - capacity) * onceTime;
-        lastCapacity_ = capacity;
-        lastTime_ = GetCurrentTime();
+BatteryCapacityLevel BatteryService::GetCapacityLevelInner()
+{
+    return GetCapacityLevelByCapacity(GetCapacityInner());
+}
+
+BatteryCapacityLevel BatteryService::GetCapacityLevelByCapacity(int32_t capacity)
+{
+    return GetSocTable()->Lookup(capacity).level;
+}
+
+std::shared_ptr<const BatterySocTable> BatteryService::GetSocTable() const
+{
+    return socTable_.Load();
+}
+
+void BatteryService::BuildSocTable()
+{
+    BatterySocTable::Thresholds thresholds;
+    thresholds.shutdown = shutdownCapacityThreshold_;
+    thresholds.critical = criticalCapacityThreshold_;
+    thresholds.warning = warningCapacityThreshold_;
+    thresholds.low = lowCapacityThreshold_;
+    thresholds.normal = normalCapacityThreshold_;
+    thresholds.high = highCapacityThreshold_;
+    thresholds.full = fullCapacityThreshold_;
+    auto& batteryConfig = BatteryConfig::GetInstance();
+    int32_t lowCapacity = batteryConfig.GetInt("soc.low", BatterySocTable::DEFAULT_LOW_CAPACITY);
+    BATTERY_HILOGI(COMP_SVC, "Low broadcast power=%{public}d", lowCapacity);
+
+    auto table = std::make_shared<BatterySocTable>();
+    table->Build(thresholds, lowCapacity, batteryConfig.GetLightConf());
+    socTable_.Store(table);
+    batteryLight_.SetSocTable(table);
+}
+
+BatteryError BatteryService::GetBatteryStatsInner(int32_t windowSeconds, BatteryWindowStats& stats)
+{
+    if (!statsWindows_.Get(windowSeconds, BatteryStartupStats::GetBootTimeMs(), stats)) {
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "unsupported stats window %{public}d", windowSeconds);
+        return BatteryError::ERR_PARAM_INVALID;
     }
+    return BatteryError::ERR_OK;
 }
 
-int64_t BatteryService::GetRemainingChargeTimeInner()
+BatteryError BatteryService::GetChargeSessionsInner(BatteryChargeSessions& sessions)
 {
-    if (!Permission::IsSystem()) {
-        BATTERY_HILOGW(FEATURE_BATT_INFO, "system permission denied.");
-        return INVALID_REMAINING_CHARGE_TIME_VALUE;
+    if (!permissionCache_.IsSystem()) {
+        BATTERY_HILOGI(FEATURE_BATT_INFO, "GetChargeSessions failed, System permission intercept");
+        return BatteryError::ERR_SYSTEM_API_DENIED;
     }
-    return remainTime_;
+    sessions.SetSessions(chargeSessions_.GetSessions());
+    return BatteryError::ERR_OK;
 }
 
-bool IsCapacityLevelDefined(int32_t capacityThreshold)
+BatteryError BatteryService::GetEnergyCountersInner(BatteryEnergyCounters& counters)
 {
-    return capacityThreshold != INVALID_BATT_INT_VALUE;
+    if (!permissionCache_.IsSystem()) {
+        BATTERY_HILOGI(FEATURE_BATT_INFO, "GetEnergyCounters failed, System permission intercept");
+        return BatteryError::ERR_SYSTEM_API_DENIED;
+    }
+    counters.SetCounters(energyIntegrator_.GetCounters(BatteryStartupStats::GetBootTimeMs()));
+    return BatteryError::ERR_OK;
+}
+
+BatteryError BatteryService::GetBatteryInfoSnapshotInner(BatteryInfoSnapshot& snapshot)
+{
+    BatteryInfo info;
+    int64_t timestamp = GetCurrentTime();
+    uint64_t sequence = 0;
+    std::shared_ptr<const BatteryInfo> current = LoadBatteryInfo();
+    auto cached = AcquireSnapshotEntry();
+    if (cached != nullptr) {
+        info = *cached->info;
+        timestamp = cached->time;
+        sequence = cached->seq;
+    } else {
+        if (!FetchBatteryInfo(info)) {
+            return BatteryError::ERR_FAILURE;
+        }
+        info.SetChargeType(current->GetChargeType());
+        sequence = LoadSnapshot()->seq;
+    }
+
+    if (isMockCapacity_) {
+        info.SetCapacity(current->GetCapacity());
+    }
+    if (isMockUnplugged_) {
+        info.SetPluggedType(current->GetPluggedType());
+        info.SetPluggedMaxCurrent(current->GetPluggedMaxCurrent());
+        info.SetPluggedMaxVoltage(current->GetPluggedMaxVoltage());
+        info.SetChargeState(current->GetChargeState());
+    }
+    FillSnapshot(info, permissionCache_.IsSystem(), sequence, timestamp, snapshot);
+    return BatteryError::ERR_OK;
 }
 
-bool BatteryService::CapacityLevelCompare(int32_t capacity, int32_t minCapacity, int32_t maxCapacity)
+void BatteryService::FillSnapshot(BatteryInfo info, bool isSystem, uint64_t sequence, int64_t timestamp,
+    BatteryInfoSnapshot& snapshot)
 {
-    if (IsCapacityLevelDefined(maxCapacity) && capacity > minCapacity && capacity <= maxCapacity) {
-        return true;
+    int64_t remainingChargeTime = remainTime_.load(std::memory_order_relaxed);
+    int32_t remainingChargeTimeConfidence = remainTimeConfidence_.load(std::memory_order_relaxed);
+    if (!isSystem) {
+        info.SetTotalEnergy(INVALID_BATT_INT_VALUE);
+        info.SetRemainEnergy(INVALID_BATT_INT_VALUE);
+        remainingChargeTime = INVALID_REMAINING_CHARGE_TIME_VALUE;
+        remainingChargeTimeConfidence = 0;
     }
-    return false;
+    info.SetUevent("");
+
+    snapshot.SetInfo(info);
+    snapshot.SetCapacityLevel(GetCapacityLevelByCapacity(info.GetCapacity()));
+    snapshot.SetRemainingChargeTime(remainingChargeTime);
+    snapshot.SetRemainingChargeTimeConfidence(remainingChargeTimeConfidence);
+    snapshot.SetSequence(sequence);
+    snapshot.SetTimestamp(timestamp);
 }
 
-BatteryCapacityLevel BatteryService::GetCapacityLevelInner()
+BatteryError BatteryService::RegisterBatteryListenerInner(const sptr<IBatteryListener>& listener,
+    uint32_t fieldMask, int64_t minIntervalMs)
 {
-    BatteryCapacityLevel batteryCapacityLevel = BatteryCapacityLevel::LEVEL_NONE;
-    int32_t capacity = GetCapacityInner();
-    if (shutdownCapacityThreshold_ <= 0 || criticalCapacityThreshold_ <= shutdownCapacityThreshold_ ||
-        warningCapacityThreshold_ <= criticalCapacityThreshold_ ||
-        lowCapacityThreshold_ <= warningCapacityThreshold_ ||
-        normalCapacityThreshold_ <= lowCapacityThreshold_ || highCapacityThreshold_ <= normalCapacityThreshold_ ||
-        fullCapacityThreshold_ <= highCapacityThreshold_) {
-        BATTERY_HILOGE(FEATURE_BATT_INFO, "capacityThreshold err");
-    }
-    if (CapacityLevelCompare(capacity, INVALID_BATT_INT_VALUE, shutdownCapacityThreshold_)) {
-        batteryCapacityLevel = BatteryCapacityLevel::LEVEL_SHUTDOWN;
-    } else if (CapacityLevelCompare(capacity, shutdownCapacityThreshold_, criticalCapacityThreshold_)) {
-        batteryCapacityLevel = BatteryCapacityLevel::LEVEL_CRITICAL;
-    } else if (CapacityLevelCompare(capacity, criticalCapacityThreshold_, warningCapacityThreshold_)) {
-        batteryCapacityLevel = BatteryCapacityLevel::LEVEL_WARNING;
-    } else if (CapacityLevelCompare(capacity, warningCapacityThreshold_, lowCapacityThreshold_)) {
-        batteryCapacityLevel = BatteryCapacityLevel::LEVEL_LOW;
-    } else if (CapacityLevelCompare(capacity, lowCapacityThreshold_, normalCapacityThreshold_)) {
-        batteryCapacityLevel = BatteryCapacityLevel::LEVEL_NORMAL;
-    } else if (CapacityLevelCompare(capacity, normalCapacityThreshold_, highCapacityThreshold_)) {
-        batteryCapacityLevel = BatteryCapacityLevel::LEVEL_HIGH;
-    } else if (CapacityLevelCompare(capacity, highCapacityThreshold_, fullCapacityThreshold_)) {
-        batteryCapacityLevel = BatteryCapacityLevel::LEVEL_FULL;
-    }
-    return batteryCapacityLevel;
+    return listenerManager_.Register(listener, fieldMask, minIntervalMs, IPCSkeleton::GetCallingPid(),
+        permissionCache_.IsSystem());
+}
+
+BatteryError BatteryService::UnregisterBatteryListenerInner(const sptr<IBatteryListener>& listener)
+{
+    return listenerManager_.Unregister(listener);
 }
 
 int32_t BatteryService::Dump(int32_t fd, const std::vector<std::u16string> &args)
@@ -1015,7 +1704,7 @@ int32_t BatteryService::Dump(int32_t fd, const std::vector<std::u16string> &args
     if (!isBootCompleted_) {
         return ERR_NO_INIT;
     }
-    if (!Permission::IsSystem()) {
+    if (!permissionCache_.IsSystem()) {
         return ERR_PERMISSION_DENIED;
     }
     BatteryDump& batteryDump = BatteryDump::GetInstance();
@@ -1028,7 +1717,16 @@ int32_t BatteryService::Dump(int32_t fd, const std::vector<std::u16string> &args
     bool mockedCapacity = batteryDump.MockCapacity(fd, g_service, args);
     bool mockedUevent = batteryDump.MockUevent(fd, g_service, args);
     bool reset = batteryDump.Reset(fd, g_service, args);
-    bool total = getBatteryInfo + unplugged + mockedCapacity + mockedUevent + reset;
+    bool eventStats = batteryDump.DumpEventStats(fd, g_service, args);
+    bool startupStats = batteryDump.DumpStartupStats(fd, g_service, args);
+    bool eventLog = batteryDump.DumpEventLog(fd, g_service, args);
+    bool history = batteryDump.DumpHistory(fd, g_service, args);
+    bool chargeSessions = batteryDump.DumpChargeSessions(fd, g_service, args);
+    bool listeners = batteryDump.DumpListeners(fd, g_service, args);
+    bool ipcStats = batteryDump.DumpIpcStats(fd, g_service, args);
+    bool traceStats = batteryDump.DumpTraceStats(fd, args);
+    bool total = getBatteryInfo + unplugged + mockedCapacity + mockedUevent + reset + eventStats + startupStats +
+        eventLog + history + chargeSessions + listeners + ipcStats + traceStats;
     if (!total) {
         dprintf(fd, "cmd param is invalid\n");
         batteryDump.DumpBatteryHelp(fd);
@@ -1040,6 +1738,7 @@ int32_t BatteryService::Dump(int32_t fd, const std::vector<std::u16string> &args
 
 void BatteryService::MockUnplugged()
 {
+    std::lock_guard<std::mutex> infoLock(infoMutex_);
     std::shared_lock<std::shared_mutex> lock(mutex_);
     if (!iBatteryInterface_) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
@@ -1047,6 +1746,7 @@ void BatteryService::MockUnplugged()
     }
     isMockUnplugged_ = true;
     V2_0::BatteryInfo event;
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetBatteryInfo(event);
     ConvertingEvent(event);
     batteryInfo_.SetPluggedType(BatteryPluggedType::PLUGGED_TYPE_NONE);
@@ -1063,6 +1763,7 @@ bool BatteryService::IsMockUnplugged()
 
 void BatteryService::MockCapacity(int32_t capacity)
 {
+    std::lock_guard<std::mutex> infoLock(infoMutex_);
     std::shared_lock<std::shared_mutex> lock(mutex_);
     if (!iBatteryInterface_) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
@@ -1070,6 +1771,7 @@ void BatteryService::MockCapacity(int32_t capacity)
     }
     isMockCapacity_ = true;
     V2_0::BatteryInfo event;
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetBatteryInfo(event);
     ConvertingEvent(event);
     batteryInfo_.SetCapacity(capacity);
@@ -1083,6 +1785,7 @@ bool BatteryService::IsMockCapacity()
 
 void BatteryService::MockUevent(const std::string& uevent)
 {
+    std::lock_guard<std::mutex> infoLock(infoMutex_);
     std::shared_lock<std::shared_mutex> lock(mutex_);
     if (!iBatteryInterface_) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
@@ -1090,6 +1793,7 @@ void BatteryService::MockUevent(const std::string& uevent)
     }
     isMockUevent_ = true;
     V2_0::BatteryInfo event;
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetBatteryInfo(event);
     ConvertingEvent(event);
     batteryInfo_.SetUevent(uevent);
@@ -1098,6 +1802,7 @@ void BatteryService::MockUevent(const std::string& uevent)
 
 void BatteryService::Reset()
 {
+    std::lock_guard<std::mutex> infoLock(infoMutex_);
     std::shared_lock<std::shared_mutex> lock(mutex_);
     if (!iBatteryInterface_) {
         BATTERY_HILOGE(FEATURE_BATT_INFO, "iBatteryInterface_ is nullptr");
@@ -1107,8 +1812,10 @@ void BatteryService::Reset()
     isMockCapacity_ = false;
     isMockUevent_ = false;
     V2_0::BatteryInfo event;
+    hdiCallCount_.fetch_add(1, std::memory_order_relaxed);
     iBatteryInterface_->GetBatteryInfo(event);
     ConvertingEvent(event);
+    UpdateSnapshot(batteryInfo_);
     HandleBatteryInfo();
 #ifdef BATTERY_MANAGER_SET_LOW_CAPACITY_THRESHOLD
     g_ffrtTimer.reset(); // all strong references gone, ffrtTimer will be destructed.
@@ -1236,6 +1943,13 @@ int32_t BatteryService::GetRemainingChargeTime(int64_t& remainTime)
     return ERR_OK;
 }
 
+int32_t BatteryService::GetRemainingDischargeTime(int64_t& remainTime)
+{
+    BatteryXCollie batteryXCollie("BatteryService::GetRemainingDischargeTime");
+    remainTime = GetRemainingDischargeTimeInner();
+    return ERR_OK;
+}
+
 int32_t BatteryService::SetBatteryConfig(const std::string& sceneName, const std::string& value, int32_t& batteryErr)
 {
     BatteryXCollie batteryXCollie("BatteryService::SetBatteryConfig");
@@ -1256,5 +1970,72 @@ int32_t BatteryService::IsBatteryConfigSupported(const std::string& featureName,
     batteryErr = static_cast<int32_t>(IsBatteryConfigSupportedInner(featureName, result));
     return ERR_OK;
 }
+
+int32_t BatteryService::GetBatteryInfoSnapshot(BatteryInfoSnapshot& snapshot, int32_t& batteryErr)
+{
+    BatteryXCollie batteryXCollie("BatteryService::GetBatteryInfoSnapshot");
+    batteryErr = static_cast<int32_t>(GetBatteryInfoSnapshotInner(snapshot));
+    return ERR_OK;
+}
+
+int32_t BatteryService::SetBatteryConfigs(const std::vector<std::string>& sceneNames,
+    const std::vector<std::string>& values, std::vector<int32_t>& batteryErrs, int32_t& batteryErr)
+{
+    BatteryXCollie batteryXCollie("BatteryService::SetBatteryConfigs");
+    batteryErr = static_cast<int32_t>(SetBatteryConfigsInner(sceneNames, values, batteryErrs));
+    return ERR_OK;
+}
+
+int32_t BatteryService::GetBatteryConfigs(const std::vector<std::string>& sceneNames,
+    std::vector<std::string>& results, std::vector<int32_t>& batteryErrs, int32_t& batteryErr)
+{
+    BatteryXCollie batteryXCollie("BatteryService::GetBatteryConfigs");
+    // the batch limit bounds one ipc only, internal readers go through DoGetBatteryConfigs
+    if (sceneNames.size() > MAX_BATTERY_CONFIG_BATCH) {
+        BATTERY_HILOGW(FEATURE_BATT_INFO, "GetBatteryConfigs failed, size:%{public}zu", sceneNames.size());
+        results.clear();
+        batteryErrs.clear();
+        batteryErr = static_cast<int32_t>(BatteryError::ERR_PARAM_INVALID);
+        return ERR_OK;
+    }
+    batteryErr = static_cast<int32_t>(GetBatteryConfigsInner(sceneNames, results, batteryErrs));
+    return ERR_OK;
+}
+
+int32_t BatteryService::GetBatteryStats(int32_t windowSeconds, BatteryWindowStats& stats, int32_t& batteryErr)
+{
+    BatteryXCollie batteryXCollie("BatteryService::GetBatteryStats");
+    batteryErr = static_cast<int32_t>(GetBatteryStatsInner(windowSeconds, stats));
+    return ERR_OK;
+}
+
+int32_t BatteryService::GetChargeSessions(BatteryChargeSessions& sessions, int32_t& batteryErr)
+{
+    BatteryXCollie batteryXCollie("BatteryService::GetChargeSessions");
+    batteryErr = static_cast<int32_t>(GetChargeSessionsInner(sessions));
+    return ERR_OK;
+}
+
+int32_t BatteryService::GetEnergyCounters(BatteryEnergyCounters& counters, int32_t& batteryErr)
+{
+    BatteryXCollie batteryXCollie("BatteryService::GetEnergyCounters");
+    batteryErr = static_cast<int32_t>(GetEnergyCountersInner(counters));
+    return ERR_OK;
+}
+
+int32_t BatteryService::RegisterBatteryListener(const sptr<IBatteryListener>& listener, uint32_t fieldMask,
+    int64_t minIntervalMs, int32_t& batteryErr)
+{
+    BatteryXCollie batteryXCollie("BatteryService::RegisterBatteryListener");
+    batteryErr = static_cast<int32_t>(RegisterBatteryListenerInner(listener, fieldMask, minIntervalMs));
+    return ERR_OK;
+}
+
+int32_t BatteryService::UnregisterBatteryListener(const sptr<IBatteryListener>& listener, int32_t& batteryErr)
+{
+    BatteryXCollie batteryXCollie("BatteryService::UnregisterBatteryListener");
+    batteryErr = static_cast<int32_t>(UnregisterBatteryListenerInner(listener));
+    return ERR_OK;
+}
 } // namespace PowerMgr
 } // namespace OHOS
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_soc_table.h"
+
+#include "battery_log.h"
+
+namespace OHOS {
+namespace PowerMgr {
+BatterySocTable::BatterySocTable()
+{
+    Fill(Thresholds(), DEFAULT_LOW_CAPACITY, {});
+}
+
+void BatterySocTable::Build(const Thresholds& thresholds, int32_t lowCapacity,
+    const std::vector<BatteryConfig::LightConf>& lightConf)
+{
+    if (!IsThresholdsValid(thresholds)) {
+        BATTERY_HILOGE(FEATURE_BATT_INFO, "capacityThreshold err, shutdown=%{public}d, critical=%{public}d, "
+            "warning=%{public}d, low=%{public}d, normal=%{public}d, high=%{public}d, full=%{public}d",
+            thresholds.shutdown, thresholds.critical, thresholds.warning, thresholds.low, thresholds.normal,
+            thresholds.high, thresholds.full);
+    }
+    Fill(thresholds, lowCapacity, lightConf);
+    for (const auto& it : lightConf) {
+        if (it.beginSoc > it.endSoc || it.beginSoc > MAX_SOC || it.endSoc < MIN_SOC) {
+            BATTERY_HILOGW(FEATURE_BATT_LIGHT, "light conf [%{public}d, %{public}d] covers no capacity",
+                it.beginSoc, it.endSoc);
+        }
+    }
+}
+
+bool BatterySocTable::CapacityLevelCompare(int32_t capacity, int32_t minCapacity, int32_t maxCapacity)
+{
+    if ((maxCapacity != INVALID_BATT_INT_VALUE) && capacity > minCapacity && capacity <= maxCapacity) {
+        return true;
+    }
+    return false;
+}
+
+bool BatterySocTable::IsThresholdsValid(const Thresholds& thresholds)
+{
+    return thresholds.shutdown > 0 && thresholds.critical > thresholds.shutdown &&
+        thresholds.warning > thresholds.critical && thresholds.low > thresholds.warning &&
+        thresholds.normal > thresholds.low && thresholds.high > thresholds.normal &&
+        thresholds.full > thresholds.high;
+}
+
+BatteryCapacityLevel BatterySocTable::GetLevel(const Thresholds& thresholds, int32_t capacity)
+{
+    BatteryCapacityLevel batteryCapacityLevel = BatteryCapacityLevel::LEVEL_NONE;
+    if (CapacityLevelCompare(capacity, INVALID_BATT_INT_VALUE, thresholds.shutdown)) {
+        batteryCapacityLevel = BatteryCapacityLevel::LEVEL_SHUTDOWN;
+    } else if (CapacityLevelCompare(capacity, thresholds.shutdown, thresholds.critical)) {
+        batteryCapacityLevel = BatteryCapacityLevel::LEVEL_CRITICAL;
+    } else if (CapacityLevelCompare(capacity, thresholds.critical, thresholds.warning)) {
+        batteryCapacityLevel = BatteryCapacityLevel::LEVEL_WARNING;
+    } else if (CapacityLevelCompare(capacity, thresholds.warning, thresholds.low)) {
+        batteryCapacityLevel = BatteryCapacityLevel::LEVEL_LOW;
+    } else if (CapacityLevelCompare(capacity, thresholds.low, thresholds.normal)) {
+        batteryCapacityLevel = BatteryCapacityLevel::LEVEL_NORMAL;
+    } else if (CapacityLevelCompare(capacity, thresholds.normal, thresholds.high)) {
+        batteryCapacityLevel = BatteryCapacityLevel::LEVEL_HIGH;
+    } else if (CapacityLevelCompare(capacity, thresholds.high, thresholds.full)) {
+        batteryCapacityLevel = BatteryCapacityLevel::LEVEL_FULL;
+    }
+    return batteryCapacityLevel;
+}
+
+void BatterySocTable::Fill(const Thresholds& thresholds, int32_t lowCapacity,
+    const std::vector<BatteryConfig::LightConf>& lightConf)
+{
+    for (int32_t capacity = MIN_SOC; capacity <= MAX_SOC; capacity++) {
+        Entry& entry = entries_[capacity];
+        entry.level = GetLevel(thresholds, capacity);
+        entry.isLow = capacity <= lowCapacity;
+        entry.hasColor = false;
+        entry.rgb = 0;
+        // the first matching light conf wins, as in a linear scan
+        for (const auto& it : lightConf) {
+            if ((capacity >= it.beginSoc) && (capacity <= it.endSoc)) {
+                entry.hasColor = true;
+                entry.rgb = it.rgb;
+                break;
+            }
+        }
+    }
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_startup_stats.h"
+
+#include <ctime>
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr int64_t SEC_TO_MSEC = 1000;
+constexpr int64_t NSEC_TO_MSEC = 1000000;
+constexpr const char* PHASE_NAMES[BatteryStartupStats::PHASE_COUNT] = {
+    "onStart",
+    "configLoaded",
+    "vibratorLoaded",
+    "pluginsScanned",
+    "permissionReady",
+    "initDone",
+    "hdiListenerRegistered",
+    "published",
+    "hdiReady",
+    "infoLoaded",
+    "firstChanged",
+};
+}
+
+int64_t BatteryStartupStats::GetBootTimeMs()
+{
+    timespec tm {};
+    clock_gettime(CLOCK_BOOTTIME, &tm);
+    return tm.tv_sec * SEC_TO_MSEC + tm.tv_nsec / NSEC_TO_MSEC;
+}
+
+void BatteryStartupStats::Mark(Phase phase)
+{
+    if (phase >= PHASE_COUNT) {
+        return;
+    }
+    int64_t expected = 0;
+    // 0 is never a valid boot time, a phase keeps its first mark
+    (void)times_[phase].compare_exchange_strong(expected, GetBootTimeMs(), std::memory_order_relaxed);
+}
+
+bool BatteryStartupStats::IsMarked(Phase phase) const
+{
+    return GetTime(phase) != 0;
+}
+
+int64_t BatteryStartupStats::GetTime(Phase phase) const
+{
+    if (phase >= PHASE_COUNT) {
+        return 0;
+    }
+    return times_[phase].load(std::memory_order_relaxed);
+}
+
+void BatteryStartupStats::AddHdiListenerRetry()
+{
+    hdiListenerRetries_.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t BatteryStartupStats::GetHdiListenerRetries() const
+{
+    return hdiListenerRetries_.load(std::memory_order_relaxed);
+}
+
+const char* BatteryStartupStats::GetName(Phase phase)
+{
+    if (phase >= PHASE_COUNT) {
+        return "unknown";
+    }
+    return PHASE_NAMES[phase];
+}
+} // namespace PowerMgr
+} // namespace OHOS
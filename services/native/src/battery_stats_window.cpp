@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_stats_window.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr int64_t SEC_TO_MSEC = 1000;
+}
+
+void BatteryStatsWindow::PopFront()
+{
+    const Sample& front = samples_.front();
+    for (uint32_t i = 0; i < METRIC_COUNT; i++) {
+        sums_[i] -= front.values[i];
+        if (!minQueues_[i].empty() && minQueues_[i].front().seq == front.seq) {
+            minQueues_[i].pop_front();
+        }
+        if (!maxQueues_[i].empty() && maxQueues_[i].front().seq == front.seq) {
+            maxQueues_[i].pop_front();
+        }
+    }
+    samples_.pop_front();
+}
+
+void BatteryStatsWindow::Add(int64_t time, const Values& values)
+{
+    Evict(time);
+    if (samples_.size() >= MAX_SAMPLES) {
+        PopFront();
+    }
+    uint64_t seq = nextSeq_++;
+    samples_.push_back({ seq, time, values });
+    for (uint32_t i = 0; i < METRIC_COUNT; i++) {
+        sums_[i] += values[i];
+        // a newer sample at least as small (large) makes the older ones useless for the min (max)
+        while (!minQueues_[i].empty() && minQueues_[i].back().value >= values[i]) {
+            minQueues_[i].pop_back();
+        }
+        minQueues_[i].push_back({ seq, values[i] });
+        while (!maxQueues_[i].empty() && maxQueues_[i].back().value <= values[i]) {
+            maxQueues_[i].pop_back();
+        }
+        maxQueues_[i].push_back({ seq, values[i] });
+    }
+}
+
+void BatteryStatsWindow::Evict(int64_t now)
+{
+    while (!samples_.empty() && samples_.front().time < now - windowMs_) {
+        PopFront();
+    }
+}
+
+BatteryWindowStats::Aggregate BatteryStatsWindow::GetAggregate(Metric metric) const
+{
+    BatteryWindowStats::Aggregate aggregate;
+    if (metric >= METRIC_COUNT || samples_.empty()) {
+        return aggregate;
+    }
+    aggregate.min = minQueues_[metric].front().value;
+    aggregate.max = maxQueues_[metric].front().value;
+    aggregate.avg = static_cast<int32_t>(sums_[metric] / static_cast<int64_t>(samples_.size()));
+    return aggregate;
+}
+
+BatteryStatsWindows::BatteryStatsWindows()
+    : windows_ { BatteryStatsWindow(WINDOW_SECONDS[0] * SEC_TO_MSEC),
+        BatteryStatsWindow(WINDOW_SECONDS[1] * SEC_TO_MSEC), BatteryStatsWindow(WINDOW_SECONDS[2] * SEC_TO_MSEC) }
+{
+}
+
+void BatteryStatsWindows::Add(int64_t time, const BatteryStatsWindow::Values& values)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& window : windows_) {
+        window.Add(time, values);
+    }
+}
+
+bool BatteryStatsWindows::Get(int32_t windowSeconds, int64_t now, BatteryWindowStats& stats)
+{
+    for (size_t i = 0; i < WINDOW_SECONDS.size(); i++) {
+        if (WINDOW_SECONDS[i] != windowSeconds) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        BatteryStatsWindow& window = windows_[i];
+        window.Evict(now);
+        stats.SetWindowSeconds(windowSeconds);
+        stats.SetSampleCount(window.GetSampleCount());
+        stats.SetCurrent(window.GetAggregate(BatteryStatsWindow::METRIC_CURRENT));
+        stats.SetVoltage(window.GetAggregate(BatteryStatsWindow::METRIC_VOLTAGE));
+        stats.SetTemperature(window.GetAggregate(BatteryStatsWindow::METRIC_TEMPERATURE));
+        return true;
+    }
+    return false;
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_trace.h"
+
+#include <chrono>
+#ifdef HAS_HIVIEWDFX_HITRACE_PART
+#include "hitrace_meter.h"
+#endif
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr int64_t USEC_PER_SEC = 1000000;
+constexpr const char* STAGE_NAMES[BatteryTrace::STAGE_COUNT] = {
+    "battery_hdi_receive",
+    "battery_convert",
+    "battery_shutdown_check",
+    "battery_wakeup",
+    "battery_light",
+    "battery_hook",
+    "battery_publish_uevent",
+    "battery_publish_changed",
+    "battery_publish_changed_inner",
+    "battery_publish_capacity",
+    "battery_publish_plugged",
+    "battery_publish_charging",
+    "battery_publish_charge_type",
+};
+
+int64_t GetTickUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool IsPublishStage(BatteryTraceStage stage)
+{
+    return stage >= BatteryTraceStage::PUBLISH_UEVENT;
+}
+}
+
+BatteryTrace& BatteryTrace::GetInstance()
+{
+    static BatteryTrace instance;
+    return instance;
+}
+
+const char* BatteryTrace::GetStageName(BatteryTraceStage stage)
+{
+    uint32_t index = static_cast<uint32_t>(stage);
+    return (index < STAGE_COUNT) ? STAGE_NAMES[index] : "unknown";
+}
+
+void BatteryTrace::Record(BatteryTraceStage stage, int64_t durationUs, bool isSuccess)
+{
+    uint32_t index = static_cast<uint32_t>(stage);
+    if (index >= STAGE_COUNT) {
+        return;
+    }
+    uint64_t duration = (durationUs > 0) ? static_cast<uint64_t>(durationUs) : 0;
+    Stage& entry = stages_[index];
+    entry.count.fetch_add(1, std::memory_order_relaxed);
+    entry.totalUs.fetch_add(duration, std::memory_order_relaxed);
+    uint64_t maxUs = entry.maxUs.load(std::memory_order_relaxed);
+    while (duration > maxUs && !entry.maxUs.compare_exchange_weak(maxUs, duration, std::memory_order_relaxed)) {
+    }
+    if (isSuccess) {
+        return;
+    }
+    entry.failures.fetch_add(1, std::memory_order_relaxed);
+    if (IsPublishStage(stage)) {
+        uint64_t failures = publishFailures_.fetch_add(1, std::memory_order_relaxed) + 1;
+#ifdef HAS_HIVIEWDFX_HITRACE_PART
+        CountTrace(HITRACE_TAG_POWER, "battery_publish_failures", static_cast<int64_t>(failures));
+#else
+        (void)failures;
+#endif
+    }
+}
+
+void BatteryTrace::CountEvent()
+{
+    events_.fetch_add(1, std::memory_order_relaxed);
+    int64_t second = GetTickUs() / USEC_PER_SEC;
+    RateBucket& bucket = rate_[static_cast<uint64_t>(second) % RATE_BUCKETS];
+    int64_t current = bucket.second.load(std::memory_order_relaxed);
+    if (current != second && bucket.second.compare_exchange_strong(current, second, std::memory_order_relaxed)) {
+        bucket.count.store(0, std::memory_order_relaxed);
+    }
+    bucket.count.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t BatteryTrace::GetEvents() const
+{
+    return events_.load(std::memory_order_relaxed);
+}
+
+uint64_t BatteryTrace::GetRecentEvents() const
+{
+    int64_t now = GetTickUs() / USEC_PER_SEC;
+    uint64_t events = 0;
+    for (const auto& bucket : rate_) {
+        int64_t second = bucket.second.load(std::memory_order_relaxed);
+        if (second < now && second >= now - RATE_WINDOW_S) {
+            events += bucket.count.load(std::memory_order_relaxed);
+        }
+    }
+    return events;
+}
+
+uint64_t BatteryTrace::GetPublishFailures() const
+{
+    return publishFailures_.load(std::memory_order_relaxed);
+}
+
+std::vector<BatteryTrace::StageStats> BatteryTrace::GetStageStats() const
+{
+    std::vector<StageStats> result;
+    for (uint32_t i = 0; i < STAGE_COUNT; i++) {
+        StageStats stats;
+        stats.name = STAGE_NAMES[i];
+        stats.count = stages_[i].count.load(std::memory_order_relaxed);
+        stats.totalUs = stages_[i].totalUs.load(std::memory_order_relaxed);
+        stats.maxUs = stages_[i].maxUs.load(std::memory_order_relaxed);
+        stats.failures = stages_[i].failures.load(std::memory_order_relaxed);
+        result.push_back(stats);
+    }
+    return result;
+}
+
+void BatteryTrace::Reset()
+{
+    for (auto& stage : stages_) {
+        stage.count.store(0, std::memory_order_relaxed);
+        stage.totalUs.store(0, std::memory_order_relaxed);
+        stage.maxUs.store(0, std::memory_order_relaxed);
+        stage.failures.store(0, std::memory_order_relaxed);
+    }
+    for (auto& bucket : rate_) {
+        bucket.second.store(-1, std::memory_order_relaxed);
+        bucket.count.store(0, std::memory_order_relaxed);
+    }
+    events_.store(0, std::memory_order_relaxed);
+    publishFailures_.store(0, std::memory_order_relaxed);
+}
+
+BatteryTraceScope::BatteryTraceScope(BatteryTraceStage stage) : stage_(stage), start_(GetTickUs())
+{
+#ifdef HAS_HIVIEWDFX_HITRACE_PART
+    if (IsTagEnabled(HITRACE_TAG_POWER)) {
+        StartTrace(HITRACE_TAG_POWER, BatteryTrace::GetStageName(stage));
+        isTracing_ = true;
+    }
+#endif
+}
+
+BatteryTraceScope::~BatteryTraceScope()
+{
+#ifdef HAS_HIVIEWDFX_HITRACE_PART
+    if (isTracing_) {
+        FinishTrace(HITRACE_TAG_POWER);
+    }
+#endif
+    BatteryTrace::GetInstance().Record(stage_, GetTickUs() - start_, isSuccess_);
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -47,5 +47,20 @@ HWTEST_F(OhBatteryInfoTest, OH_BatteryInfo_GetPluggedType_001, TestSize.Level1)
     BatteryInfo_BatteryPluggedType resultFromCApi = OH_BatteryInfo_GetPluggedType();
     EXPECT_EQ(static_cast<uint32_t>(resultFromClient), static_cast<uint32_t>(resultFromCApi));
 }
+
+HWTEST_F(OhBatteryInfoTest, OH_BatteryInfo_GetRemainingDischargeTime_001, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "OH_BatteryInfo_GetRemainingDischargeTime_001 start");
+    BatterySrvClient& batterySrvClient = BatterySrvClient::GetInstance();
+    BatteryPluggedType pluggedType = batterySrvClient.GetPluggedType();
+    int64_t resultFromCApi = OH_BatteryInfo_GetRemainingDischargeTime();
+    // non-system callers are denied
+    if (resultFromCApi != -1) {
+        EXPECT_GE(resultFromCApi, 0);
+        if (pluggedType != BatteryPluggedType::PLUGGED_TYPE_NONE) {
+            EXPECT_EQ(resultFromCApi, 0);
+        }
+    }
+}
 }
 }
\ No newline at end of file
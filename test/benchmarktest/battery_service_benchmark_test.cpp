@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <string>
+
+#ifdef GTEST
+#define private   public
+#define protected public
+#endif
+
+#include "battery_charge_time_estimator.h"
+#include "battery_info.h"
+#include "battery_service.h"
+#include "battery_xcollie.h"
+#include "ibattery_srv.h"
+#include "ipc_skeleton.h"
+#include "v2_0/ibattery_interface.h"
+#include "xcollie/xcollie.h"
+
+using namespace std;
+using namespace OHOS::HDI::Battery;
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+sptr<BatteryService> g_service = DelayedSpSingleton<BatteryService>::GetInstance();
+const int32_t ITERATION_FREQUENCY = 100;
+const int32_t REPETITION_FREQUENCY = 3;
+const int32_t LEGACY_MAX_AGE = 0;
+const int32_t SNAPSHOT_MAX_AGE = 10000;
+const int32_t CONTENTION_ITERATION_FREQUENCY = 10000;
+const int32_t CONTENTION_MAX_THREADS = 8;
+const int32_t CONTENTION_WRITE_INTERVAL = 64;
+const int32_t XCOLLIE_ITERATION_FREQUENCY = 10000;
+const uint32_t XCOLLIE_TIMEOUT_S = 60;
+}
+
+class BatteryServiceBenchmarkTest : public benchmark::Fixture {
+public:
+    void SetUp(const ::benchmark::State& state)
+    {
+        if (g_service->iBatteryInterface_ == nullptr) {
+            g_service->iBatteryInterface_ = V2_0::IBatteryInterface::Get();
+        }
+        maxAge_ = g_service->snapshotMaxAge_;
+        g_service->snapshotMaxAge_ = static_cast<int32_t>(state.range(0));
+        g_service->InvalidateSnapshot();
+    }
+    void TearDown(const ::benchmark::State& state)
+    {
+        g_service->snapshotMaxAge_ = maxAge_;
+        g_service->InvalidateSnapshot();
+    }
+
+private:
+    int32_t maxAge_ { 0 };
+};
+
+/**
+ * @tc.name: GetCapacityInner
+ * @tc.desc: Testcase for "GetCapacityInner" served per call by the hdi (0) or from the snapshot
+ * @tc.type: FUNC
+ */
+BENCHMARK_DEFINE_F(BatteryServiceBenchmarkTest, GetCapacityInner)(benchmark::State& st)
+{
+    for (auto _ : st) {
+        int32_t capacity = g_service->GetCapacityInner();
+        // capacity is range of 0 - 100
+        ASSERT_TRUE(capacity >= 0 && capacity <= 100);
+    }
+}
+BENCHMARK_REGISTER_F(BatteryServiceBenchmarkTest, GetCapacityInner)
+    ->Arg(LEGACY_MAX_AGE)
+    ->Arg(SNAPSHOT_MAX_AGE)
+    ->Iterations(ITERATION_FREQUENCY)
+    ->Repetitions(REPETITION_FREQUENCY)
+    ->ReportAggregatesOnly();
+
+/**
+ * @tc.name: GetVoltageInner
+ * @tc.desc: Testcase for "GetVoltageInner" served per call by the hdi (0) or from the snapshot
+ * @tc.type: FUNC
+ */
+BENCHMARK_DEFINE_F(BatteryServiceBenchmarkTest, GetVoltageInner)(benchmark::State& st)
+{
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(g_service->GetVoltageInner());
+    }
+}
+BENCHMARK_REGISTER_F(BatteryServiceBenchmarkTest, GetVoltageInner)
+    ->Arg(LEGACY_MAX_AGE)
+    ->Arg(SNAPSHOT_MAX_AGE)
+    ->Iterations(ITERATION_FREQUENCY)
+    ->Repetitions(REPETITION_FREQUENCY)
+    ->ReportAggregatesOnly();
+
+/**
+ * @tc.name: GetTechnologyInner
+ * @tc.desc: Testcase for "GetTechnologyInner" served per call by the hdi (0) or from the snapshot
+ * @tc.type: FUNC
+ */
+BENCHMARK_DEFINE_F(BatteryServiceBenchmarkTest, GetTechnologyInner)(benchmark::State& st)
+{
+    for (auto _ : st) {
+        std::string technology = g_service->GetTechnologyInner();
+        benchmark::DoNotOptimize(technology);
+    }
+}
+BENCHMARK_REGISTER_F(BatteryServiceBenchmarkTest, GetTechnologyInner)
+    ->Arg(LEGACY_MAX_AGE)
+    ->Arg(SNAPSHOT_MAX_AGE)
+    ->Iterations(ITERATION_FREQUENCY)
+    ->Repetitions(REPETITION_FREQUENCY)
+    ->ReportAggregatesOnly();
+
+/**
+ * @tc.name: GetCapacityLevelInner
+ * @tc.desc: Testcase for "GetCapacityLevelInner" served per call by the hdi (0) or from the snapshot
+ * @tc.type: FUNC
+ */
+BENCHMARK_DEFINE_F(BatteryServiceBenchmarkTest, GetCapacityLevelInner)(benchmark::State& st)
+{
+    for (auto _ : st) {
+        auto level = g_service->GetCapacityLevelInner();
+        ASSERT_TRUE(level >= BatteryCapacityLevel::LEVEL_NONE && level < BatteryCapacityLevel::LEVEL_RESERVED);
+    }
+}
+BENCHMARK_REGISTER_F(BatteryServiceBenchmarkTest, GetCapacityLevelInner)
+    ->Arg(LEGACY_MAX_AGE)
+    ->Arg(SNAPSHOT_MAX_AGE)
+    ->Iterations(ITERATION_FREQUENCY)
+    ->Repetitions(REPETITION_FREQUENCY)
+    ->ReportAggregatesOnly();
+
+/**
+ * @tc.name: GetTotalEnergyInner
+ * @tc.desc: Testcase for the privileged "GetTotalEnergyInner" with the permission cache disabled (0) or enabled
+ * @tc.type: FUNC
+ */
+static void GetTotalEnergyInner(benchmark::State& st)
+{
+    g_service->permissionCache_.enabled_ = (st.range(0) != 0);
+    g_service->permissionCache_.Clear();
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(g_service->GetTotalEnergyInner());
+    }
+    g_service->permissionCache_.enabled_ = true;
+}
+BENCHMARK(GetTotalEnergyInner)
+    ->Arg(0)
+    ->Arg(1)
+    ->Iterations(ITERATION_FREQUENCY)
+    ->Repetitions(REPETITION_FREQUENCY)
+    ->ReportAggregatesOnly();
+
+/**
+ * @tc.name: SnapshotReadContended
+ * @tc.desc: Testcase for snapshot reads scaling across threads, each thread replaces it every 64 reads
+ * @tc.type: FUNC
+ */
+static void SnapshotReadContended(benchmark::State& st)
+{
+    int32_t count = 0;
+    BatteryInfo info;
+    for (auto _ : st) {
+        if (++count % CONTENTION_WRITE_INTERVAL == 0) {
+            info.SetCapacity(count % 100);
+            g_service->UpdateSnapshot(info);
+            continue;
+        }
+        auto entry = g_service->LoadSnapshot();
+        benchmark::DoNotOptimize(entry->seq);
+        if (entry->info != nullptr) {
+            benchmark::DoNotOptimize(entry->info->GetCapacity());
+        }
+    }
+}
+BENCHMARK(SnapshotReadContended)
+    ->ThreadRange(1, CONTENTION_MAX_THREADS)
+    ->UseRealTime()
+    ->Iterations(CONTENTION_ITERATION_FREQUENCY)
+    ->Repetitions(REPETITION_FREQUENCY)
+    ->ReportAggregatesOnly();
+
+/**
+ * @tc.name: XCollieTimerPerCall
+ * @tc.desc: Testcase for the per call cost of an XCollie SetTimer and CancelTimer round trip
+ * @tc.type: FUNC
+ */
+static void XCollieTimerPerCall(benchmark::State& st)
+{
+    for (auto _ : st) {
+        int32_t id = HiviewDFX::XCollie::GetInstance().SetTimer("BatteryService::GetCapacity", XCOLLIE_TIMEOUT_S,
+            nullptr, nullptr, HiviewDFX::XCOLLIE_FLAG_LOG);
+        HiviewDFX::XCollie::GetInstance().CancelTimer(id);
+    }
+}
+BENCHMARK(XCollieTimerPerCall)
+    ->ThreadRange(1, CONTENTION_MAX_THREADS)
+    ->UseRealTime()
+    ->Iterations(XCOLLIE_ITERATION_FREQUENCY)
+    ->Repetitions(REPETITION_FREQUENCY)
+    ->ReportAggregatesOnly();
+
+/**
+ * @tc.name: BatteryXColliePerCall
+ * @tc.desc: Testcase for the per call cost of a BatteryXCollie guard on the watchdog slot of the thread
+ * @tc.type: FUNC
+ */
+static void BatteryXColliePerCall(benchmark::State& st)
+{
+    for (auto _ : st) {
+        BatteryXCollie batteryXCollie("BatteryService::GetCapacity");
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BatteryXColliePerCall)
+    ->ThreadRange(1, CONTENTION_MAX_THREADS)
+    ->UseRealTime()
+    ->Iterations(XCOLLIE_ITERATION_FREQUENCY)
+    ->Repetitions(REPETITION_FREQUENCY)
+    ->ReportAggregatesOnly();
+
+/**
+ * @tc.name: BatteryIpcStatsPerCall
+ * @tc.desc: Testcase for the per call cost of the ipc stats taken around every request, to compare with
+ *           BatteryXColliePerCall
+ * @tc.type: FUNC
+ */
+static void BatteryIpcStatsPerCall(benchmark::State& st)
+{
+    BatteryIpcStats& ipcStats = g_service->GetIpcStats();
+    uint32_t code = static_cast<uint32_t>(IBatterySrvIpcCode::COMMAND_GET_CAPACITY);
+    for (auto _ : st) {
+        auto start = std::chrono::steady_clock::now();
+        int64_t latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        ipcStats.Record(code, IPCSkeleton::GetCallingUid(), latencyUs);
+    }
+}
+BENCHMARK(BatteryIpcStatsPerCall)
+    ->ThreadRange(1, CONTENTION_MAX_THREADS)
+    ->UseRealTime()
+    ->Iterations(XCOLLIE_ITERATION_FREQUENCY)
+    ->Repetitions(REPETITION_FREQUENCY)
+    ->ReportAggregatesOnly();
+
+/**
+ * @tc.name: BatteryChargeTimeEstimatorUpdate
+ * @tc.desc: Testcase for the per event cost of the remaining charge time estimator, every event is taken
+ *           into the fits
+ * @tc.type: FUNC
+ */
+static void BatteryChargeTimeEstimatorUpdate(benchmark::State& st)
+{
+    constexpr int64_t eventIntervalMs = 10000;
+    constexpr int32_t counterPerEvent = 1500;
+    BatteryChargeTimeEstimator estimator;
+    BatteryInfo info;
+    info.SetCapacity(50);
+    info.SetChargeCounter(2000000);
+    info.SetChargeState(BatteryChargeState::CHARGE_STATE_ENABLE);
+    info.SetPluggedType(BatteryPluggedType::PLUGGED_TYPE_AC);
+    int64_t timeMs = 0;
+    for (auto _ : st) {
+        timeMs += eventIntervalMs;
+        info.SetChargeCounter(info.GetChargeCounter() + counterPerEvent);
+        estimator.Update(timeMs, info);
+        benchmark::DoNotOptimize(estimator.GetEstimate());
+    }
+}
+BENCHMARK(BatteryChargeTimeEstimatorUpdate)
+    ->Iterations(XCOLLIE_ITERATION_FREQUENCY)
+    ->Repetitions(REPETITION_FREQUENCY)
+    ->ReportAggregatesOnly();
+} // namespace PowerMgr
+} // namespace OHOS
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -43,6 +43,18 @@ public:
     int32_t SetBatteryConfig(const std::string& sceneName, const std::string& value, int32_t& batteryErr) override;
     int32_t GetBatteryConfig(const std::string& sceneName, std::string& getResult, int32_t& batteryErr) override;
     int32_t IsBatteryConfigSupported(const std::string& featureName, bool& isResult, int32_t& batteryErr) override;
+    int32_t GetBatteryInfoSnapshot(BatteryInfoSnapshot& snapshot, int32_t& batteryErr) override;
+    int32_t SetBatteryConfigs(const std::vector<std::string>& sceneNames, const std::vector<std::string>& values,
+        std::vector<int32_t>& batteryErrs, int32_t& batteryErr) override;
+    int32_t GetBatteryConfigs(const std::vector<std::string>& sceneNames, std::vector<std::string>& getResults,
+        std::vector<int32_t>& batteryErrs, int32_t& batteryErr) override;
+    int32_t GetBatteryStats(int32_t windowSeconds, BatteryWindowStats& stats, int32_t& batteryErr) override;
+    int32_t GetRemainingDischargeTime(int64_t& remainTime) override;
+    int32_t GetChargeSessions(BatteryChargeSessions& sessions, int32_t& batteryErr) override;
+    int32_t GetEnergyCounters(BatteryEnergyCounters& counters, int32_t& batteryErr) override;
+    int32_t RegisterBatteryListener(const sptr<IBatteryListener>& listener, uint32_t fieldMask, int64_t minIntervalMs,
+        int32_t& batteryErr) override;
+    int32_t UnregisterBatteryListener(const sptr<IBatteryListener>& listener, int32_t& batteryErr) override;
 };
 } // namespace PowerMgr
 } // namespace OHOS
@@ -106,5 +106,53 @@ int32_t MockBatterySrvProxy::IsBatteryConfigSupported(const std::string& feature
 {
     return ERR_FAIL;
 }
+
+int32_t MockBatterySrvProxy::GetBatteryInfoSnapshot(BatteryInfoSnapshot& snapshot, int32_t& batteryErr)
+{
+    return ERR_FAIL;
+}
+
+int32_t MockBatterySrvProxy::SetBatteryConfigs(const std::vector<std::string>& sceneNames,
+    const std::vector<std::string>& values, std::vector<int32_t>& batteryErrs, int32_t& batteryErr)
+{
+    return ERR_FAIL;
+}
+
+int32_t MockBatterySrvProxy::GetBatteryConfigs(const std::vector<std::string>& sceneNames,
+    std::vector<std::string>& getResults, std::vector<int32_t>& batteryErrs, int32_t& batteryErr)
+{
+    return ERR_FAIL;
+}
+
+int32_t MockBatterySrvProxy::GetBatteryStats(int32_t windowSeconds, BatteryWindowStats& stats, int32_t& batteryErr)
+{
+    return ERR_FAIL;
+}
+
+int32_t MockBatterySrvProxy::GetRemainingDischargeTime(int64_t& remainTime)
+{
+    return ERR_FAIL;
+}
+
+int32_t MockBatterySrvProxy::GetChargeSessions(BatteryChargeSessions& sessions, int32_t& batteryErr)
+{
+    return ERR_FAIL;
+}
+
+int32_t MockBatterySrvProxy::GetEnergyCounters(BatteryEnergyCounters& counters, int32_t& batteryErr)
+{
+    return ERR_FAIL;
+}
+
+int32_t MockBatterySrvProxy::RegisterBatteryListener(const sptr<IBatteryListener>& listener, uint32_t fieldMask,
+    int64_t minIntervalMs, int32_t& batteryErr)
+{
+    return ERR_FAIL;
+}
+
+int32_t MockBatterySrvProxy::UnregisterBatteryListener(const sptr<IBatteryListener>& listener, int32_t& batteryErr)
+{
+    return ERR_FAIL;
+}
 } // namespace PowerMgr
 } // namespace OHOS
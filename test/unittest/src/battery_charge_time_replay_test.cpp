@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "battery_charge_time_estimator.h"
+#include "battery_log.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace Test {
+using namespace testing::ext;
+namespace {
+// charge sessions exported with "ohos-batteryManager journal --format csv", one session per file
+constexpr const char* RECORDED_SESSIONS_DIR = "/data/local/tmp/battery_charge_sessions";
+constexpr int64_t MS_PER_SEC = 1000;
+constexpr int64_t MS_PER_MIN = 60 * MS_PER_SEC;
+// estimates of the first minutes of a session are not scored, neither estimator has a rate yet. Neither are
+// the last minutes, where any error is large relative to the time left
+constexpr int64_t WARMUP_MS = 5 * MS_PER_MIN;
+constexpr int64_t MIN_SCORED_REMAINING_MS = 10 * MS_PER_MIN;
+constexpr int32_t FULL_CAPACITY = 100;
+constexpr int32_t DESIGN_CAPACITY_UAH = 4500000;
+
+struct Sample {
+    int64_t timeMs { 0 };
+    BatteryInfo info;
+};
+using Session = std::vector<Sample>;
+
+struct SessionModel {
+    BatteryPluggedType pluggedType { BatteryPluggedType::PLUGGED_TYPE_AC };
+    int32_t startCapacity { 0 };
+    double ratePerMin { 0 };    // constant current phase, capacity percent per minute
+    double taperCapacity { 0 }; // the constant voltage phase starts here
+    double throttleCapacity { FULL_CAPACITY }; // the current halves from here, as on a thermal limit
+    int64_t eventIntervalMs { 0 };
+    uint32_t seed { 0 };
+};
+
+// The single step heuristic the regression estimator replaced: the time of the last 1% step times the
+// steps left
+class LegacyEstimator {
+public:
+    void Update(int64_t timeMs, const BatteryInfo& info)
+    {
+        int32_t capacity = info.GetCapacity();
+        if (info.GetChargeState() != BatteryChargeState::CHARGE_STATE_ENABLE) {
+            remainMs_ = 0;
+            charging_ = false;
+            return;
+        }
+        if (!charging_) {
+            lastCapacity_ = capacity;
+            lastTimeMs_ = timeMs;
+            charging_ = true;
+        }
+        if (capacity < lastCapacity_) {
+            lastCapacity_ = capacity;
+        }
+        if (capacity > lastCapacity_) {
+            int64_t onceTime = (timeMs - lastTimeMs_) / (capacity - lastCapacity_);
+            remainMs_ = (FULL_CAPACITY - capacity) * onceTime;
+            lastCapacity_ = capacity;
+            lastTimeMs_ = timeMs;
+        }
+    }
+
+    int64_t GetRemainingMs() const
+    {
+        return remainMs_;
+    }
+
+private:
+    bool charging_ { false };
+    int32_t lastCapacity_ { 0 };
+    int64_t lastTimeMs_ { 0 };
+    int64_t remainMs_ { 0 };
+};
+
+class Score {
+public:
+    void Add(int64_t estimateMs, int64_t truthMs)
+    {
+        // a missing estimate counts as fully wrong
+        double error = (estimateMs <= 0) ? 1.0 :
+            std::fabs(static_cast<double>(estimateMs - truthMs)) / static_cast<double>(truthMs);
+        errorSum_ += error;
+        count_++;
+    }
+
+    double GetMeanError() const
+    {
+        return (count_ == 0) ? 0 : errorSum_ / count_;
+    }
+
+    uint32_t GetCount() const
+    {
+        return count_;
+    }
+
+private:
+    double errorSum_ { 0 };
+    uint32_t count_ { 0 };
+};
+
+BatteryInfo MakeInfo(int32_t capacity, int32_t chargeCounter, BatteryChargeState chargeState,
+    BatteryPluggedType pluggedType)
+{
+    BatteryInfo info;
+    info.SetCapacity(capacity);
+    info.SetChargeCounter(chargeCounter);
+    info.SetChargeState(chargeState);
+    info.SetPluggedType(pluggedType);
+    return info;
+}
+
+// Constant current up to the taper, then a current falling with the distance to full, with noise on the
+// current and on the event interval. The reported capacity is the rounded state of charge.
+Session SimulateSession(const SessionModel& model)
+{
+    std::mt19937 rng(model.seed);
+    std::normal_distribution<double> currentNoise(1.0, 0.05);
+    std::uniform_real_distribution<double> intervalJitter(0.5, 1.5);
+    Session session;
+    double soc = model.startCapacity;
+    int64_t timeMs = 0;
+    int32_t capacity = model.startCapacity;
+    while (capacity < FULL_CAPACITY) {
+        int32_t chargeCounter = static_cast<int32_t>(soc * DESIGN_CAPACITY_UAH / FULL_CAPACITY);
+        session.push_back({ timeMs, MakeInfo(capacity, chargeCounter, BatteryChargeState::CHARGE_STATE_ENABLE,
+            model.pluggedType) });
+        int64_t intervalMs = static_cast<int64_t>(model.eventIntervalMs * intervalJitter(rng));
+        double rate = model.ratePerMin;
+        if (soc >= model.throttleCapacity) {
+            rate /= 2;
+        }
+        if (soc >= model.taperCapacity) {
+            rate *= (FULL_CAPACITY - soc) / (FULL_CAPACITY - model.taperCapacity);
+        }
+        soc += rate * currentNoise(rng) * intervalMs / MS_PER_MIN;
+        timeMs += intervalMs;
+        capacity = std::min(FULL_CAPACITY, static_cast<int32_t>(std::lround(soc)));
+    }
+    session.push_back({ timeMs, MakeInfo(FULL_CAPACITY, DESIGN_CAPACITY_UAH, BatteryChargeState::CHARGE_STATE_FULL,
+        model.pluggedType) });
+    return session;
+}
+
+const std::vector<SessionModel>& GetSessionModels()
+{
+    static const std::vector<SessionModel> models = {
+        // 18 W quick charge, 10 W standard, 5 W usb, a throttled quick charge, wireless and a top-up
+        { BatteryPluggedType::PLUGGED_TYPE_AC, 5, 1.6, 80, FULL_CAPACITY, 10 * MS_PER_SEC, 1 },
+        { BatteryPluggedType::PLUGGED_TYPE_AC, 20, 0.9, 85, FULL_CAPACITY, 10 * MS_PER_SEC, 2 },
+        { BatteryPluggedType::PLUGGED_TYPE_USB, 30, 0.4, 88, FULL_CAPACITY, 20 * MS_PER_SEC, 3 },
+        { BatteryPluggedType::PLUGGED_TYPE_AC, 10, 1.6, 78, 50, 10 * MS_PER_SEC, 4 },
+        { BatteryPluggedType::PLUGGED_TYPE_WIRELESS, 15, 0.7, 75, FULL_CAPACITY, 30 * MS_PER_SEC, 5 },
+        { BatteryPluggedType::PLUGGED_TYPE_AC, 60, 1.2, 82, FULL_CAPACITY, 10 * MS_PER_SEC, 6 },
+    };
+    return models;
+}
+
+// Columns of the journal csv: seq,time,capacity,voltage,current,temperature,chargeState,pluggedType,
+// healthState,chargeCounter,remainEnergy,changedFields
+Session LoadRecordedSession(const std::string& path)
+{
+    constexpr size_t TIME_COLUMN = 1;
+    constexpr size_t CAPACITY_COLUMN = 2;
+    constexpr size_t CHARGE_STATE_COLUMN = 6;
+    constexpr size_t PLUGGED_TYPE_COLUMN = 7;
+    constexpr size_t CHARGE_COUNTER_COLUMN = 9;
+    constexpr size_t COLUMN_COUNT = 12;
+    Session session;
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    while (std::getline(file, line)) {
+        std::vector<long long> columns;
+        std::stringstream stream(line);
+        std::string column;
+        while (std::getline(stream, column, ',')) {
+            columns.push_back(std::strtoll(column.c_str(), nullptr, 10));
+        }
+        if (columns.size() != COLUMN_COUNT) {
+            continue;
+        }
+        session.push_back({ columns[TIME_COLUMN], MakeInfo(static_cast<int32_t>(columns[CAPACITY_COLUMN]),
+            static_cast<int32_t>(columns[CHARGE_COUNTER_COLUMN]),
+            static_cast<BatteryChargeState>(columns[CHARGE_STATE_COLUMN]),
+            static_cast<BatteryPluggedType>(columns[PLUGGED_TYPE_COLUMN])) });
+    }
+    return session;
+}
+
+std::vector<Session> LoadRecordedSessions()
+{
+    std::vector<Session> sessions;
+    DIR* dir = opendir(RECORDED_SESSIONS_DIR);
+    if (dir == nullptr) {
+        return sessions;
+    }
+    for (struct dirent* entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        constexpr const char* SUFFIX = ".csv";
+        if (name.size() > strlen(SUFFIX) && name.compare(name.size() - strlen(SUFFIX), strlen(SUFFIX), SUFFIX) == 0) {
+            sessions.push_back(LoadRecordedSession(std::string(RECORDED_SESSIONS_DIR) + "/" + name));
+        }
+    }
+    closedir(dir);
+    return sessions;
+}
+
+// Scores the samples between the warmup and the last minutes before full capacity, a session that never
+// gets full is skipped
+void ReplaySession(const Session& session, Score& score, Score& legacyScore)
+{
+    auto full = std::find_if(session.begin(), session.end(), [](const Sample& sample) {
+        return sample.info.GetCapacity() >= FULL_CAPACITY;
+    });
+    if (session.empty() || full == session.end()) {
+        return;
+    }
+    BatteryChargeTimeEstimator estimator;
+    LegacyEstimator legacy;
+    for (auto it = session.begin(); it != full; ++it) {
+        estimator.Update(it->timeMs, it->info);
+        legacy.Update(it->timeMs, it->info);
+        if (it->timeMs - session.front().timeMs < WARMUP_MS) {
+            continue;
+        }
+        int64_t truthMs = full->timeMs - it->timeMs;
+        if (truthMs < MIN_SCORED_REMAINING_MS) {
+            break;
+        }
+        score.Add(estimator.GetEstimate().remainingMs, truthMs);
+        legacyScore.Add(legacy.GetRemainingMs(), truthMs);
+    }
+}
+} // namespace
+
+class BatteryChargeTimeReplayTest : public testing::Test {};
+
+/**
+ * @tc.name: BatteryChargeTimeReplay001
+ * @tc.desc: Replay the simulated charge sessions, the estimator beats the single step heuristic
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryChargeTimeReplayTest, BatteryChargeTimeReplay001, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryChargeTimeReplay001 function start!");
+    Score total;
+    Score legacyTotal;
+    for (const SessionModel& model : GetSessionModels()) {
+        Score score;
+        Score legacyScore;
+        ReplaySession(SimulateSession(model), score, legacyScore);
+        GTEST_LOG_(INFO) << "session " << model.seed << ": mean error " << score.GetMeanError() << ", legacy " <<
+            legacyScore.GetMeanError() << ", samples " << score.GetCount();
+        EXPECT_LT(score.GetMeanError(), legacyScore.GetMeanError());
+        ReplaySession(SimulateSession(model), total, legacyTotal);
+    }
+    GTEST_LOG_(INFO) << "all sessions: mean error " << total.GetMeanError() << ", legacy " <<
+        legacyTotal.GetMeanError();
+    EXPECT_LT(total.GetMeanError(), 0.3);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryChargeTimeReplay001 function end!");
+}
+
+/**
+ * @tc.name: BatteryChargeTimeReplay002
+ * @tc.desc: Replay the recorded charge sessions found on the device and report both errors
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryChargeTimeReplayTest, BatteryChargeTimeReplay002, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryChargeTimeReplay002 function start!");
+    Score total;
+    Score legacyTotal;
+    for (const Session& session : LoadRecordedSessions()) {
+        ReplaySession(session, total, legacyTotal);
+    }
+    GTEST_LOG_(INFO) << "recorded sessions: mean error " << total.GetMeanError() << ", legacy " <<
+        legacyTotal.GetMeanError() << ", samples " << total.GetCount();
+    EXPECT_EQ(total.GetCount(), legacyTotal.GetCount());
+    BATTERY_HILOGI(LABEL_TEST, "BatteryChargeTimeReplay002 function end!");
+}
+
+/**
+ * @tc.name: BatteryChargeTimeReplay003
+ * @tc.desc: A plug type change or the end of charging drops the estimate
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryChargeTimeReplayTest, BatteryChargeTimeReplay003, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryChargeTimeReplay003 function start!");
+    Session session = SimulateSession(GetSessionModels().front());
+    BatteryChargeTimeEstimator estimator;
+    size_t half = session.size() / 2;
+    for (size_t i = 0; i < half; i++) {
+        estimator.Update(session[i].timeMs, session[i].info);
+    }
+    EXPECT_GT(estimator.GetEstimate().remainingMs, 0);
+    EXPECT_GT(estimator.GetEstimate().confidence, 0);
+
+    BatteryInfo info = session[half].info;
+    info.SetPluggedType(BatteryPluggedType::PLUGGED_TYPE_USB);
+    estimator.Update(session[half].timeMs, info);
+    EXPECT_EQ(estimator.GetEstimate().remainingMs, 0);
+    EXPECT_EQ(estimator.GetEstimate().confidence, 0);
+
+    info.SetChargeState(BatteryChargeState::CHARGE_STATE_NONE);
+    estimator.Update(session[half].timeMs + MS_PER_MIN, info);
+    EXPECT_EQ(estimator.GetEstimate().remainingMs, 0);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryChargeTimeReplay003 function end!");
+}
+
+/**
+ * @tc.name: BatteryChargeTimeReplay004
+ * @tc.desc: The confidence grows with the session and stays within 0 to 100
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryChargeTimeReplayTest, BatteryChargeTimeReplay004, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryChargeTimeReplay004 function start!");
+    Session session = SimulateSession(GetSessionModels()[1]);
+    BatteryChargeTimeEstimator estimator;
+    int32_t earlyConfidence = -1;
+    for (const Sample& sample : session) {
+        estimator.Update(sample.timeMs, sample.info);
+        int32_t confidence = estimator.GetEstimate().confidence;
+        EXPECT_GE(confidence, 0);
+        EXPECT_LE(confidence, 100);
+        if (earlyConfidence < 0 && sample.timeMs >= MS_PER_MIN) {
+            earlyConfidence = confidence;
+        }
+        if (sample.timeMs >= 20 * MS_PER_MIN) {
+            EXPECT_GT(confidence, earlyConfidence);
+            break;
+        }
+    }
+    BATTERY_HILOGI(LABEL_TEST, "BatteryChargeTimeReplay004 function end!");
+}
+} // namespace Test
+} // namespace PowerMgr
+} // namespace OHOS
@@ -156,4 +156,42 @@ static HWTEST_F(BatterySrvStubTest, BatterySrvStub006, TestSize.Level1)
     EXPECT_EQ(ret, ERR_OK) << "ret: " << ret << " code: " << code;
     BATTERY_HILOGI(LABEL_TEST, "BatterySrvStub006 function end!");
 }
+
+/**
+ * @tc.name: BatterySrvStub007
+ * @tc.desc: Test OnRemoteRequest records the ipc call counters and latency histogram
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatterySrvStubTest, BatterySrvStub007, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatterySrvStub007 function start!");
+    BatteryIpcStats& ipcStats = g_service->GetIpcStats();
+    ipcStats.Reset();
+    uint32_t code = static_cast<uint32_t>(PowerMgr::IBatterySrvIpcCode::COMMAND_GET_CAPACITY);
+    const uint64_t calls = 10;
+    for (uint64_t i = 0; i < calls; i++) {
+        MessageParcel data;
+        MessageParcel reply;
+        data.WriteInterfaceToken(BatterySrvProxy::GetDescriptor());
+        EXPECT_EQ(g_service->OnRemoteRequest(code, data, reply, g_option), ERR_OK);
+    }
+    std::vector<BatteryIpcStats::MethodStats> methods = ipcStats.GetMethodStats();
+    ASSERT_EQ(methods.size(), 1U);
+    EXPECT_STREQ(methods[0].name, "GetCapacity");
+    EXPECT_EQ(methods[0].calls, calls);
+    EXPECT_LE(methods[0].p50Us, methods[0].p99Us);
+    std::vector<BatteryIpcStats::UidStats> uids = ipcStats.GetUidStats();
+    ASSERT_EQ(uids.size(), 1U);
+    EXPECT_EQ(uids[0].calls, calls);
+
+    ipcStats.Record(BatteryIpcStats::MAX_METHODS + 1, -1, 1);
+    methods = ipcStats.GetMethodStats();
+    ASSERT_EQ(methods.size(), 2U);
+    EXPECT_STREQ(methods[1].name, "Other");
+    EXPECT_EQ(ipcStats.GetUidOverflow(), 1U);
+    ipcStats.Reset();
+    EXPECT_TRUE(ipcStats.GetMethodStats().empty());
+    EXPECT_TRUE(ipcStats.GetUidStats().empty());
+    BATTERY_HILOGI(LABEL_TEST, "BatterySrvStub007 function end!");
+}
 } // namespace
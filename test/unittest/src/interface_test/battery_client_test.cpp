@@ -29,6 +29,7 @@
 #include "iservice_registry.h"
 #include "system_ability_definition.h"
 
+#include "battery_listener_stub.h"
 #include "battery_log.h"
 #include "battery_srv_client.h"
 #include "test_utils.h"
@@ -53,6 +54,20 @@ const std::string MOCK_BATTERY_PATH = "/data/service/el0/battery/";
 BatteryInfo g_info;
 sptr<IRemoteObject> g_testRemoteObj;
 sptr<MockBatterySrvProxy> g_mockProxy;
+
+class TestBatteryListener : public BatteryListenerStub {
+public:
+    void OnBatteryChanged(uint32_t changedFields, const BatteryInfoSnapshot& snapshot) override
+    {
+        calls_++;
+        fields_ = changedFields;
+        capacity_ = snapshot.GetInfo().GetCapacity();
+    }
+
+    uint32_t calls_ { 0 };
+    uint32_t fields_ { 0 };
+    int32_t capacity_ { 0 };
+};
 }
 
 void BatteryClientTest::SetUpTestCase(void)
@@ -1086,4 +1101,357 @@ HWTEST_F(BatteryClientTest, BatteryClient039, TestSize.Level0)
     EXPECT_NE(batteryErr, BatteryError::ERR_OK);
     BATTERY_HILOGI(LABEL_TEST, "BatteryClient039 function end!");
 }
+
+/**
+ * @tc.name: BatteryClient040
+ * @tc.desc: Test IBatterySrv interface GetBatteryInfoSnapshot
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryClientTest, BatteryClient040, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient040 function start!");
+    auto& BatterySrvClient = BatterySrvClient::GetInstance();
+    BatteryInfoSnapshot snapshot;
+    auto batteryErr = BatterySrvClient.GetBatteryInfoSnapshot(snapshot);
+    EXPECT_EQ(batteryErr, BatteryError::ERR_OK);
+    EXPECT_EQ(snapshot.GetVersion(), BatteryInfoSnapshot::VERSION);
+    EXPECT_EQ(snapshot.GetInfo().GetCapacity(), BatterySrvClient.GetCapacity());
+    EXPECT_EQ(snapshot.GetInfo().GetTechnology(), BatterySrvClient.GetTechnology());
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient040 function end!");
+}
+
+/**
+ * @tc.name: BatteryClient041
+ * @tc.desc: test GetBatteryInfoSnapshot() when proxy return fail
+ * @tc.type: FUNC
+ * @tc.require
+ */
+HWTEST_F(BatteryClientTest, BatteryClient041, TestSize.Level0)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient041 function start!");
+    auto& BatterySrvClient = BatterySrvClient::GetInstance();
+    auto proxy = BatterySrvClient.proxy_;
+    BatterySrvClient.proxy_ = g_mockProxy;
+    BatteryInfoSnapshot snapshot;
+    auto batteryErr = BatterySrvClient.GetBatteryInfoSnapshot(snapshot);
+    BatterySrvClient.proxy_ = proxy;
+    EXPECT_EQ(batteryErr, BatteryError::ERR_CONNECTION_FAIL);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient041 function end!");
+}
+
+/**
+ * @tc.name: BatteryClient042
+ * @tc.desc: Test IBatterySrv interface GetBatteryConfigs returns a result per scene
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryClientTest, BatteryClient042, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient042 function start!");
+    auto& BatterySrvClient = BatterySrvClient::GetInstance();
+    std::vector<std::string> sceneNames = { "testScene", "wireless" };
+    std::vector<std::string> values;
+    std::vector<BatteryError> results;
+    auto batteryErr = BatterySrvClient.GetBatteryConfigs(sceneNames, values, results);
+    if (batteryErr == BatteryError::ERR_OK) {
+        ASSERT_EQ(results.size(), sceneNames.size());
+        ASSERT_EQ(values.size(), sceneNames.size());
+        EXPECT_NE(results[0], BatteryError::ERR_OK);
+        std::string value;
+        EXPECT_EQ(results[1], BatterySrvClient.GetBatteryConfig(sceneNames[1], value));
+        EXPECT_EQ(values[1], value);
+    } else {
+        EXPECT_TRUE(results.empty());
+    }
+    std::vector<std::pair<std::string, std::string>> configs = { { "testScene", "" }, { "testScene", "1" } };
+    batteryErr = BatterySrvClient.SetBatteryConfigs(configs, results);
+    if (batteryErr == BatteryError::ERR_OK) {
+        ASSERT_EQ(results.size(), configs.size());
+        EXPECT_NE(results[0], BatteryError::ERR_OK);
+    }
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient042 function end!");
+}
+
+/**
+ * @tc.name: BatteryClient043
+ * @tc.desc: test GetBatteryConfigs() and SetBatteryConfigs() when proxy return fail
+ * @tc.type: FUNC
+ * @tc.require
+ */
+HWTEST_F(BatteryClientTest, BatteryClient043, TestSize.Level0)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient043 function start!");
+    auto& BatterySrvClient = BatterySrvClient::GetInstance();
+    auto proxy = BatterySrvClient.proxy_;
+    BatterySrvClient.proxy_ = g_mockProxy;
+    std::vector<std::string> values;
+    std::vector<BatteryError> results;
+    auto getErr = BatterySrvClient.GetBatteryConfigs({ "test" }, values, results);
+    auto setErr = BatterySrvClient.SetBatteryConfigs({ { "test", "test" } }, results);
+    BatterySrvClient.proxy_ = proxy;
+    EXPECT_EQ(getErr, BatteryError::ERR_CONNECTION_FAIL);
+    EXPECT_EQ(setErr, BatteryError::ERR_CONNECTION_FAIL);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient043 function end!");
+}
+
+/**
+ * @tc.name: BatteryClient044
+ * @tc.desc: Test IBatterySrv interface GetBatteryStats for the supported and an unsupported window
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryClientTest, BatteryClient044, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient044 function start!");
+    auto& BatterySrvClient = BatterySrvClient::GetInstance();
+    for (int32_t windowSeconds : { 60, 300, 900 }) {
+        BatteryWindowStats stats;
+        EXPECT_EQ(BatterySrvClient.GetBatteryStats(windowSeconds, stats), BatteryError::ERR_OK);
+        EXPECT_EQ(stats.GetVersion(), BatteryWindowStats::VERSION);
+        EXPECT_EQ(stats.GetWindowSeconds(), windowSeconds);
+        if (stats.GetSampleCount() > 0) {
+            EXPECT_LE(stats.GetVoltage().min, stats.GetVoltage().avg);
+            EXPECT_LE(stats.GetVoltage().avg, stats.GetVoltage().max);
+        }
+    }
+    BatteryWindowStats stats;
+    EXPECT_EQ(BatterySrvClient.GetBatteryStats(61, stats), BatteryError::ERR_PARAM_INVALID);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient044 function end!");
+}
+
+/**
+ * @tc.name: BatteryClient045
+ * @tc.desc: test GetBatteryStats() when proxy return fail
+ * @tc.type: FUNC
+ * @tc.require
+ */
+HWTEST_F(BatteryClientTest, BatteryClient045, TestSize.Level0)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient045 function start!");
+    auto& BatterySrvClient = BatterySrvClient::GetInstance();
+    auto proxy = BatterySrvClient.proxy_;
+    BatterySrvClient.proxy_ = g_mockProxy;
+    BatteryWindowStats stats;
+    auto batteryErr = BatterySrvClient.GetBatteryStats(60, stats);
+    BatterySrvClient.proxy_ = proxy;
+    EXPECT_EQ(batteryErr, BatteryError::ERR_CONNECTION_FAIL);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient045 function end!");
+}
+
+/**
+ * @tc.name: BatteryClient046
+ * @tc.desc: Test IBatterySrv interface GetRemainingDischargeTime
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryClientTest, BatteryClient046, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient046 function start!");
+    auto& BatterySrvClient = BatterySrvClient::GetInstance();
+    int64_t remainTime = BatterySrvClient.GetRemainingDischargeTime();
+    GTEST_LOG_(INFO) << "BatteryClient::BatteryClient046 executing, remainingDischargeTime=" << remainTime;
+    // non-system callers are denied
+    if (remainTime != INVALID_REMAINING_CHARGE_TIME_VALUE) {
+        EXPECT_GE(remainTime, 0);
+        if (BatterySrvClient.GetPluggedType() != BatteryPluggedType::PLUGGED_TYPE_NONE) {
+            EXPECT_EQ(remainTime, 0);
+        }
+    }
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient046 function end!");
+}
+
+/**
+ * @tc.name: BatteryClient047
+ * @tc.desc: test GetRemainingDischargeTime() when proxy return fail
+ * @tc.type: FUNC
+ * @tc.require
+ */
+HWTEST_F(BatteryClientTest, BatteryClient047, TestSize.Level0)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient047 function start!");
+    auto& BatterySrvClient = BatterySrvClient::GetInstance();
+    auto proxy = BatterySrvClient.proxy_;
+    BatterySrvClient.proxy_ = g_mockProxy;
+    int64_t remainTime = BatterySrvClient.GetRemainingDischargeTime();
+    BatterySrvClient.proxy_ = proxy;
+    EXPECT_EQ(remainTime, INVALID_REMAINING_CHARGE_TIME_VALUE);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient047 function end!");
+}
+
+/**
+ * @tc.name: BatteryClient048
+ * @tc.desc: Test IBatterySrv interface GetChargeSessions
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryClientTest, BatteryClient048, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient048 function start!");
+    auto& BatterySrvClient = BatterySrvClient::GetInstance();
+    BatteryChargeSessions sessions;
+    auto batteryErr = BatterySrvClient.GetChargeSessions(sessions);
+    if (batteryErr == BatteryError::ERR_OK) {
+        EXPECT_EQ(sessions.GetVersion(), BatteryChargeSessions::VERSION);
+        const auto& list = sessions.GetSessions();
+        for (size_t i = 0; i < list.size(); i++) {
+            // only the last session may still be running
+            EXPECT_TRUE(!list[i].active || i + 1 == list.size());
+            EXPECT_GE(list[i].duration, 0);
+            EXPECT_LE(list[i].minTemperature, list[i].maxTemperature);
+        }
+    } else {
+        EXPECT_EQ(batteryErr, BatteryError::ERR_SYSTEM_API_DENIED);
+        EXPECT_TRUE(sessions.GetSessions().empty());
+    }
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient048 function end!");
+}
+
+/**
+ * @tc.name: BatteryClient049
+ * @tc.desc: test GetChargeSessions() when proxy return fail
+ * @tc.type: FUNC
+ * @tc.require
+ */
+HWTEST_F(BatteryClientTest, BatteryClient049, TestSize.Level0)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient049 function start!");
+    auto& BatterySrvClient = BatterySrvClient::GetInstance();
+    auto proxy = BatterySrvClient.proxy_;
+    BatterySrvClient.proxy_ = g_mockProxy;
+    BatteryChargeSessions sessions;
+    auto batteryErr = BatterySrvClient.GetChargeSessions(sessions);
+    BatterySrvClient.proxy_ = proxy;
+    EXPECT_EQ(batteryErr, BatteryError::ERR_CONNECTION_FAIL);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient049 function end!");
+}
+
+/**
+ * @tc.name: BatteryClient050
+ * @tc.desc: Test IBatterySrv interface GetEnergyCounters
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryClientTest, BatteryClient050, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient050 function start!");
+    auto& BatterySrvClient = BatterySrvClient::GetInstance();
+    BatteryEnergyCounters first;
+    auto batteryErr = BatterySrvClient.GetEnergyCounters(first);
+    if (batteryErr == BatteryError::ERR_OK) {
+        EXPECT_EQ(first.GetVersion(), BatteryEnergyCounters::VERSION);
+        BatteryEnergyCounters second;
+        EXPECT_EQ(BatterySrvClient.GetEnergyCounters(second), BatteryError::ERR_OK);
+        // every total is monotonic, so the difference of two readings is the consumption in between
+        EXPECT_GE(second.GetCounters().time, first.GetCounters().time);
+        EXPECT_GE(second.GetCounters().sampleCount, first.GetCounters().sampleCount);
+        EXPECT_GE(second.GetCounters().chargeIn, first.GetCounters().chargeIn);
+        EXPECT_GE(second.GetCounters().chargeOut, first.GetCounters().chargeOut);
+        EXPECT_GE(second.GetCounters().energyIn, first.GetCounters().energyIn);
+        EXPECT_GE(second.GetCounters().energyOut, first.GetCounters().energyOut);
+    } else {
+        EXPECT_EQ(batteryErr, BatteryError::ERR_SYSTEM_API_DENIED);
+    }
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient050 function end!");
+}
+
+/**
+ * @tc.name: BatteryClient051
+ * @tc.desc: test GetEnergyCounters() when proxy return fail
+ * @tc.type: FUNC
+ * @tc.require
+ */
+HWTEST_F(BatteryClientTest, BatteryClient051, TestSize.Level0)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient051 function start!");
+    auto& BatterySrvClient = BatterySrvClient::GetInstance();
+    auto proxy = BatterySrvClient.proxy_;
+    BatterySrvClient.proxy_ = g_mockProxy;
+    BatteryEnergyCounters counters;
+    auto batteryErr = BatterySrvClient.GetEnergyCounters(counters);
+    BatterySrvClient.proxy_ = proxy;
+    EXPECT_EQ(batteryErr, BatteryError::ERR_CONNECTION_FAIL);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient051 function end!");
+}
+
+/**
+ * @tc.name: BatteryClient052
+ * @tc.desc: Test IBatterySrv interface RegisterBatteryListener and UnregisterBatteryListener
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryClientTest, BatteryClient052, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient052 function start!");
+    auto& BatterySrvClient = BatterySrvClient::GetInstance();
+    EXPECT_EQ(BatterySrvClient.RegisterBatteryListener(nullptr, BatteryInfo::FIELD_CAPACITY, 0),
+        BatteryError::ERR_PARAM_INVALID);
+    sptr<TestBatteryListener> listener = sptr<TestBatteryListener>::MakeSptr();
+    EXPECT_EQ(BatterySrvClient.RegisterBatteryListener(listener, BatteryInfo::FIELD_NONE, 0),
+        BatteryError::ERR_PARAM_INVALID);
+    EXPECT_TRUE(BatterySrvClient.listeners_.empty());
+
+    EXPECT_EQ(BatterySrvClient.RegisterBatteryListener(listener, BatteryInfo::FIELD_CAPACITY, 0),
+        BatteryError::ERR_OK);
+    EXPECT_EQ(BatterySrvClient.RegisterBatteryListener(listener, BatteryInfo::FIELD_CAPACITY, 1000),
+        BatteryError::ERR_OK);
+    ASSERT_EQ(BatterySrvClient.listeners_.size(), 1U);
+    EXPECT_EQ(BatterySrvClient.listeners_[0].minIntervalMs, 1000);
+    EXPECT_TRUE(BatterySrvClient.statusListener_ != nullptr);
+    // what the client does when the service comes back
+    BatterySrvClient.RestoreListeners();
+    EXPECT_EQ(BatterySrvClient.listeners_.size(), 1U);
+
+    EXPECT_EQ(BatterySrvClient.UnregisterBatteryListener(listener), BatteryError::ERR_OK);
+    EXPECT_TRUE(BatterySrvClient.listeners_.empty());
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient052 function end!");
+}
+
+/**
+ * @tc.name: BatteryClient053
+ * @tc.desc: test RegisterBatteryListener() and UnregisterBatteryListener() when proxy return fail
+ * @tc.type: FUNC
+ * @tc.require
+ */
+HWTEST_F(BatteryClientTest, BatteryClient053, TestSize.Level0)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient053 function start!");
+    auto& BatterySrvClient = BatterySrvClient::GetInstance();
+    auto proxy = BatterySrvClient.proxy_;
+    BatterySrvClient.proxy_ = g_mockProxy;
+    sptr<TestBatteryListener> listener = sptr<TestBatteryListener>::MakeSptr();
+    auto registerErr = BatterySrvClient.RegisterBatteryListener(listener, BatteryInfo::FIELD_CAPACITY, 0);
+    auto unregisterErr = BatterySrvClient.UnregisterBatteryListener(listener);
+    BatterySrvClient.proxy_ = proxy;
+    EXPECT_EQ(registerErr, BatteryError::ERR_CONNECTION_FAIL);
+    EXPECT_EQ(unregisterErr, BatteryError::ERR_CONNECTION_FAIL);
+    // a failed registration is not restored later
+    EXPECT_TRUE(BatterySrvClient.listeners_.empty());
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient053 function end!");
+}
+
+/**
+ * @tc.name: BatteryClient054
+ * @tc.desc: Test BatteryListenerStub reads the change sent by the service
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryClientTest, BatteryClient054, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient054 function start!");
+    sptr<TestBatteryListener> listener = sptr<TestBatteryListener>::MakeSptr();
+    BatteryInfo info;
+    info.SetCapacity(BATTERY_LOW_THRESHOLD);
+    BatteryInfoSnapshot snapshot;
+    snapshot.SetInfo(info);
+    uint32_t code = static_cast<uint32_t>(IBatteryListener::Code::ON_BATTERY_CHANGED);
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_ASYNC);
+    data.WriteInterfaceToken(BatteryListenerStub::GetDescriptor());
+    data.WriteUint32(BatteryInfo::FIELD_CAPACITY);
+    data.WriteParcelable(&snapshot);
+    EXPECT_EQ(listener->OnRemoteRequest(code, data, reply, option), ERR_OK);
+    EXPECT_EQ(listener->calls_, 1U);
+    EXPECT_EQ(listener->fields_, BatteryInfo::FIELD_CAPACITY);
+    EXPECT_EQ(listener->capacity_, BATTERY_LOW_THRESHOLD);
+
+    MessageParcel invalid;
+    invalid.WriteInterfaceToken(u"invalid");
+    EXPECT_NE(listener->OnRemoteRequest(code, invalid, reply, option), ERR_OK);
+    EXPECT_EQ(listener->calls_, 1U);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryClient054 function end!");
+}
 } // namespace
@@ -15,10 +15,15 @@
 
 #include "battery_info_test.h"
 
+#include <memory>
 #include <string>
 
+#include "battery_charge_sessions.h"
+#include "battery_energy_counters.h"
 #include "battery_info.h"
+#include "battery_info_snapshot.h"
 #include "battery_log.h"
+#include "parcel.h"
 
 using namespace testing::ext;
 
@@ -65,5 +70,239 @@ HWTEST_F(BatteryInfoTest, BatteryInfo002, TestSize.Level1)
     EXPECT_EQ(g_infoTest->GetChargeType(), none);
     BATTERY_HILOGI(LABEL_TEST, "BatteryInfo002 function end!");
 }
+
+/**
+ * @tc.name: BatteryInfo003
+ * @tc.desc: BatteryInfoSnapshot Marshalling and Unmarshalling function test
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryInfoTest, BatteryInfo003, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryInfo003 function start!");
+    BatteryInfo info;
+    info.SetCapacity(66);
+    info.SetVoltage(4123456);
+    info.SetTemperature(275);
+    info.SetPluggedType(BatteryPluggedType::PLUGGED_TYPE_USB);
+    info.SetChargeState(BatteryChargeState::CHARGE_STATE_ENABLE);
+    info.SetPresent(true);
+    info.SetTechnology("Li-poly");
+    info.SetChargeType(ChargeType::WIRED_QUICK);
+    BatteryInfoSnapshot snapshot;
+    snapshot.SetInfo(info);
+    snapshot.SetCapacityLevel(BatteryCapacityLevel::LEVEL_NORMAL);
+    snapshot.SetRemainingChargeTime(3600000);
+    snapshot.SetRemainingChargeTimeConfidence(75);
+    snapshot.SetSequence(42);
+    snapshot.SetTimestamp(123456);
+
+    Parcel parcel;
+    EXPECT_TRUE(snapshot.Marshalling(parcel));
+    std::unique_ptr<BatteryInfoSnapshot> result(BatteryInfoSnapshot::Unmarshalling(parcel));
+    ASSERT_TRUE(result != nullptr);
+    EXPECT_EQ(result->GetVersion(), BatteryInfoSnapshot::VERSION);
+    EXPECT_EQ(result->GetSequence(), static_cast<uint64_t>(42));
+    EXPECT_EQ(result->GetTimestamp(), static_cast<int64_t>(123456));
+    EXPECT_EQ(result->GetCapacityLevel(), BatteryCapacityLevel::LEVEL_NORMAL);
+    EXPECT_EQ(result->GetRemainingChargeTime(), static_cast<int64_t>(3600000));
+    EXPECT_EQ(result->GetRemainingChargeTimeConfidence(), 75);
+    EXPECT_EQ(result->GetInfo().GetCapacity(), 66);
+    EXPECT_EQ(result->GetInfo().GetVoltage(), 4123456);
+    EXPECT_EQ(result->GetInfo().GetTemperature(), 275);
+    EXPECT_EQ(result->GetInfo().GetPluggedType(), BatteryPluggedType::PLUGGED_TYPE_USB);
+    EXPECT_EQ(result->GetInfo().GetChargeState(), BatteryChargeState::CHARGE_STATE_ENABLE);
+    EXPECT_TRUE(result->GetInfo().IsPresent());
+    EXPECT_EQ(result->GetInfo().GetTechnology(), "Li-poly");
+    EXPECT_EQ(result->GetInfo().GetChargeType(), ChargeType::WIRED_QUICK);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryInfo003 function end!");
+}
+
+/**
+ * @tc.name: BatteryInfo004
+ * @tc.desc: BatteryInfoSnapshot Unmarshalling rejects an invalid or truncated parcel
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryInfoTest, BatteryInfo004, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryInfo004 function start!");
+    Parcel invalidVersion;
+    invalidVersion.WriteUint32(0);
+    EXPECT_TRUE(BatteryInfoSnapshot::Unmarshalling(invalidVersion) == nullptr);
+
+    Parcel truncated;
+    truncated.WriteUint32(BatteryInfoSnapshot::VERSION);
+    truncated.WriteUint32(64);
+    truncated.WriteUint64(1);
+    EXPECT_TRUE(BatteryInfoSnapshot::Unmarshalling(truncated) == nullptr);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryInfo004 function end!");
+}
+
+/**
+ * @tc.name: BatteryInfo005
+ * @tc.desc: BatteryInfo GetChangedFields reports exactly the fields that differ
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryInfoTest, BatteryInfo005, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryInfo005 function start!");
+    BatteryInfo last;
+    last.SetCapacity(50);
+    last.SetVoltage(4000000);
+    last.SetNowCurrent(1000);
+    last.SetChargeState(BatteryChargeState::CHARGE_STATE_ENABLE);
+    BatteryInfo info = last;
+    EXPECT_EQ(info.GetChangedFields(last), static_cast<uint32_t>(BatteryInfo::FIELD_NONE));
+
+    info.SetVoltage(4001000);
+    info.SetNowCurrent(1200);
+    EXPECT_EQ(info.GetChangedFields(last),
+        static_cast<uint32_t>(BatteryInfo::FIELD_VOLTAGE | BatteryInfo::FIELD_NOW_CURRENT));
+
+    info.SetCapacity(51);
+    info.SetChargeState(BatteryChargeState::CHARGE_STATE_FULL);
+    info.SetUevent("SUBSYSTEM=power_supply");
+    uint32_t fields = info.GetChangedFields(last);
+    EXPECT_NE(fields & BatteryInfo::FIELD_CAPACITY, 0U);
+    EXPECT_NE(fields & BatteryInfo::FIELD_CHARGE_STATE, 0U);
+    EXPECT_NE(fields & BatteryInfo::FIELD_UEVENT, 0U);
+    EXPECT_EQ(fields & BatteryInfo::FIELD_TEMPERATURE, 0U);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryInfo005 function end!");
+}
+
+/**
+ * @tc.name: BatteryInfo006
+ * @tc.desc: BatteryChargeSessions Marshalling and Unmarshalling function test
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryInfoTest, BatteryInfo006, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryInfo006 function start!");
+    BatteryChargeSessions::Session ended;
+    ended.startTime = 1700000000000;
+    ended.duration = 5400000;
+    ended.pluggedType = BatteryPluggedType::PLUGGED_TYPE_AC;
+    ended.startCapacity = 20;
+    ended.endCapacity = 80;
+    ended.chargeDelivered = 2000;
+    ended.energyDelivered = 8200;
+    ended.peakCurrent = 2000;
+    ended.averageCurrent = 1333;
+    ended.minTemperature = 300;
+    ended.maxTemperature = 350;
+    ended.chargeTypeTime[static_cast<size_t>(ChargeType::WIRED_QUICK)] = 3600000;
+    BatteryChargeSessions::Session running;
+    running.active = true;
+    BatteryChargeSessions sessions;
+    sessions.SetSessions({ ended, running });
+
+    Parcel parcel;
+    EXPECT_TRUE(sessions.Marshalling(parcel));
+    std::unique_ptr<BatteryChargeSessions> result(BatteryChargeSessions::Unmarshalling(parcel));
+    ASSERT_TRUE(result != nullptr);
+    EXPECT_EQ(result->GetVersion(), BatteryChargeSessions::VERSION);
+    ASSERT_EQ(result->GetSessions().size(), 2U);
+    const BatteryChargeSessions::Session& session = result->GetSessions()[0];
+    EXPECT_EQ(session.startTime, ended.startTime);
+    EXPECT_EQ(session.duration, ended.duration);
+    EXPECT_EQ(session.pluggedType, BatteryPluggedType::PLUGGED_TYPE_AC);
+    EXPECT_EQ(session.startCapacity, 20);
+    EXPECT_EQ(session.endCapacity, 80);
+    EXPECT_EQ(session.chargeDelivered, 2000);
+    EXPECT_EQ(session.energyDelivered, 8200);
+    EXPECT_EQ(session.peakCurrent, 2000);
+    EXPECT_EQ(session.averageCurrent, 1333);
+    EXPECT_EQ(session.minTemperature, 300);
+    EXPECT_EQ(session.maxTemperature, 350);
+    EXPECT_EQ(session.chargeTypeTime, ended.chargeTypeTime);
+    EXPECT_FALSE(session.active);
+    EXPECT_TRUE(result->GetSessions()[1].active);
+
+    Parcel tooMany;
+    tooMany.WriteUint32(BatteryChargeSessions::VERSION);
+    tooMany.WriteUint32(sizeof(uint32_t));
+    tooMany.WriteUint32(BatteryChargeSessions::MAX_SESSIONS + 1);
+    EXPECT_TRUE(BatteryChargeSessions::Unmarshalling(tooMany) == nullptr);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryInfo006 function end!");
+}
+
+/**
+ * @tc.name: BatteryInfo007
+ * @tc.desc: BatteryEnergyCounters Marshalling and Unmarshalling function test
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryInfoTest, BatteryInfo007, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryInfo007 function start!");
+    BatteryEnergyCounters::Counters counters;
+    counters.time = 86400000;
+    counters.sampleCount = 4096;
+    counters.chargeIn = 3000000;
+    counters.chargeOut = 2500000;
+    counters.energyIn = 12600000;
+    counters.energyOut = 9750000;
+    BatteryEnergyCounters energyCounters;
+    energyCounters.SetCounters(counters);
+
+    Parcel parcel;
+    EXPECT_TRUE(energyCounters.Marshalling(parcel));
+    std::unique_ptr<BatteryEnergyCounters> result(BatteryEnergyCounters::Unmarshalling(parcel));
+    ASSERT_TRUE(result != nullptr);
+    EXPECT_EQ(result->GetVersion(), BatteryEnergyCounters::VERSION);
+    const BatteryEnergyCounters::Counters& read = result->GetCounters();
+    EXPECT_EQ(read.time, counters.time);
+    EXPECT_EQ(read.sampleCount, counters.sampleCount);
+    EXPECT_EQ(read.chargeIn, counters.chargeIn);
+    EXPECT_EQ(read.chargeOut, counters.chargeOut);
+    EXPECT_EQ(read.energyIn, counters.energyIn);
+    EXPECT_EQ(read.energyOut, counters.energyOut);
+
+    Parcel invalid;
+    invalid.WriteUint32(0);
+    invalid.WriteUint32(0);
+    EXPECT_TRUE(BatteryEnergyCounters::Unmarshalling(invalid) == nullptr);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryInfo007 function end!");
+}
+
+/**
+ * @tc.name: BatteryInfo008
+ * @tc.desc: BatteryInfoSnapshot Unmarshalling skips fields appended by a newer version
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryInfoTest, BatteryInfo008, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryInfo008 function start!");
+    BatteryInfo info;
+    info.SetCapacity(80);
+    info.SetTechnology("Li-ion");
+    BatteryInfoSnapshot snapshot;
+    snapshot.SetInfo(info);
+    snapshot.SetRemainingChargeTimeConfidence(60);
+    snapshot.SetSequence(7);
+    Parcel current;
+    ASSERT_TRUE(snapshot.Marshalling(current));
+    uint32_t version = 0;
+    uint32_t size = 0;
+    ASSERT_TRUE(current.ReadUint32(version));
+    ASSERT_TRUE(current.ReadUint32(size));
+    const uint8_t* fields = current.ReadBuffer(size);
+    ASSERT_TRUE(fields != nullptr);
+
+    constexpr int32_t unknownField = 12345;
+    constexpr int32_t batteryErr = -1;
+    Parcel newer;
+    newer.WriteUint32(BatteryInfoSnapshot::VERSION + 1);
+    newer.WriteUint32(size + sizeof(int32_t));
+    newer.WriteBuffer(fields, size);
+    newer.WriteInt32(unknownField);
+    newer.WriteInt32(batteryErr);
+    std::unique_ptr<BatteryInfoSnapshot> result(BatteryInfoSnapshot::Unmarshalling(newer));
+    ASSERT_TRUE(result != nullptr);
+    EXPECT_EQ(result->GetSequence(), static_cast<uint64_t>(7));
+    EXPECT_EQ(result->GetRemainingChargeTimeConfidence(), 60);
+    EXPECT_EQ(result->GetInfo().GetCapacity(), 80);
+    EXPECT_EQ(result->GetInfo().GetTechnology(), "Li-ion");
+    EXPECT_EQ(newer.ReadInt32(), batteryErr);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryInfo008 function end!");
+}
 } // namespace PowerMgr
 } // namespace OHOS
\ No newline at end of file
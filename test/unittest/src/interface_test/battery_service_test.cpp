@@ -20,16 +20,37 @@
 #define protected public
 #endif
 
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
 #include <fcntl.h>
 #include <memory>
+#include <mutex>
 #include <string>
-
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "battery_charge_session_stats.h"
+#include "battery_config.h"
+#include "battery_discharge_time_estimator.h"
+#include "battery_energy_integrator.h"
+#include "battery_history.h"
 #include "battery_info.h"
+#include "battery_journal.h"
+#include "battery_listener_manager.h"
+#include "battery_listener_stub.h"
 #include "battery_log.h"
 #include "battery_service.h"
+#include "battery_stats_window.h"
+#include "battery_trace.h"
 #include "common_event_data.h"
 #include "common_event_subscriber.h"
 #include "common_event_support.h"
+#include "ipc_skeleton.h"
 #include "securec.h"
 #include "test_utils.h"
 #include "battery_xcollie.h"
@@ -50,6 +71,45 @@ constexpr int TEST_CAPACITY_MIN = 0;
 constexpr int TEST_CAPACITY_MAX = 100;
 constexpr int TEST_CAPACITY_FIRST = 50;
 constexpr int TEST_CAPACITY_SECOND = 60;
+
+class TestBatteryListener : public BatteryListenerStub {
+public:
+    void OnBatteryChanged(uint32_t changedFields, const BatteryInfoSnapshot& snapshot) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        calls_++;
+        fields_ = changedFields;
+        capacity_ = snapshot.GetInfo().GetCapacity();
+        remainEnergy_ = snapshot.GetInfo().GetRemainEnergy();
+        cv_.notify_all();
+    }
+
+    bool WaitCalls(uint32_t calls, int32_t timeoutMs)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, calls] { return calls_ >= calls; });
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint32_t calls_ { 0 };
+    uint32_t fields_ { 0 };
+    int32_t capacity_ { 0 };
+    int32_t remainEnergy_ { 0 };
+};
+
+// Cache the IsSystem decision of the test process, so the system api checks of g_service see it
+void CacheSystemDecision(bool isSystem)
+{
+    constexpr uint32_t systemBit = 1;
+    BatteryPermissionCache& cache = g_service->permissionCache_;
+    cache.Insert(IPCSkeleton::GetCallingFullTokenID(), systemBit, isSystem, cache.invalidations_.load());
+}
+
+void ClearSystemDecision()
+{
+    g_service->permissionCache_.Invalidate(static_cast<uint32_t>(IPCSkeleton::GetCallingFullTokenID()));
+}
 }
 
 void BatteryServiceTest::TearDownTestCase(void)
@@ -402,17 +462,35 @@ static HWTEST_F(BatteryServiceTest, BatteryService019, TestSize.Level1)
 static HWTEST_F(BatteryServiceTest, BatteryService020, TestSize.Level1)
 {
     BATTERY_HILOGI(LABEL_TEST, "BatteryService020 function start!");
-    g_service->CalculateRemainingChargeTime(101, BatteryChargeState::CHARGE_STATE_DISABLE);
-    EXPECT_FALSE(g_service->chargeFlag_);
-
-    g_service->chargeFlag_ = true;
-    g_service->lastCapacity_ = 50;
-    g_service->CalculateRemainingChargeTime(30, BatteryChargeState::CHARGE_STATE_ENABLE);
-    EXPECT_EQ(g_service->lastCapacity_, 30);
-
-    g_service->lastCapacity_ = 50;
-    g_service->chargeFlag_ = true;
-    g_service->CalculateRemainingChargeTime(51, BatteryChargeState::CHARGE_STATE_ENABLE);
+    BatteryInfo info;
+    info.SetCapacity(101);
+    info.SetChargeState(BatteryChargeState::CHARGE_STATE_DISABLE);
+    g_service->CalculateRemainingChargeTime(info);
+    EXPECT_EQ(g_service->remainTime_.load(), 0);
+    EXPECT_EQ(g_service->remainTimeConfidence_.load(), 0);
+
+    // a single sample of a session gives no rate
+    info.SetCapacity(50);
+    info.SetChargeState(BatteryChargeState::CHARGE_STATE_ENABLE);
+    info.SetPluggedType(BatteryPluggedType::PLUGGED_TYPE_AC);
+    g_service->CalculateRemainingChargeTime(info);
+    EXPECT_EQ(g_service->remainTime_.load(), 0);
+
+    // a capacity drop starts a new session
+    info.SetCapacity(30);
+    g_service->CalculateRemainingChargeTime(info);
+    EXPECT_EQ(g_service->remainTime_.load(), 0);
+
+    info.SetCapacity(31);
+    g_service->CalculateRemainingChargeTime(info);
+    EXPECT_GE(g_service->remainTime_.load(), 0);
+    EXPECT_GE(g_service->remainTimeConfidence_.load(), 0);
+    EXPECT_LE(g_service->remainTimeConfidence_.load(), 100);
+
+    info.SetChargeState(BatteryChargeState::CHARGE_STATE_NONE);
+    g_service->CalculateRemainingChargeTime(info);
+    EXPECT_EQ(g_service->remainTime_.load(), 0);
+    EXPECT_EQ(g_service->remainTimeConfidence_.load(), 0);
 
     BATTERY_HILOGI(LABEL_TEST, "BatteryService020 function end!");
 }
@@ -785,9 +863,9 @@ HWTEST_F(BatteryServiceTest, BatteryService037, TestSize.Level1)
 HWTEST_F(BatteryServiceTest, BatteryService038, TestSize.Level1)
 {
     BATTERY_HILOGI(LABEL_TEST, "BatteryService038 function start!");
-    auto ret = g_service->CapacityLevelCompare(TEST_CAPACITY_FIRST, TEST_CAPACITY_MIN, TEST_CAPACITY_MAX);
+    auto ret = BatterySocTable::CapacityLevelCompare(TEST_CAPACITY_FIRST, TEST_CAPACITY_MIN, TEST_CAPACITY_MAX);
     ASSERT_TRUE(ret);
-    ret = g_service->CapacityLevelCompare(TEST_CAPACITY_FIRST, TEST_CAPACITY_SECOND, TEST_CAPACITY_MAX);
+    ret = BatterySocTable::CapacityLevelCompare(TEST_CAPACITY_FIRST, TEST_CAPACITY_SECOND, TEST_CAPACITY_MAX);
     ASSERT_FALSE(ret);
     BATTERY_HILOGI(LABEL_TEST, "BatteryService038 function end!");
 }
@@ -803,46 +881,60 @@ static HWTEST_F(BatteryServiceTest, BatteryService039, TestSize.Level1)
     if (g_isMock) {
         auto tempCapacityThreshold = g_service->shutdownCapacityThreshold_;
         g_service->shutdownCapacityThreshold_ = 0;
+        g_service->BuildSocTable();
         TestUtils::WriteMock(MOCK_BATTERY_PATH + "/battery/capacity", "1");
         auto level = g_service->GetCapacityLevelInner();
         EXPECT_EQ(level, BatteryCapacityLevel::LEVEL_CRITICAL);
         g_service->shutdownCapacityThreshold_ = tempCapacityThreshold;
+        g_service->BuildSocTable();
         tempCapacityThreshold = g_service->criticalCapacityThreshold_;
         g_service->criticalCapacityThreshold_ = 0;
+        g_service->BuildSocTable();
         TestUtils::WriteMock(MOCK_BATTERY_PATH + "/battery/capacity", "4");
         level = g_service->GetCapacityLevelInner();
         EXPECT_EQ(level, BatteryCapacityLevel::LEVEL_WARNING);
         g_service->criticalCapacityThreshold_ = tempCapacityThreshold;
+        g_service->BuildSocTable();
         tempCapacityThreshold = g_service->warningCapacityThreshold_;
         g_service->warningCapacityThreshold_ = 0;
+        g_service->BuildSocTable();
         TestUtils::WriteMock(MOCK_BATTERY_PATH + "/battery/capacity", "10");
         level = g_service->GetCapacityLevelInner();
         EXPECT_EQ(level, BatteryCapacityLevel::LEVEL_LOW);
         g_service->warningCapacityThreshold_ = tempCapacityThreshold;
+        g_service->BuildSocTable();
         tempCapacityThreshold = g_service->lowCapacityThreshold_;
         g_service->lowCapacityThreshold_ = 0;
+        g_service->BuildSocTable();
         TestUtils::WriteMock(MOCK_BATTERY_PATH + "/battery/capacity", "15");
         level = g_service->GetCapacityLevelInner();
         EXPECT_EQ(level, BatteryCapacityLevel::LEVEL_NORMAL);
         g_service->lowCapacityThreshold_ = tempCapacityThreshold;
+        g_service->BuildSocTable();
         tempCapacityThreshold = g_service->normalCapacityThreshold_;
         g_service->normalCapacityThreshold_ = 0;
+        g_service->BuildSocTable();
         TestUtils::WriteMock(MOCK_BATTERY_PATH + "/battery/capacity", "90");
         level = g_service->GetCapacityLevelInner();
         EXPECT_EQ(level, BatteryCapacityLevel::LEVEL_HIGH);
         g_service->normalCapacityThreshold_ = tempCapacityThreshold;
+        g_service->BuildSocTable();
         tempCapacityThreshold = g_service->highCapacityThreshold_;
         g_service->highCapacityThreshold_ = 0;
+        g_service->BuildSocTable();
         TestUtils::WriteMock(MOCK_BATTERY_PATH + "/battery/capacity", "99");
         level = g_service->GetCapacityLevelInner();
         EXPECT_EQ(level, BatteryCapacityLevel::LEVEL_FULL);
         g_service->highCapacityThreshold_ = tempCapacityThreshold;
+        g_service->BuildSocTable();
         tempCapacityThreshold = g_service->fullCapacityThreshold_;
         g_service->fullCapacityThreshold_ = 0;
+        g_service->BuildSocTable();
         TestUtils::WriteMock(MOCK_BATTERY_PATH + "/battery/capacity", "100");
         level = g_service->GetCapacityLevelInner();
         EXPECT_EQ(level, BatteryCapacityLevel::LEVEL_NONE);
         g_service->fullCapacityThreshold_ = tempCapacityThreshold;
+        g_service->BuildSocTable();
         TestUtils::WriteMock(MOCK_BATTERY_PATH + "/battery/capacity", "50");
     }
     BATTERY_HILOGI(LABEL_TEST, "BatteryService039 function end!");
@@ -880,6 +972,905 @@ static HWTEST_F(BatteryServiceTest, BatteryService041, TestSize.Level1)
     BATTERY_HILOGI(LABEL_TEST, "BatteryService041 function end!");
 }
 
+/**
+ * @tc.name: BatteryService042
+ * @tc.desc: Test getters are served from the pushed battery snapshot
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService042, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService042 function start!");
+    int32_t maxAge = g_service->snapshotMaxAge_;
+    g_service->snapshotMaxAge_ = 60000;
+    BatteryInfo info;
+    info.SetVoltage(4123456);
+    info.SetTemperature(321);
+    info.SetTechnology("snapshot-ion");
+    g_service->UpdateSnapshot(info);
+    EXPECT_EQ(g_service->GetVoltageInner(), 4123456);
+    EXPECT_EQ(g_service->GetBatteryTemperatureInner(), 321);
+    EXPECT_EQ(g_service->GetTechnologyInner(), "snapshot-ion");
+    g_service->InvalidateSnapshot();
+    g_service->snapshotMaxAge_ = maxAge;
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService042 function end!");
+}
+
+/**
+ * @tc.name: BatteryService043
+ * @tc.desc: Test snapshot is not served when disabled or after being invalidated
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService043, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService043 function start!");
+    int32_t maxAge = g_service->snapshotMaxAge_;
+    g_service->snapshotMaxAge_ = 0;
+    BatteryInfo info;
+    g_service->UpdateSnapshot(info);
+    EXPECT_TRUE(g_service->LoadSnapshot()->info == nullptr);
+    EXPECT_TRUE(g_service->AcquireSnapshot() == nullptr);
+
+    g_service->snapshotMaxAge_ = 60000;
+    g_service->UpdateSnapshot(info);
+    EXPECT_TRUE(g_service->LoadSnapshot()->info != nullptr);
+    uint64_t seq = g_service->LoadSnapshot()->seq;
+    g_service->InvalidateSnapshot();
+    EXPECT_TRUE(g_service->LoadSnapshot()->info == nullptr);
+    EXPECT_EQ(g_service->LoadSnapshot()->seq, seq);
+    g_service->snapshotMaxAge_ = maxAge;
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService043 function end!");
+}
+
+/**
+ * @tc.name: BatteryService044
+ * @tc.desc: Test readers never see a torn snapshot while it is being replaced
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService044, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService044 function start!");
+    int32_t maxAge = g_service->snapshotMaxAge_;
+    g_service->snapshotMaxAge_ = 60000;
+    constexpr int32_t WRITE_TIMES = 2000;
+    constexpr int32_t READER_NUM = 4;
+    BatteryInfo first;
+    first.SetVoltage(0);
+    first.SetTemperature(0);
+    g_service->UpdateSnapshot(first);
+    std::atomic_bool torn { false };
+    std::atomic_bool done { false };
+    std::vector<std::thread> readers;
+    for (int32_t i = 0; i < READER_NUM; i++) {
+        readers.emplace_back([&torn, &done]() {
+            while (!done.load()) {
+                auto entry = g_service->LoadSnapshot();
+                if (entry->info != nullptr && entry->info->GetVoltage() != entry->info->GetTemperature()) {
+                    torn.store(true);
+                }
+            }
+        });
+    }
+    for (int32_t i = 1; i <= WRITE_TIMES; i++) {
+        BatteryInfo info;
+        info.SetVoltage(i);
+        info.SetTemperature(i);
+        g_service->UpdateSnapshot(info);
+    }
+    done.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_FALSE(torn.load());
+    EXPECT_EQ(g_service->GetVoltageInner(), WRITE_TIMES);
+    g_service->InvalidateSnapshot();
+    g_service->snapshotMaxAge_ = maxAge;
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService044 function end!");
+}
+
+/**
+ * @tc.name: BatteryService045
+ * @tc.desc: Test a steady-state battery event does not call the battery hdi
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService045, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService045 function start!");
+    g_service->Reset();
+    const BatteryInfo& current = g_service->batteryInfo_;
+    V2_0::BatteryInfo event;
+    event.capacity = current.GetCapacity();
+    event.voltage = current.GetVoltage();
+    event.temperature = current.GetTemperature();
+    event.healthState = static_cast<int32_t>(current.GetHealthState());
+    event.pluggedType = static_cast<int32_t>(current.GetPluggedType());
+    event.pluggedMaxCurrent = current.GetPluggedMaxCurrent();
+    event.pluggedMaxVoltage = current.GetPluggedMaxVoltage();
+    event.chargeState = static_cast<int32_t>(current.GetChargeState());
+    event.chargeCounter = current.GetChargeCounter();
+    event.totalEnergy = current.GetTotalEnergy();
+    event.curAverage = current.GetCurAverage();
+    event.remainEnergy = current.GetRemainEnergy();
+    event.present = current.IsPresent();
+    event.technology = current.GetTechnology();
+    event.curNow = current.GetNowCurrent();
+    event.uevent = "";
+
+    uint64_t hdiCalls = g_service->GetHdiCallCount();
+    const int32_t eventTimes = 5;
+    for (int32_t i = 0; i < eventTimes; i++) {
+        event.voltage++;
+        event.curNow++;
+        EXPECT_EQ(g_service->HandleBatteryCallbackEvent(event), ERR_OK);
+    }
+    EXPECT_EQ(g_service->GetHdiCallCount(), hdiCalls);
+    g_service->Reset();
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService045 function end!");
+}
+
+/**
+ * @tc.name: BatteryService046
+ * @tc.desc: Test the soc table maps every capacity to its level, light color and low state
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService046, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService046 function start!");
+    BatterySocTable::Thresholds thresholds;
+    thresholds.shutdown = 5;
+    thresholds.critical = 10;
+    thresholds.warning = 15;
+    thresholds.low = 20;
+    thresholds.normal = 90;
+    thresholds.high = 99;
+    thresholds.full = 100;
+    std::vector<BatteryConfig::LightConf> lightConf = {{0, 10, 0xFF0000}, {11, 90, 0xFFFF00}, {91, 100, 0x00FF00}};
+    BatterySocTable table;
+    table.Build(thresholds, 20, lightConf);
+    EXPECT_EQ(table.Lookup(0).level, BatteryCapacityLevel::LEVEL_SHUTDOWN);
+    EXPECT_EQ(table.Lookup(5).level, BatteryCapacityLevel::LEVEL_SHUTDOWN);
+    EXPECT_EQ(table.Lookup(6).level, BatteryCapacityLevel::LEVEL_CRITICAL);
+    EXPECT_EQ(table.Lookup(15).level, BatteryCapacityLevel::LEVEL_WARNING);
+    EXPECT_EQ(table.Lookup(20).level, BatteryCapacityLevel::LEVEL_LOW);
+    EXPECT_EQ(table.Lookup(50).level, BatteryCapacityLevel::LEVEL_NORMAL);
+    EXPECT_EQ(table.Lookup(99).level, BatteryCapacityLevel::LEVEL_HIGH);
+    EXPECT_EQ(table.Lookup(100).level, BatteryCapacityLevel::LEVEL_FULL);
+    EXPECT_EQ(table.Lookup(-1).level, BatteryCapacityLevel::LEVEL_NONE);
+    EXPECT_EQ(table.Lookup(101).level, BatteryCapacityLevel::LEVEL_NONE);
+    EXPECT_EQ(table.Lookup(10).rgb, 0xFF0000U);
+    EXPECT_EQ(table.Lookup(11).rgb, 0xFFFF00U);
+    EXPECT_EQ(table.Lookup(100).rgb, 0x00FF00U);
+    EXPECT_FALSE(table.Lookup(101).hasColor);
+    EXPECT_TRUE(table.IsLow(20));
+    EXPECT_TRUE(table.IsLow(-100));
+    EXPECT_FALSE(table.IsLow(21));
+    EXPECT_FALSE(table.IsLow(101));
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService046 function end!");
+}
+
+/**
+ * @tc.name: BatteryService047
+ * @tc.desc: Test the permission decision of a caller is cached until its token is invalidated
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService047, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService047 function start!");
+    BatteryPermissionCache cache;
+    bool isSystem = cache.IsSystem();
+    BatteryPermissionCache::Stats stats = cache.GetStats();
+    EXPECT_EQ(stats.misses, 1U);
+    EXPECT_EQ(stats.size, 1U);
+    EXPECT_EQ(cache.IsSystem(), isSystem);
+    stats = cache.GetStats();
+    EXPECT_EQ(stats.hits, 1U);
+
+    cache.Invalidate(static_cast<uint32_t>(IPCSkeleton::GetCallingFullTokenID()));
+    stats = cache.GetStats();
+    EXPECT_EQ(stats.invalidations, 1U);
+    EXPECT_EQ(stats.size, 0U);
+    EXPECT_EQ(cache.IsSystem(), isSystem);
+    stats = cache.GetStats();
+    EXPECT_EQ(stats.misses, 2U);
+
+    // grants are not cached without a permission state subscription
+    cache.IsNativePermissionGranted("ohos.permission.POWER_OPTIMIZATION");
+    cache.IsNativePermissionGranted("ohos.permission.POWER_OPTIMIZATION");
+    stats = cache.GetStats();
+    EXPECT_EQ(stats.misses, 4U);
+    EXPECT_EQ(stats.hits, 1U);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService047 function end!");
+}
+
+/**
+ * @tc.name: BatteryService048
+ * @tc.desc: Test the scene config cache write-through invalidation, ttl and flush
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService048, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService048 function start!");
+    const std::string sceneName = "wireless";
+    BatterySceneConfigCache cache;
+    cache.SetMaxAge(10000);
+    std::string value;
+    bool isSupported = false;
+    uint64_t generation = 0;
+    EXPECT_FALSE(cache.GetValue(sceneName, value, generation));
+    cache.PutValue(sceneName, "1", generation);
+    EXPECT_TRUE(cache.GetValue(sceneName, value, generation));
+    EXPECT_EQ(value, "1");
+
+    // a read racing with a write must not store the old value
+    cache.Invalidate(sceneName);
+    EXPECT_FALSE(cache.GetValue(sceneName, value, generation));
+    cache.Invalidate(sceneName);
+    cache.PutValue(sceneName, "1", generation);
+    EXPECT_FALSE(cache.GetValue(sceneName, value, generation));
+
+    EXPECT_FALSE(cache.GetSupported(sceneName, isSupported, generation));
+    cache.PutSupported(sceneName, true, generation);
+    EXPECT_TRUE(cache.GetSupported(sceneName, isSupported, generation));
+    EXPECT_TRUE(isSupported);
+    cache.Clear();
+    EXPECT_FALSE(cache.GetSupported(sceneName, isSupported, generation));
+
+    cache.SetMaxAge(0);
+    EXPECT_FALSE(cache.GetValue(sceneName, value, generation));
+    cache.PutValue(sceneName, "1", generation);
+    EXPECT_FALSE(cache.GetValue(sceneName, value, generation));
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService048 function end!");
+}
+
+/**
+ * @tc.name: BatteryService049
+ * @tc.desc: Test the startup phases are recorded once and in order
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService049, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService049 function start!");
+    const BatteryStartupStats& stats = g_service->GetStartupStats();
+    EXPECT_TRUE(stats.IsMarked(BatteryStartupStats::ON_START));
+    EXPECT_TRUE(stats.IsMarked(BatteryStartupStats::CONFIG_LOADED));
+    EXPECT_TRUE(stats.IsMarked(BatteryStartupStats::VIBRATOR_LOADED));
+    EXPECT_TRUE(stats.IsMarked(BatteryStartupStats::INIT_DONE));
+    int64_t onStart = stats.GetTime(BatteryStartupStats::ON_START);
+    EXPECT_LE(onStart, stats.GetTime(BatteryStartupStats::CONFIG_LOADED));
+    EXPECT_LE(stats.GetTime(BatteryStartupStats::VIBRATOR_LOADED), stats.GetTime(BatteryStartupStats::INIT_DONE));
+    EXPECT_LE(stats.GetTime(BatteryStartupStats::CONFIG_LOADED), stats.GetTime(BatteryStartupStats::INIT_DONE));
+
+    BatteryStartupStats local;
+    EXPECT_FALSE(local.IsMarked(BatteryStartupStats::FIRST_CHANGED));
+    local.Mark(BatteryStartupStats::FIRST_CHANGED);
+    int64_t first = local.GetTime(BatteryStartupStats::FIRST_CHANGED);
+    EXPECT_GT(first, 0);
+    usleep(2000);
+    local.Mark(BatteryStartupStats::FIRST_CHANGED);
+    EXPECT_EQ(first, local.GetTime(BatteryStartupStats::FIRST_CHANGED));
+    EXPECT_EQ(local.GetTime(BatteryStartupStats::PHASE_COUNT), 0);
+    EXPECT_STREQ(BatteryStartupStats::GetName(BatteryStartupStats::FIRST_CHANGED), "firstChanged");
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService049 function end!");
+}
+
+/**
+ * @tc.name: BatteryService050
+ * @tc.desc: Test the binary event log ring and the text log limiter
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService050, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService050 function start!");
+    auto eventLog = std::make_unique<BatteryEventLog>();
+    BatteryInfo info;
+    info.SetUevent("battery_uevent_with_a_name_longer_than_the_record$sendcommonevent");
+    const uint32_t total = BatteryEventLog::CAPACITY + 10;
+    for (uint32_t i = 1; i <= total; i++) {
+        info.SetCapacity(static_cast<int32_t>(i));
+        eventLog->Append(BatteryEventLog::SOURCE_EVENT, info, BatteryInfo::FIELD_CAPACITY);
+    }
+    std::vector<BatteryEventLog::Record> records = eventLog->GetRecords();
+    EXPECT_EQ(eventLog->GetTotal(), total);
+    ASSERT_EQ(records.size(), BatteryEventLog::CAPACITY);
+    EXPECT_EQ(records.front().seq, total - BatteryEventLog::CAPACITY + 1);
+    EXPECT_EQ(records.back().seq, total);
+    EXPECT_EQ(records.back().capacity, static_cast<int32_t>(total));
+    EXPECT_EQ(records.back().changedFields, BatteryInfo::FIELD_CAPACITY);
+    EXPECT_EQ(strlen(records.back().uevent), BatteryEventLog::UEVENT_LEN - 1);
+
+    int32_t level = BatteryEventLog::GetLevel();
+    uint32_t suppressed = 0;
+    BatteryEventLog::SetLevel(BatteryEventLog::LEVEL_BINARY);
+    BatteryLogLimiter binaryLimiter;
+    EXPECT_FALSE(binaryLimiter.Allow(suppressed));
+    BatteryEventLog::SetLevel(BatteryEventLog::LEVEL_LIMITED);
+    BatteryLogLimiter limiter;
+    for (uint32_t i = 0; i < BatteryLogLimiter::BURST; i++) {
+        EXPECT_TRUE(limiter.Allow(suppressed));
+    }
+    EXPECT_FALSE(limiter.Allow(suppressed));
+    EXPECT_FALSE(limiter.Allow(suppressed));
+    BatteryEventLog::SetLevel(BatteryEventLog::LEVEL_FULL);
+    EXPECT_TRUE(limiter.Allow(suppressed));
+    EXPECT_EQ(suppressed, 2U);
+    BatteryEventLog::SetLevel(BatteryEventLog::LEVEL_FULL + 1);
+    EXPECT_EQ(BatteryEventLog::GetLevel(), BatteryEventLog::LEVEL_FULL);
+    BatteryEventLog::SetLevel(level);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService050 function end!");
+}
+
+/**
+ * @tc.name: BatteryService051
+ * @tc.desc: Test the event stage counters of the battery trace
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService051, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService051 function start!");
+    BatteryTrace& trace = BatteryTrace::GetInstance();
+    trace.Reset();
+    {
+        BatteryTraceScope scope(BatteryTraceStage::PUBLISH_CHANGED);
+        EXPECT_TRUE(scope.Check(true));
+        EXPECT_FALSE(scope.Check(false));
+    }
+    {
+        BatteryTraceScope scope(BatteryTraceStage::LIGHT);
+    }
+    trace.CountEvent();
+    std::vector<BatteryTrace::StageStats> stages = trace.GetStageStats();
+    ASSERT_EQ(stages.size(), BatteryTrace::STAGE_COUNT);
+    const auto& changed = stages[static_cast<uint32_t>(BatteryTraceStage::PUBLISH_CHANGED)];
+    EXPECT_STREQ(changed.name, "battery_publish_changed");
+    // hdi pushes may be handled concurrently, the scopes above are a lower bound
+    EXPECT_GE(changed.count, 1U);
+    EXPECT_GE(changed.failures, 1U);
+    EXPECT_EQ(stages[static_cast<uint32_t>(BatteryTraceStage::LIGHT)].failures, 0U);
+    EXPECT_GE(trace.GetPublishFailures(), 1U);
+    EXPECT_GE(trace.GetEvents(), 1U);
+    EXPECT_LE(trace.GetRecentEvents(), trace.GetEvents());
+    trace.Reset();
+    EXPECT_EQ(trace.GetEvents(), 0U);
+    EXPECT_EQ(trace.GetStageStats()[static_cast<uint32_t>(BatteryTraceStage::PUBLISH_CHANGED)].count, 0U);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService051 function end!");
+}
+
+/**
+ * @tc.name: BatteryService052
+ * @tc.desc: Test the delta encoded battery history ring, its range filter and block recycling
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService052, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService052 function start!");
+    auto history = std::make_unique<BatteryHistory>();
+    EXPECT_TRUE(history->GetSamples(INT64_MIN, INT64_MAX).empty());
+    const int64_t start = 1760000000000;
+    const int64_t interval = 10000;
+    const uint32_t count = 8640; // 24 h of 10 s samples
+    for (uint32_t i = 0; i < count; i++) {
+        BatteryHistory::Sample sample;
+        sample.time = start + i * interval;
+        sample.capacity = 100 - static_cast<int32_t>(i / 100);
+        sample.voltage = 4200000 - static_cast<int32_t>(i);
+        sample.current = (i % 2 == 0) ? -500000 : 500000;
+        sample.temperature = 300 + static_cast<int32_t>(i % 5);
+        sample.chargeState = static_cast<int32_t>(i % 4);
+        history->Append(sample);
+    }
+    BatteryHistory::Stats stats = history->GetStats();
+    EXPECT_EQ(stats.samples, count);
+    EXPECT_LT(stats.bytes, BatteryHistory::BLOCK_SIZE * BatteryHistory::BLOCK_COUNT / 2);
+    std::vector<BatteryHistory::Sample> samples = history->GetSamples(INT64_MIN, INT64_MAX);
+    ASSERT_EQ(samples.size(), count);
+    EXPECT_EQ(samples.back().time, start + (count - 1) * interval);
+    EXPECT_EQ(samples.back().voltage, 4200000 - static_cast<int32_t>(count - 1));
+    EXPECT_EQ(samples.back().current, 500000);
+    EXPECT_EQ(samples.back().chargeState, static_cast<int32_t>((count - 1) % 4));
+
+    samples = history->GetSamples(start + 100 * interval, start + 109 * interval);
+    ASSERT_EQ(samples.size(), 10U);
+    EXPECT_EQ(samples.front().time, start + 100 * interval);
+    EXPECT_EQ(samples.front().capacity, 99);
+
+    // a clock set backwards starts a new block and keeps the old samples
+    BatteryHistory::Sample early;
+    early.time = start;
+    early.voltage = INT32_MIN;
+    early.current = INT32_MAX;
+    history->Append(early);
+    samples = history->GetSamples(start, start);
+    ASSERT_EQ(samples.size(), 2U);
+    EXPECT_EQ(samples.back().voltage, INT32_MIN);
+    EXPECT_EQ(samples.back().current, INT32_MAX);
+
+    for (uint32_t i = 0; i < count * 10; i++) {
+        BatteryHistory::Sample sample;
+        sample.time = start + (count + i) * interval;
+        history->Append(sample);
+    }
+    stats = history->GetStats();
+    EXPECT_EQ(stats.blocks, BatteryHistory::BLOCK_COUNT);
+    samples = history->GetSamples(INT64_MIN, INT64_MAX);
+    ASSERT_FALSE(samples.empty());
+    EXPECT_GT(samples.front().time, start + count * interval);
+    EXPECT_EQ(samples.back().time, start + (count * 11 - 1) * interval);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService052 function end!");
+}
+
+/**
+ * @tc.name: BatteryService053
+ * @tc.desc: Test the battery journal survives a reopen and stops recovery at a torn record
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService053, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService053 function start!");
+    namespace Journal = BatteryJournalFormat;
+    const std::string path = "/data/local/tmp/battery_journal_test";
+    const uint32_t capacity = 8;
+    remove(path.c_str());
+    {
+        BatteryJournal journal;
+        ASSERT_TRUE(journal.Open(path, capacity));
+        BatteryInfo info;
+        for (int32_t i = 1; i <= 10; i++) {
+            info.SetCapacity(i);
+            journal.Append(i, info, BatteryInfo::FIELD_CAPACITY);
+        }
+        EXPECT_EQ(journal.GetNextSeq(), 11U);
+        EXPECT_TRUE(journal.Flush());
+    }
+    BatteryJournal journal;
+    ASSERT_TRUE(journal.Open(path, capacity));
+    EXPECT_EQ(journal.GetNextSeq(), 11U);
+    journal.Close();
+    EXPECT_FALSE(journal.Flush());
+
+    int32_t fd = open(path.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+    size_t size = Journal::HEADER_SIZE + capacity * sizeof(Journal::Record);
+    void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    ASSERT_NE(mapped, MAP_FAILED);
+    auto base = static_cast<uint8_t*>(mapped);
+    auto header = reinterpret_cast<Journal::Header*>(base);
+    EXPECT_TRUE(Journal::IsValidHeader(*header, size));
+    EXPECT_EQ(Journal::GetFirstSeq(*header, header->nextSeq), 3U);
+    EXPECT_EQ(Journal::GetRecord(base, *header, 10).capacity, 10);
+    // a cursor lagging behind the records is moved forward, a torn record ends the scan
+    header->nextSeq = 5;
+    EXPECT_EQ(Journal::RecoverNextSeq(base, *header), 11U);
+    Journal::GetRecord(base, *header, 9).voltage++;
+    EXPECT_EQ(Journal::RecoverNextSeq(base, *header), 9U);
+    munmap(mapped, size);
+
+    ASSERT_TRUE(journal.Open(path, capacity));
+    EXPECT_EQ(journal.GetNextSeq(), 9U);
+    journal.Close();
+    ASSERT_TRUE(journal.Open(path, capacity * 2));
+    EXPECT_EQ(journal.GetNextSeq(), 1U);
+    journal.Close();
+    remove(path.c_str());
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService053 function end!");
+}
+
+/**
+ * @tc.name: BatteryService054
+ * @tc.desc: Test the sliding window aggregates expire old samples and keep min/max/avg
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService054, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService054 function start!");
+    const int64_t second = 1000;
+    BatteryStatsWindows windows;
+    windows.Add(0, { -100, 4000000, 300 });
+    windows.Add(30 * second, { 200, 3900000, 320 });
+    windows.Add(90 * second, { 50, 3950000, 310 });
+    BatteryWindowStats stats;
+    ASSERT_TRUE(windows.Get(60, 100 * second, stats));
+    EXPECT_EQ(stats.GetWindowSeconds(), 60);
+    EXPECT_EQ(stats.GetSampleCount(), 1U);
+    EXPECT_EQ(stats.GetCurrent().min, 50);
+    EXPECT_EQ(stats.GetCurrent().max, 50);
+    ASSERT_TRUE(windows.Get(300, 100 * second, stats));
+    EXPECT_EQ(stats.GetSampleCount(), 3U);
+    EXPECT_EQ(stats.GetCurrent().min, -100);
+    EXPECT_EQ(stats.GetCurrent().max, 200);
+    EXPECT_EQ(stats.GetCurrent().avg, 50);
+    EXPECT_EQ(stats.GetVoltage().min, 3900000);
+    EXPECT_EQ(stats.GetVoltage().max, 4000000);
+    EXPECT_EQ(stats.GetTemperature().avg, 310);
+    // nothing was added for more than a minute, the 1 minute window is empty
+    ASSERT_TRUE(windows.Get(60, 200 * second, stats));
+    EXPECT_EQ(stats.GetSampleCount(), 0U);
+    EXPECT_FALSE(windows.Get(120, 200 * second, stats));
+
+    BatteryStatsWindow window(60 * second);
+    for (uint32_t i = 0; i < BatteryStatsWindow::MAX_SAMPLES + 10; i++) {
+        window.Add(i, { static_cast<int32_t>(i), 0, 0 });
+    }
+    EXPECT_EQ(window.GetSampleCount(), BatteryStatsWindow::MAX_SAMPLES);
+    EXPECT_EQ(window.GetAggregate(BatteryStatsWindow::METRIC_CURRENT).min, 10);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService054 function end!");
+}
+
+/**
+ * @tc.name: BatteryService055
+ * @tc.desc: Test the remaining discharge time follows the drain rate and drops on plugging in
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService055, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService055 function start!");
+    constexpr int64_t msPerHour = 3600000;
+    constexpr int64_t timeConstantMs = BatteryDischargeTimeEstimator::TIME_CONSTANT_MS;
+    BatteryDischargeTimeEstimator estimator;
+    BatteryInfo info;
+    info.SetPluggedType(BatteryPluggedType::PLUGGED_TYPE_NONE);
+    info.SetRemainEnergy(2000);
+    info.SetNowCurrent(-500);
+    estimator.Update(0, info);
+    EXPECT_EQ(estimator.GetRemainingMs(), 4 * msPerHour);
+
+    // a load step moves the rate by 1 - 1/e after one time constant
+    info.SetNowCurrent(-1500);
+    estimator.Update(timeConstantMs, info);
+    double expectedRate = 1500 - 1000 * std::exp(-1.0);
+    EXPECT_NEAR(estimator.GetDrainRate(), expectedRate, 0.01);
+    EXPECT_NEAR(static_cast<double>(estimator.GetRemainingMs()), 2000 / expectedRate * msPerHour, 1.0);
+
+    // the same step split over many events ends at the same rate
+    BatteryDischargeTimeEstimator stepped;
+    info.SetNowCurrent(-500);
+    stepped.Update(0, info);
+    info.SetNowCurrent(-1500);
+    constexpr int64_t steps = 30;
+    for (int64_t i = 1; i <= steps; i++) {
+        stepped.Update(timeConstantMs * i / steps, info);
+    }
+    EXPECT_NEAR(stepped.GetDrainRate(), expectedRate, 0.01);
+
+    info.SetRemainEnergy(INVALID_BATT_INT_VALUE);
+    estimator.Update(timeConstantMs * 2, info);
+    EXPECT_EQ(estimator.GetRemainingMs(), 0);
+
+    info.SetRemainEnergy(2000);
+    info.SetPluggedType(BatteryPluggedType::PLUGGED_TYPE_AC);
+    estimator.Update(timeConstantMs * 3, info);
+    EXPECT_EQ(estimator.GetRemainingMs(), 0);
+    EXPECT_EQ(estimator.GetDrainRate(), 0);
+
+    int64_t remainTime = -1;
+    CacheSystemDecision(true);
+    EXPECT_EQ(g_service->GetRemainingDischargeTime(remainTime), ERR_OK);
+    EXPECT_GE(remainTime, 0);
+    // derived from the remaining energy, denied to non-system callers like GetRemainEnergy
+    CacheSystemDecision(false);
+    EXPECT_EQ(g_service->GetRemainingDischargeTime(remainTime), ERR_OK);
+    EXPECT_EQ(remainTime, INVALID_REMAINING_CHARGE_TIME_VALUE);
+    ClearSystemDecision();
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService055 function end!");
+}
+
+/**
+ * @tc.name: BatteryService056
+ * @tc.desc: Test the charge session statistics integrate the samples between plugging in and unplugging
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService056, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService056 function start!");
+    constexpr int64_t msPerHour = 3600000;
+    constexpr int64_t startTime = 1700000000000;
+    BatteryChargeSessionStats stats;
+    BatteryInfo info;
+    info.SetPluggedType(BatteryPluggedType::PLUGGED_TYPE_AC);
+    info.SetCapacity(20);
+    info.SetNowCurrent(1000);
+    info.SetVoltage(4000000);
+    info.SetTemperature(300);
+    info.SetChargeType(ChargeType::WIRED_QUICK);
+    stats.Update(0, info);
+    EXPECT_TRUE(stats.GetSessions().empty());
+
+    stats.Begin(startTime, 0, info);
+    ASSERT_EQ(stats.GetSessions().size(), 1U);
+    EXPECT_TRUE(stats.GetSessions()[0].active);
+
+    info.SetCapacity(60);
+    info.SetNowCurrent(2000);
+    info.SetVoltage(4200000);
+    info.SetTemperature(350);
+    info.SetChargeType(ChargeType::WIRED_NORMAL);
+    stats.Update(msPerHour, info);
+    info.SetCapacity(80);
+    info.SetTemperature(320);
+    stats.End(msPerHour + msPerHour / 2, info);
+
+    auto sessions = stats.GetSessions();
+    ASSERT_EQ(sessions.size(), 1U);
+    const BatteryChargeSessions::Session& session = sessions[0];
+    EXPECT_FALSE(session.active);
+    EXPECT_EQ(session.startTime, startTime);
+    EXPECT_EQ(session.duration, msPerHour + msPerHour / 2);
+    EXPECT_EQ(session.startCapacity, 20);
+    EXPECT_EQ(session.endCapacity, 80);
+    // 1000 mA at 4.0 V for an hour, then 2000 mA at 4.2 V for half an hour
+    EXPECT_EQ(session.chargeDelivered, 2000);
+    EXPECT_EQ(session.energyDelivered, 8200);
+    EXPECT_EQ(session.peakCurrent, 2000);
+    EXPECT_EQ(session.averageCurrent, 1333);
+    EXPECT_EQ(session.minTemperature, 300);
+    EXPECT_EQ(session.maxTemperature, 350);
+    EXPECT_EQ(session.chargeTypeTime[static_cast<size_t>(ChargeType::WIRED_QUICK)], msPerHour);
+    EXPECT_EQ(session.chargeTypeTime[static_cast<size_t>(ChargeType::WIRED_NORMAL)], msPerHour / 2);
+
+    // the ring keeps the newest sessions
+    for (size_t i = 0; i < BatteryChargeSessionStats::MAX_SESSIONS + 2; i++) {
+        stats.Begin(startTime + static_cast<int64_t>(i), static_cast<int64_t>(i), info);
+        stats.End(static_cast<int64_t>(i) + 1, info);
+    }
+    sessions = stats.GetSessions();
+    ASSERT_EQ(sessions.size(), BatteryChargeSessionStats::MAX_SESSIONS);
+    EXPECT_EQ(sessions.back().startTime, startTime + static_cast<int64_t>(BatteryChargeSessionStats::MAX_SESSIONS + 1));
+
+    CacheSystemDecision(true);
+    BatteryChargeSessions all;
+    EXPECT_EQ(g_service->GetChargeSessionsInner(all), BatteryError::ERR_OK);
+    EXPECT_LE(all.GetSessions().size(), BatteryChargeSessionStats::MAX_SESSIONS + 1);
+    ClearSystemDecision();
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService056 function end!");
+}
+
+/**
+ * @tc.name: BatteryService057
+ * @tc.desc: Test the energy integrator accumulates monotonic charge and energy totals
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService057, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService057 function start!");
+    constexpr int64_t msPerHour = 3600000;
+    BatteryEnergyIntegrator integrator;
+    EXPECT_EQ(integrator.GetCounters(msPerHour).chargeOut, 0);
+
+    BatteryInfo info;
+    info.SetNowCurrent(-500);
+    info.SetVoltage(4000000);
+    integrator.Update(0, info);
+    info.SetNowCurrent(1000);
+    info.SetVoltage(4200000);
+    integrator.Update(msPerHour, info);
+
+    // 500 mA drawn at 4.0 V for an hour, then 1000 mA charged at 4.2 V held for half an hour
+    BatteryEnergyIntegrator::Counters counters = integrator.GetCounters(msPerHour + msPerHour / 2);
+    EXPECT_EQ(counters.time, msPerHour + msPerHour / 2);
+    EXPECT_EQ(counters.sampleCount, 2U);
+    EXPECT_EQ(counters.chargeOut, 500000);
+    EXPECT_EQ(counters.energyOut, 2000000);
+    EXPECT_EQ(counters.chargeIn, 500000);
+    EXPECT_EQ(counters.energyIn, 2100000);
+
+    // a reading before the last sample is not extended backwards
+    counters = integrator.GetCounters(0);
+    EXPECT_EQ(counters.time, msPerHour);
+    EXPECT_EQ(counters.chargeIn, 0);
+
+    // an invalid current stops the integration instead of counting a bogus value
+    info.SetNowCurrent(INVALID_BATT_INT_VALUE);
+    integrator.Update(2 * msPerHour, info);
+    counters = integrator.GetCounters(3 * msPerHour);
+    EXPECT_EQ(counters.chargeIn, 1000000);
+    EXPECT_EQ(counters.chargeOut, 500000);
+    EXPECT_EQ(counters.sampleCount, 3U);
+
+    CacheSystemDecision(true);
+    BatteryEnergyCounters first;
+    EXPECT_EQ(g_service->GetEnergyCountersInner(first), BatteryError::ERR_OK);
+    BatteryEnergyCounters second;
+    EXPECT_EQ(g_service->GetEnergyCountersInner(second), BatteryError::ERR_OK);
+    EXPECT_GE(second.GetCounters().chargeOut, first.GetCounters().chargeOut);
+    EXPECT_GE(second.GetCounters().time, first.GetCounters().time);
+    ClearSystemDecision();
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService057 function end!");
+}
+
+/**
+ * @tc.name: BatteryService058
+ * @tc.desc: Test the listener manager filters by field mask and coalesces changes within the interval
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService058, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService058 function start!");
+    constexpr int32_t testPid = 1000;
+    constexpr int64_t intervalMs = 300;
+    constexpr int32_t waitMs = 1000;
+    BatteryListenerManager manager;
+    sptr<TestBatteryListener> listener = sptr<TestBatteryListener>::MakeSptr();
+    EXPECT_EQ(manager.Register(nullptr, BatteryInfo::FIELD_CAPACITY, 0, testPid, true),
+        BatteryError::ERR_PARAM_INVALID);
+    EXPECT_EQ(manager.Register(listener, BatteryInfo::FIELD_NONE, 0, testPid, true), BatteryError::ERR_PARAM_INVALID);
+    EXPECT_EQ(manager.Register(listener, BatteryInfo::FIELD_CAPACITY, -1, testPid, true),
+        BatteryError::ERR_PARAM_INVALID);
+    EXPECT_EQ(manager.Register(listener, BatteryInfo::FIELD_CAPACITY, BatteryListenerManager::MAX_INTERVAL_MS + 1,
+        testPid, true), BatteryError::ERR_PARAM_INVALID);
+    EXPECT_EQ(manager.Register(listener, BatteryInfo::FIELD_REMAIN_ENERGY, 0, testPid, false),
+        BatteryError::ERR_SYSTEM_API_DENIED);
+    EXPECT_FALSE(manager.HasListeners());
+
+    EXPECT_EQ(manager.Register(listener, BatteryInfo::FIELD_CAPACITY | BatteryInfo::FIELD_PLUGGED_TYPE, intervalMs,
+        testPid, true), BatteryError::ERR_OK);
+    EXPECT_TRUE(manager.HasListeners());
+    BatteryInfo info;
+    info.SetCapacity(TEST_CAPACITY_FIRST);
+    info.SetRemainEnergy(2000);
+    BatteryInfoSnapshot snapshot;
+    snapshot.SetInfo(info);
+    manager.Notify(BatteryInfo::FIELD_VOLTAGE, snapshot, snapshot);
+    manager.Notify(BatteryInfo::FIELD_CAPACITY | BatteryInfo::FIELD_VOLTAGE, snapshot, snapshot);
+    ASSERT_TRUE(listener->WaitCalls(1, waitMs));
+    EXPECT_EQ(listener->fields_, BatteryInfo::FIELD_CAPACITY);
+    EXPECT_EQ(listener->capacity_, TEST_CAPACITY_FIRST);
+    EXPECT_EQ(listener->remainEnergy_, 2000);
+
+    // both changes fall within the interval and arrive as one call carrying the latest state
+    manager.Notify(BatteryInfo::FIELD_PLUGGED_TYPE, snapshot, snapshot);
+    info.SetCapacity(TEST_CAPACITY_SECOND);
+    snapshot.SetInfo(info);
+    manager.Notify(BatteryInfo::FIELD_CAPACITY, snapshot, snapshot);
+    ASSERT_TRUE(listener->WaitCalls(2, waitMs));
+    EXPECT_EQ(listener->fields_, BatteryInfo::FIELD_CAPACITY | BatteryInfo::FIELD_PLUGGED_TYPE);
+    EXPECT_EQ(listener->capacity_, TEST_CAPACITY_SECOND);
+    EXPECT_FALSE(listener->WaitCalls(3, intervalMs * 2));
+    BatteryListenerManager::Stats stats = manager.GetStats();
+    EXPECT_EQ(stats.listeners, 1U);
+    EXPECT_EQ(stats.notified, 3U);
+    EXPECT_EQ(stats.coalesced, 1U);
+    EXPECT_EQ(stats.delivered, 2U);
+
+    EXPECT_EQ(manager.Unregister(listener), BatteryError::ERR_OK);
+    EXPECT_FALSE(manager.HasListeners());
+    manager.Notify(BatteryInfo::FIELD_CAPACITY, snapshot, snapshot);
+    EXPECT_FALSE(listener->WaitCalls(3, intervalMs * 2));
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService058 function end!");
+}
+
+/**
+ * @tc.name: BatteryService059
+ * @tc.desc: Test the listener manager limits the subscribers of a process and hides the system fields
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService059, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService059 function start!");
+    constexpr int32_t testPid = 1000;
+    constexpr int32_t waitMs = 1000;
+    BatteryListenerManager manager;
+    std::vector<sptr<TestBatteryListener>> listeners;
+    for (size_t i = 0; i < BatteryListenerManager::MAX_LISTENERS_PER_PID; i++) {
+        listeners.push_back(sptr<TestBatteryListener>::MakeSptr());
+        EXPECT_EQ(manager.Register(listeners.back(), BatteryInfo::FIELD_CAPACITY, 0, testPid, false),
+            BatteryError::ERR_OK);
+    }
+    sptr<TestBatteryListener> extra = sptr<TestBatteryListener>::MakeSptr();
+    EXPECT_EQ(manager.Register(extra, BatteryInfo::FIELD_CAPACITY, 0, testPid, false), BatteryError::ERR_FAILURE);
+    EXPECT_EQ(manager.Register(extra, BatteryInfo::FIELD_CAPACITY, 0, testPid + 1, false), BatteryError::ERR_OK);
+    // registering again only updates the subscription
+    EXPECT_EQ(manager.Register(extra, BatteryInfo::FIELD_CAPACITY | BatteryInfo::FIELD_REMAIN_ENERGY, 0,
+        testPid + 1, false), BatteryError::ERR_OK);
+    EXPECT_EQ(manager.GetStats().listeners, BatteryListenerManager::MAX_LISTENERS_PER_PID + 1);
+
+    BatteryInfo info;
+    info.SetRemainEnergy(2000);
+    BatteryInfoSnapshot systemSnapshot;
+    systemSnapshot.SetInfo(info);
+    info.SetRemainEnergy(INVALID_BATT_INT_VALUE);
+    BatteryInfoSnapshot publicSnapshot;
+    publicSnapshot.SetInfo(info);
+    manager.Notify(BatteryInfo::FIELD_REMAIN_ENERGY, systemSnapshot, publicSnapshot);
+    EXPECT_FALSE(extra->WaitCalls(1, waitMs / 2));
+    manager.Notify(BatteryInfo::FIELD_CAPACITY | BatteryInfo::FIELD_REMAIN_ENERGY, systemSnapshot, publicSnapshot);
+    ASSERT_TRUE(extra->WaitCalls(1, waitMs));
+    EXPECT_EQ(extra->fields_, BatteryInfo::FIELD_CAPACITY);
+    EXPECT_EQ(extra->remainEnergy_, INVALID_BATT_INT_VALUE);
+
+    sptr<TestBatteryListener> listener = sptr<TestBatteryListener>::MakeSptr();
+    EXPECT_EQ(g_service->RegisterBatteryListenerInner(listener, BatteryInfo::FIELD_CAPACITY, 0),
+        BatteryError::ERR_OK);
+    EXPECT_GE(g_service->GetListenerStats().listeners, 1U);
+    EXPECT_EQ(g_service->UnregisterBatteryListenerInner(listener), BatteryError::ERR_OK);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService059 function end!");
+}
+
+/**
+ * @tc.name: BatteryService060
+ * @tc.desc: Test GetChargeSessions is denied to non-system callers
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService060, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService060 function start!");
+    CacheSystemDecision(false);
+    BatteryChargeSessions sessions;
+    int32_t batteryErr = static_cast<int32_t>(BatteryError::ERR_OK);
+    EXPECT_EQ(g_service->GetChargeSessions(sessions, batteryErr), ERR_OK);
+    EXPECT_EQ(batteryErr, static_cast<int32_t>(BatteryError::ERR_SYSTEM_API_DENIED));
+    EXPECT_TRUE(sessions.GetSessions().empty());
+    ClearSystemDecision();
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService060 function end!");
+}
+
+/**
+ * @tc.name: BatteryService061
+ * @tc.desc: Test GetEnergyCounters is denied to non-system callers
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService061, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService061 function start!");
+    CacheSystemDecision(false);
+    BatteryEnergyCounters counters;
+    int32_t batteryErr = static_cast<int32_t>(BatteryError::ERR_OK);
+    EXPECT_EQ(g_service->GetEnergyCounters(counters, batteryErr), ERR_OK);
+    EXPECT_EQ(batteryErr, static_cast<int32_t>(BatteryError::ERR_SYSTEM_API_DENIED));
+    EXPECT_EQ(counters.GetCounters().sampleCount, 0U);
+    EXPECT_EQ(counters.GetCounters().chargeOut, 0);
+    ClearSystemDecision();
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService061 function end!");
+}
+
+/**
+ * @tc.name: BatteryService062
+ * @tc.desc: Test boot actions beyond the ipc batch limit are all read when filling the boot common event
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryServiceTest, BatteryService062, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService062 function start!");
+    constexpr int32_t actionCount = 40;
+    auto& config = BatteryConfig::GetInstance();
+    auto savedConf = config.commonEventConf_;
+    config.commonEventConf_.clear();
+    g_service->sceneConfigCache_.SetMaxAge(10000);
+    std::vector<std::string> sceneNames;
+    for (int32_t i = 0; i < actionCount; i++) {
+        BatteryConfig::CommonEventConf conf;
+        conf.eventName = "test.event." + std::to_string(i);
+        conf.sceneConfigName = "test_boot_scene_" + std::to_string(i);
+        conf.sceneConfigEqual = true;
+        conf.sceneConfigValue = "1";
+        conf.uevent = "test_uevent_" + std::to_string(i) + "=";
+        config.commonEventConf_.push_back(conf);
+        sceneNames.push_back(conf.sceneConfigName);
+        // only the last action matches, so every entry has to be read
+        std::string value;
+        uint64_t generation = 0;
+        g_service->sceneConfigCache_.GetValue(conf.sceneConfigName, value, generation);
+        g_service->sceneConfigCache_.PutValue(conf.sceneConfigName, (i == actionCount - 1) ? "1" : "0", generation);
+    }
+    std::string ueventName;
+    std::string commonEventName;
+    EXPECT_TRUE(g_service->FillCommonEvent(ueventName, commonEventName));
+    EXPECT_EQ(commonEventName, "test.event." + std::to_string(actionCount - 1));
+    EXPECT_EQ(ueventName, "test_uevent_" + std::to_string(actionCount - 1) + "=1");
+
+    // a single ipc is still bounded
+    CacheSystemDecision(true);
+    std::vector<std::string> results;
+    std::vector<int32_t> batteryErrs;
+    int32_t batteryErr = static_cast<int32_t>(BatteryError::ERR_OK);
+    EXPECT_EQ(g_service->GetBatteryConfigs(sceneNames, results, batteryErrs, batteryErr), ERR_OK);
+    EXPECT_EQ(batteryErr, static_cast<int32_t>(BatteryError::ERR_PARAM_INVALID));
+    EXPECT_TRUE(results.empty());
+    ClearSystemDecision();
+
+    config.commonEventConf_ = savedConf;
+    g_service->sceneConfigCache_.SetMaxAge(g_service->sceneConfigMaxAge_);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryService062 function end!");
+}
+
 /**
  * @tc.name: BatteryXCollie001
  * @tc.desc: Test functions BatteryXCollie default
@@ -924,4 +1915,51 @@ HWTEST_F(BatteryServiceTest, BatteryXCollie003, TestSize.Level1)
     batteryXCollie.CancelBatteryXCollie();
     EXPECT_TRUE(batteryXCollie.isCanceled_);
     BATTERY_HILOGI(LABEL_TEST, "BatteryXCollie003 function end!");
+}
+
+/**
+ * @tc.name: BatteryXCollie004
+ * @tc.desc: Test nested BatteryXCollie guards share the watchdog slot of the calling thread
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryServiceTest, BatteryXCollie004, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryXCollie004 function start!");
+    BatteryXCollie outer("BatteryService::GetCapacity");
+    EXPECT_GE(outer.slot_, 0);
+    int32_t slot = outer.slot_;
+    {
+        BatteryXCollie inner("BatteryService::GetVoltage");
+        EXPECT_EQ(inner.slot_, slot);
+    }
+    std::thread other([slot] {
+        BatteryXCollie guard("BatteryService::GetHealthStatus");
+        EXPECT_NE(guard.slot_, slot);
+    });
+    other.join();
+    outer.CancelBatteryXCollie();
+    EXPECT_TRUE(outer.isCanceled_);
+    EXPECT_EQ(outer.slot_, -1);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryXCollie004 function end!");
+}
+
+/**
+ * @tc.name: BatteryXCollie005
+ * @tc.desc: Test the watchdog slot of a thread is given back when the thread exits
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryServiceTest, BatteryXCollie005, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryXCollie005 function start!");
+    // more short lived threads than watchdog slots, each one still gets a slot
+    constexpr int32_t threadCount = 200;
+    for (int32_t i = 0; i < threadCount; i++) {
+        std::thread caller([] {
+            std::string tag = "BatteryService::GetCapacity";
+            BatteryXCollie guard(tag);
+            EXPECT_GE(guard.slot_, 0);
+        });
+        caller.join();
+    }
+    BATTERY_HILOGI(LABEL_TEST, "BatteryXCollie005 function end!");
 }
\ No newline at end of file
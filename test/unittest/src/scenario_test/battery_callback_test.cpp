@@ -19,8 +19,15 @@
 #define private   public
 #define protected public
 #endif
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "battery_service.h"
 #include "battery_callback.h"
+#include "battery_event_pipeline.h"
 #include "battery_log.h"
 
 using namespace testing::ext;
@@ -29,6 +36,54 @@ namespace OHOS {
 namespace PowerMgr {
 namespace {
 sptr<BatteryService> g_service;
+constexpr int32_t WAIT_TIMES = 200;
+constexpr int32_t WAIT_INTERVAL_MS = 10;
+const std::string POWER_SUPPLY = "SUBSYSTEM=power_supply";
+
+class BlockingHandler {
+public:
+    void Handle(const HDI::Battery::V2_0::BatteryInfo& event)
+    {
+        entered_ = true;
+        for (int32_t i = 0; i < WAIT_TIMES && blocked_; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_INTERVAL_MS));
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.push_back(event);
+    }
+    std::vector<HDI::Battery::V2_0::BatteryInfo> Events()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return events_;
+    }
+    std::atomic_bool entered_ { false };
+    std::atomic_bool blocked_ { true };
+private:
+    std::mutex mutex_;
+    std::vector<HDI::Battery::V2_0::BatteryInfo> events_;
+};
+
+HDI::Battery::V2_0::BatteryInfo MakeEvent(int32_t capacity, const std::string& uevent)
+{
+    HDI::Battery::V2_0::BatteryInfo event;
+    event.capacity = capacity;
+    event.uevent = uevent;
+    return event;
+}
+
+void WaitEntered(BlockingHandler& handler)
+{
+    for (int32_t i = 0; i < WAIT_TIMES && !handler.entered_; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_INTERVAL_MS));
+    }
+}
+
+void WaitProcessed(BatteryEventPipeline& pipeline, uint64_t processed)
+{
+    for (int32_t i = 0; i < WAIT_TIMES && pipeline.GetStats().processed < processed; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_INTERVAL_MS));
+    }
+}
 }
 
 int32_t HandleBatteryCallbackEvent(const OHOS::HDI::Battery::V2_0::BatteryInfo& event)
@@ -83,5 +138,154 @@ HWTEST_F(BatteryCallbackTest, BatteryCallback002, TestSize.Level1)
     EXPECT_EQ(callback->Update(event), HDF_FAILURE);
     BATTERY_HILOGI(LABEL_TEST, "BatteryCallback002 function end!");
 }
+
+/**
+ * @tc.name: BatteryCallback003
+ * @tc.desc: A burst of power_supply pushes collapses into the latest sample
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryCallbackTest, BatteryCallback003, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryCallback003 function start!");
+    BlockingHandler handler;
+    BatteryEventPipeline pipeline(
+        [&handler](const HDI::Battery::V2_0::BatteryInfo& event) { handler.Handle(event); }, nullptr);
+    constexpr int32_t burst = 50;
+    pipeline.Push(MakeEvent(0, POWER_SUPPLY));
+    WaitEntered(handler);
+    for (int32_t capacity = 1; capacity < burst; capacity++) {
+        pipeline.Push(MakeEvent(capacity, POWER_SUPPLY));
+    }
+    handler.blocked_ = false;
+    WaitProcessed(pipeline, 2);
+
+    auto stats = pipeline.GetStats();
+    EXPECT_EQ(stats.received, static_cast<uint64_t>(burst));
+    EXPECT_EQ(stats.processed, static_cast<uint64_t>(2));
+    EXPECT_EQ(stats.coalesced, static_cast<uint64_t>(burst - 2));
+    EXPECT_EQ(stats.dropped, static_cast<uint64_t>(0));
+    auto events = handler.Events();
+    ASSERT_EQ(events.size(), static_cast<size_t>(2));
+    EXPECT_EQ(events[0].capacity, 0);
+    EXPECT_EQ(events[1].capacity, burst - 1);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryCallback003 function end!");
+}
+
+/**
+ * @tc.name: BatteryCallback004
+ * @tc.desc: Pushes carrying a special uevent are never coalesced and keep their order
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryCallbackTest, BatteryCallback004, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryCallback004 function start!");
+    BlockingHandler handler;
+    BatteryEventPipeline pipeline(
+        [&handler](const HDI::Battery::V2_0::BatteryInfo& event) { handler.Handle(event); }, nullptr);
+    pipeline.Push(MakeEvent(10, POWER_SUPPLY));
+    WaitEntered(handler);
+    pipeline.Push(MakeEvent(11, "battery common event$sendcommonevent"));
+    pipeline.Push(MakeEvent(12, POWER_SUPPLY));
+    pipeline.Push(MakeEvent(13, ""));
+    pipeline.Push(MakeEvent(14, "battery custom event"));
+    handler.blocked_ = false;
+    WaitProcessed(pipeline, 4);
+
+    auto stats = pipeline.GetStats();
+    EXPECT_EQ(stats.received, static_cast<uint64_t>(5));
+    EXPECT_EQ(stats.coalesced, static_cast<uint64_t>(1));
+    EXPECT_EQ(stats.processed, static_cast<uint64_t>(4));
+    auto events = handler.Events();
+    ASSERT_EQ(events.size(), static_cast<size_t>(4));
+    EXPECT_EQ(events[0].capacity, 10);
+    EXPECT_EQ(events[1].capacity, 11);
+    EXPECT_EQ(events[2].capacity, 13);
+    EXPECT_EQ(events[3].capacity, 14);
+    EXPECT_FALSE(BatteryEventPipeline::IsCoalescable(events[3]));
+    BATTERY_HILOGI(LABEL_TEST, "BatteryCallback004 function end!");
+}
+
+/**
+ * @tc.name: BatteryCallback005
+ * @tc.desc: A blocked broadcast lane does not delay the decision stage of the following pushes
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryCallbackTest, BatteryCallback005, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryCallback005 function start!");
+    BlockingHandler broadcaster;
+    std::atomic<int32_t> decisions { 0 };
+    BatteryEventPipeline* pipelinePtr = nullptr;
+    BatteryEventPipeline pipeline([&](const HDI::Battery::V2_0::BatteryInfo& event) {
+        decisions++;
+        BatteryInfo info;
+        info.SetCapacity(event.capacity);
+        pipelinePtr->PostBroadcast(info, BatteryInfo::FIELD_CAPACITY);
+    }, [&broadcaster](BatteryInfo& info, uint32_t changedFields) {
+        broadcaster.Handle(MakeEvent(info.GetCapacity(), ""));
+    });
+    pipelinePtr = &pipeline;
+    pipeline.Push(MakeEvent(10, "battery common event$sendcommonevent"));
+    WaitEntered(broadcaster);
+    pipeline.Push(MakeEvent(11, "battery custom event"));
+    WaitProcessed(pipeline, 2);
+    EXPECT_EQ(decisions.load(), 2);
+    EXPECT_EQ(broadcaster.Events().size(), static_cast<size_t>(0));
+
+    broadcaster.blocked_ = false;
+    for (int32_t i = 0; i < WAIT_TIMES && pipeline.GetStats().broadcastRun.count < 2; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_INTERVAL_MS));
+    }
+    auto stats = pipeline.GetStats();
+    EXPECT_EQ(stats.decision.count, static_cast<uint64_t>(2));
+    EXPECT_EQ(stats.broadcastWait.count, static_cast<uint64_t>(2));
+    EXPECT_EQ(stats.broadcastRun.count, static_cast<uint64_t>(2));
+    EXPECT_LT(stats.decision.maxUs, stats.broadcastRun.maxUs);
+    EXPECT_EQ(broadcaster.Events().size(), static_cast<size_t>(2));
+    BATTERY_HILOGI(LABEL_TEST, "BatteryCallback005 function end!");
+}
+
+/**
+ * @tc.name: BatteryCallback006
+ * @tc.desc: Broadcasts posted behind a stalled one merge into a single pending task
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryCallbackTest, BatteryCallback006, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryCallback006 function start!");
+    BlockingHandler broadcaster;
+    std::atomic<uint32_t> lastFields { 0 };
+    BatteryEventPipeline pipeline(nullptr, [&](BatteryInfo& info, uint32_t changedFields) {
+        broadcaster.Handle(MakeEvent(info.GetCapacity(), ""));
+        lastFields = changedFields;
+    });
+    constexpr int32_t burst = 50;
+    BatteryInfo info;
+    info.SetCapacity(0);
+    pipeline.PostBroadcast(info, BatteryInfo::FIELD_CAPACITY);
+    WaitEntered(broadcaster);
+    for (int32_t capacity = 1; capacity < burst; capacity++) {
+        info.SetCapacity(capacity);
+        pipeline.PostBroadcast(info, (capacity == 1) ? BatteryInfo::FIELD_VOLTAGE : BatteryInfo::FIELD_CAPACITY);
+    }
+    auto stats = pipeline.GetStats();
+    EXPECT_EQ(stats.broadcastPosted, static_cast<uint64_t>(2));
+    EXPECT_EQ(stats.broadcastPending, 1U);
+    EXPECT_EQ(stats.broadcastCoalesced, static_cast<uint64_t>(burst - 2));
+
+    broadcaster.blocked_ = false;
+    for (int32_t i = 0; i < WAIT_TIMES && pipeline.GetStats().broadcastRun.count < 2; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_INTERVAL_MS));
+    }
+    stats = pipeline.GetStats();
+    EXPECT_EQ(stats.broadcastRun.count, static_cast<uint64_t>(2));
+    EXPECT_EQ(stats.broadcastPending, 0U);
+    auto events = broadcaster.Events();
+    ASSERT_EQ(events.size(), static_cast<size_t>(2));
+    EXPECT_EQ(events[0].capacity, 0);
+    EXPECT_EQ(events[1].capacity, burst - 1);
+    EXPECT_EQ(lastFields.load(), BatteryInfo::FIELD_VOLTAGE | BatteryInfo::FIELD_CAPACITY);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryCallback006 function end!");
+}
 } // namespace PowerMgr
 } // namespace OHOS
@@ -304,5 +304,35 @@ static HWTEST_F(BatteryDumpTest, BatteryDump016, TestSize.Level1)
     EXPECT_EQ(g_service->Dump(fd, args), ERR_NO_INIT);
     BATTERY_HILOGI(LABEL_TEST, "BatteryDump016 function end!");
 }
+
+/**
+ * @tc.name: BatteryDump017
+ * @tc.desc: Test functions Dump, charge sessions cmd
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryDumpTest, BatteryDump017, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryDump017 function start!");
+    int32_t fd = 1;
+    std::vector<std::u16string> args;
+    args.push_back(u"--sessions");
+    EXPECT_EQ(g_service->Dump(fd, args), ERR_OK);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryDump017 function end!");
+}
+
+/**
+ * @tc.name: BatteryDump018
+ * @tc.desc: Test functions Dump, listeners cmd
+ * @tc.type: FUNC
+ */
+static HWTEST_F(BatteryDumpTest, BatteryDump018, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryDump018 function start!");
+    int32_t fd = 1;
+    std::vector<std::u16string> args;
+    args.push_back(u"--listeners");
+    EXPECT_EQ(g_service->Dump(fd, args), ERR_OK);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryDump018 function end!");
+}
 } // namespace PowerMgr
 } // namespace OHOS
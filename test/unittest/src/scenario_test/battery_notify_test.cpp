@@ -946,5 +946,64 @@ HWTEST_F(BatteryNotifyTest, BatteryNotify044, TestSize.Level1)
     
     BATTERY_HILOGI(LABEL_TEST, "BatteryNotify044 function end!");
 }
+
+/**
+ * @tc.name: BatteryNotify045
+ * @tc.desc: Test PublishEvents skips the publishers whose fields did not change
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryNotifyTest, BatteryNotify045, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryNotify045 function start!");
+    g_batteryInfo->SetChargeType(ChargeType::WIRED_QUICK);
+    g_batteryNotify->batteryInfoChargeType_ = ChargeType::NONE;
+    auto ret = g_batteryNotify->PublishEvents(*g_batteryInfo, BatteryInfo::FIELD_NOW_CURRENT);
+    EXPECT_EQ(ret, ERR_OK);
+    EXPECT_EQ(g_batteryNotify->batteryInfoChargeType_, ChargeType::NONE);
+    ret = g_batteryNotify->PublishEvents(*g_batteryInfo, BatteryInfo::FIELD_CHARGE_TYPE);
+    EXPECT_EQ(ret, ERR_OK);
+    EXPECT_EQ(g_batteryNotify->batteryInfoChargeType_, ChargeType::WIRED_QUICK);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryNotify045 function end!");
+}
+
+/**
+ * @tc.name: BatteryNotify046
+ * @tc.desc: Test BATTERY_CHANGED is suppressed below the publish deltas and always published on triggers
+ * @tc.type: FUNC
+ */
+HWTEST_F(BatteryNotifyTest, BatteryNotify046, TestSize.Level1)
+{
+    BATTERY_HILOGI(LABEL_TEST, "BatteryNotify046 function start!");
+    BatteryNotify notify;
+    notify.voltageDelta_ = 20000;
+    notify.temperatureDelta_ = 5;
+    notify.minInterval_ = 0;
+    BatteryInfo info;
+    info.SetCapacity(50);
+    info.SetVoltage(4000000);
+    info.SetTemperature(300);
+    EXPECT_EQ(notify.PublishEvents(info, BatteryInfo::FIELD_ALL), ERR_OK);
+    BatteryNotify::ChangedEventStats stats = notify.GetChangedEventStats();
+    EXPECT_EQ(stats.published, 1U);
+
+    info.SetVoltage(4010000);
+    info.SetTemperature(302);
+    notify.PublishEvents(info, BatteryInfo::FIELD_VOLTAGE | BatteryInfo::FIELD_TEMPERATURE);
+    stats = notify.GetChangedEventStats();
+    EXPECT_EQ(stats.published, 1U);
+    EXPECT_EQ(stats.suppressed, 1U);
+
+    info.SetVoltage(4020000);
+    notify.PublishEvents(info, BatteryInfo::FIELD_VOLTAGE);
+    stats = notify.GetChangedEventStats();
+    EXPECT_EQ(stats.published, 2U);
+
+    info.SetCapacity(49);
+    notify.PublishEvents(info, BatteryInfo::FIELD_CAPACITY);
+    stats = notify.GetChangedEventStats();
+    EXPECT_EQ(stats.published, 3U);
+    EXPECT_EQ(stats.suppressed, 1U);
+    BATTERY_HILOGI(LABEL_TEST, "BatteryNotify046 function end!");
+}
 } // namespace PowerMgr
 } // namespace OHOS
@@ -19,9 +19,15 @@
 #include <iostream>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "battery_info.h"
+#include "battery_journal_format.h"
 #include "battery_srv_client.h"
 #include "battery_srv_errors.h"
 #include "cJSON.h"
@@ -242,6 +248,136 @@ static int CmdRemainEnergy([[maybe_unused]] int argc, [[maybe_unused]] char** ar
     return OutputSuccess(data);
 }
 
+namespace {
+enum class JournalFormat {
+    NDJSON,
+    CSV,
+};
+
+constexpr size_t JOURNAL_LINE_SIZE = 320;
+constexpr size_t JOURNAL_OUTPUT_BUFFER_SIZE = 64 * 1024;
+
+class JournalMapping {
+public:
+    ~JournalMapping()
+    {
+        if (base_ != nullptr) {
+            munmap(const_cast<uint8_t*>(base_), size_);
+        }
+    }
+    bool Map(const char* path)
+    {
+        int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st {};
+        if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(OHOS::PowerMgr::BatteryJournalFormat::HEADER_SIZE)) {
+            close(fd);
+            return false;
+        }
+        void* base = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            return false;
+        }
+        base_ = static_cast<const uint8_t*>(base);
+        size_ = static_cast<size_t>(st.st_size);
+        return true;
+    }
+    const uint8_t* GetBase() const
+    {
+        return base_;
+    }
+    size_t GetSize() const
+    {
+        return size_;
+    }
+
+private:
+    const uint8_t* base_ { nullptr };
+    size_t size_ { 0 };
+};
+
+int FormatJournalRecord(char* line, size_t size, const OHOS::PowerMgr::BatteryJournalFormat::Record& record,
+    JournalFormat format)
+{
+    const char* pattern = (format == JournalFormat::CSV) ?
+        "%llu,%lld,%d,%d,%d,%d,%d,%d,%d,%d,%d,%u\n" :
+        "{\"seq\":%llu,\"time\":%lld,\"capacity\":%d,\"voltage\":%d,\"current\":%d,\"temperature\":%d,"
+        "\"chargeState\":%d,\"pluggedType\":%d,\"healthState\":%d,\"chargeCounter\":%d,"
+        "\"remainEnergy\":%d,\"changedFields\":%u}\n";
+    return snprintf(line, size, pattern, static_cast<unsigned long long>(record.seq),
+        static_cast<long long>(record.time), record.capacity, record.voltage, record.current, record.temperature,
+        record.chargeState, record.pluggedType, record.healthState, record.chargeCounter, record.remainEnergy,
+        record.changedFields);
+}
+} // namespace
+
+static int CmdJournal(int argc, char** argv)
+{
+    namespace Journal = OHOS::PowerMgr::BatteryJournalFormat;
+    JournalFormat format = JournalFormat::NDJSON;
+    const char* path = Journal::DEFAULT_PATH;
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--format") == 0 && i + 1 < argc && strcmp(argv[i + 1], "ndjson") == 0) {
+            format = JournalFormat::NDJSON;
+            i++;
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc && strcmp(argv[i + 1], "csv") == 0) {
+            format = JournalFormat::CSV;
+            i++;
+        } else if (strcmp(argv[i], "--path") == 0 && i + 1 < argc) {
+            path = argv[++i];
+        } else {
+            return OutputError("ERR_ARG_INVALID",
+                std::string("Invalid argument for 'journal' command: '") + argv[i] + "'.",
+                "Usage: ohos-batteryManager journal [--format ndjson|csv] [--path <file>]");
+        }
+    }
+
+    JournalMapping mapping;
+    if (!mapping.Map(path)) {
+        return OutputError("ERR_JOURNAL_UNAVAILABLE",
+            std::string("Failed to open battery journal: '") + path + "'.",
+            "Check that the file exists and the caller can read it.");
+    }
+    const auto& header = *reinterpret_cast<const Journal::Header*>(mapping.GetBase());
+    if (!Journal::IsValidHeader(header, mapping.GetSize())) {
+        return OutputError("ERR_JOURNAL_INVALID",
+            std::string("Invalid battery journal header: '") + path + "'.",
+            "The file is not a battery journal or was written by an incompatible version.");
+    }
+
+    // Each record is copied out of the mapping before its crc is checked, so the fields formatted are the
+    // ones checked. The service may keep appending meanwhile, a slot overwritten while it is copied fails
+    // its crc and is skipped
+    std::vector<char> buffer(JOURNAL_OUTPUT_BUFFER_SIZE);
+    size_t used = 0;
+    if (format == JournalFormat::CSV) {
+        used = static_cast<size_t>(snprintf(buffer.data(), buffer.size(), "%s",
+            "seq,time,capacity,voltage,current,temperature,chargeState,pluggedType,healthState,"
+            "chargeCounter,remainEnergy,changedFields\n"));
+    }
+    uint64_t nextSeq = Journal::RecoverNextSeq(mapping.GetBase(), header);
+    for (uint64_t seq = Journal::GetFirstSeq(header, nextSeq); seq < nextSeq; seq++) {
+        const Journal::Record record = Journal::GetRecord(mapping.GetBase(), header, seq);
+        if (!Journal::IsValidRecord(record, seq)) {
+            continue;
+        }
+        if (buffer.size() - used < JOURNAL_LINE_SIZE) {
+            fwrite(buffer.data(), 1, used, stdout);
+            used = 0;
+        }
+        int len = FormatJournalRecord(buffer.data() + used, JOURNAL_LINE_SIZE, record, format);
+        if (len > 0 && static_cast<size_t>(len) < JOURNAL_LINE_SIZE) {
+            used += static_cast<size_t>(len);
+        }
+    }
+    fwrite(buffer.data(), 1, used, stdout);
+    fflush(stdout);
+    return CLI_SUCCESS;
+}
+
 static void InitCommands()
 {
     REGISTER_CMD("capacity", "Query battery capacity percentage (0-100%)",
@@ -265,6 +401,16 @@ static void InitCommands()
         "    ohos-batteryManager remain-energy",
         CmdRemainEnergy);
 
+    REGISTER_CMD("journal", "Stream the persisted battery journal as NDJSON or CSV",
+        "ohos-batteryManager journal [--format ndjson|csv] [--path <file>]",
+        "    --format <fmt>     Output format, ndjson or csv, one record per line (default: ndjson)\n"
+        "    --path <file>      Journal file (default: /data/service/el0/battery/battery_journal)",
+        "    # Stream the journal as NDJSON\n"
+        "    ohos-batteryManager journal\n"
+        "    # Stream the journal as CSV\n"
+        "    ohos-batteryManager journal --format csv",
+        CmdJournal);
+
     g_hasSubcommands = (!g_commands.empty());
 }
 
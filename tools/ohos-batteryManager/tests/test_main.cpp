@@ -18,8 +18,10 @@
 #include <cstring>
 #include <string>
 #include <sstream>
+#include <vector>
 
 #include "battery_info.h"
+#include "battery_journal_format.h"
 #include "battery_srv_client.h"
 #include "battery_srv_errors.h"
 #include "cli_handler.h"
@@ -33,6 +35,38 @@ int32_t g_remainEnergyRet = 0;
 constexpr int32_t MOCK_CAPACITY = 85;
 constexpr int32_t MOCK_TOTAL_ENERGY = 4000;
 constexpr int32_t MOCK_REMAIN_ENERGY = 3200;
+constexpr uint32_t MOCK_JOURNAL_CAPACITY = 4;
+constexpr uint64_t MOCK_JOURNAL_RECORDS = 6;
+const char* MOCK_JOURNAL_PATH = "/data/local/tmp/battery_journal_cli_test";
+
+bool WriteMockJournal(const char* path, bool corruptLast)
+{
+    namespace Journal = OHOS::PowerMgr::BatteryJournalFormat;
+    std::vector<uint8_t> file(Journal::HEADER_SIZE + MOCK_JOURNAL_CAPACITY * sizeof(Journal::Record), 0);
+    auto header = reinterpret_cast<Journal::Header*>(file.data());
+    header->magic = Journal::MAGIC;
+    header->version = Journal::VERSION;
+    header->recordSize = sizeof(Journal::Record);
+    header->capacity = MOCK_JOURNAL_CAPACITY;
+    header->nextSeq = MOCK_JOURNAL_RECORDS + 1;
+    for (uint64_t seq = 1; seq <= MOCK_JOURNAL_RECORDS; seq++) {
+        Journal::Record& record = Journal::GetRecord(file.data(), *header, seq);
+        record = {};
+        record.seq = seq;
+        record.capacity = static_cast<int32_t>(seq);
+        record.crc = Journal::RecordCrc(record);
+    }
+    if (corruptLast) {
+        Journal::GetRecord(file.data(), *header, MOCK_JOURNAL_RECORDS).capacity++;
+    }
+    FILE* fp = fopen(path, "wb");
+    if (fp == nullptr) {
+        return false;
+    }
+    bool ret = fwrite(file.data(), 1, file.size(), fp) == file.size();
+    fclose(fp);
+    return ret;
+}
 }
 
 namespace OHOS::PowerMgr {
@@ -489,3 +523,75 @@ HWTEST_F(BatteryManagerCliTest, BatteryManagerCliTest_032, TestSize.Level1)
     char* argv[] = { prog, helpFlag, extra };
     EXPECT_EQ(HandleCommand(3, argv), 0);
 }
+
+/**
+ * @tc.name: BatteryManagerCliTest_033
+ * @tc.desc: Test journal command streams a valid journal as ndjson and csv
+ */
+HWTEST_F(BatteryManagerCliTest, BatteryManagerCliTest_033, TestSize.Level1)
+{
+    ASSERT_TRUE(WriteMockJournal(MOCK_JOURNAL_PATH, false));
+    char prog[] = "ohos-batteryManager";
+    char cmd[] = "journal";
+    char pathFlag[] = "--path";
+    char path[] = "/data/local/tmp/battery_journal_cli_test";
+    char formatFlag[] = "--format";
+    char csv[] = "csv";
+    char* argv[] = { prog, cmd, pathFlag, path, formatFlag, csv };
+    EXPECT_EQ(HandleCommand(4, argv), 0);
+    EXPECT_EQ(HandleCommand(6, argv), 0);
+    remove(MOCK_JOURNAL_PATH);
+}
+
+/**
+ * @tc.name: BatteryManagerCliTest_034
+ * @tc.desc: Test journal command skips a record whose crc does not match
+ */
+HWTEST_F(BatteryManagerCliTest, BatteryManagerCliTest_034, TestSize.Level1)
+{
+    ASSERT_TRUE(WriteMockJournal(MOCK_JOURNAL_PATH, true));
+    char prog[] = "ohos-batteryManager";
+    char cmd[] = "journal";
+    char pathFlag[] = "--path";
+    char path[] = "/data/local/tmp/battery_journal_cli_test";
+    char* argv[] = { prog, cmd, pathFlag, path };
+    EXPECT_EQ(HandleCommand(4, argv), 0);
+    remove(MOCK_JOURNAL_PATH);
+}
+
+/**
+ * @tc.name: BatteryManagerCliTest_035
+ * @tc.desc: Test journal command fails for a missing file and for a file that is not a journal
+ */
+HWTEST_F(BatteryManagerCliTest, BatteryManagerCliTest_035, TestSize.Level1)
+{
+    char prog[] = "ohos-batteryManager";
+    char cmd[] = "journal";
+    char pathFlag[] = "--path";
+    char path[] = "/data/local/tmp/battery_journal_cli_test";
+    char* argv[] = { prog, cmd, pathFlag, path };
+    remove(MOCK_JOURNAL_PATH);
+    EXPECT_EQ(HandleCommand(4, argv), 1);
+    std::vector<uint8_t> zeros(OHOS::PowerMgr::BatteryJournalFormat::HEADER_SIZE, 0);
+    FILE* fp = fopen(MOCK_JOURNAL_PATH, "wb");
+    ASSERT_NE(fp, nullptr);
+    fwrite(zeros.data(), 1, zeros.size(), fp);
+    fclose(fp);
+    EXPECT_EQ(HandleCommand(4, argv), 1);
+    remove(MOCK_JOURNAL_PATH);
+}
+
+/**
+ * @tc.name: BatteryManagerCliTest_036
+ * @tc.desc: Test journal command with an unknown format or argument returns error
+ */
+HWTEST_F(BatteryManagerCliTest, BatteryManagerCliTest_036, TestSize.Level1)
+{
+    char prog[] = "ohos-batteryManager";
+    char cmd[] = "journal";
+    char formatFlag[] = "--format";
+    char xml[] = "xml";
+    char* argv[] = { prog, cmd, formatFlag, xml };
+    EXPECT_EQ(HandleCommand(4, argv), 1);
+    EXPECT_EQ(HandleCommand(3, argv), 1);
+}
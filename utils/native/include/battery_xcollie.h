@@ -22,16 +22,28 @@
 
 namespace OHOS {
 namespace PowerMgr {
+/**
+ * Scoped watchdog for a public ipc.
+ *
+ * The calling thread stamps the entry time into its own watchdog slot, a single monitor thread scans
+ * the slots and only a call blocked for longer than the timeout is reported through XCollie. When no
+ * slot is left the guard falls back to an XCollie timer per call. Guards must be destroyed on the
+ * thread that created them.
+ */
 class BatteryXCollie {
 public:
+    BatteryXCollie(const char* logTag, bool isRecovery = false);
     BatteryXCollie(const std::string &logTag, bool isRecovery = false);
     ~BatteryXCollie();
 
 private:
+    void StartBatteryXCollie(bool isRecovery);
     void CancelBatteryXCollie();
 
-    int32_t id_;
+    int32_t id_ = -1;
+    int32_t slot_ = -1;
     std::string logTag_;
+    const char* tag_ = nullptr;
     std::atomic_bool isCanceled_ = false;
 };
 
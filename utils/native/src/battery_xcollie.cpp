@@ -8,32 +8,206 @@
 
 #include "battery_log.h"
 #include "battery_xcollie.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <securec.h>
+#include <thread>
+
 #include "xcollie/xcollie.h"
 
 namespace OHOS {
 namespace PowerMgr {
-BatteryXCollie::BatteryXCollie(const std::string &logTag, bool isRecovery)
+namespace {
+constexpr uint32_t DFX_DELAY_S = 60;
+// a hang is reported between DFX_DELAY_S and DFX_DELAY_S + CHECK_INTERVAL_S after the call entered
+constexpr uint32_t CHECK_INTERVAL_S = 10;
+constexpr uint32_t REPORT_DELAY_S = 1;
+constexpr int32_t SLOT_COUNT = 64;
+constexpr int32_t INVALID_SLOT = -1;
+constexpr int32_t UNCLAIMED_SLOT = -2;
+constexpr int64_t SEC_TO_MS = 1000;
+constexpr size_t MAX_TAG_SIZE = 64;
+
+int64_t GetTickMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// The tag is copied in, the string of a guard may be gone by the time the monitor reports it. The owner
+// only writes it while enterTime is 0, the monitor drops a copy taken while enterTime changed
+struct WatchdogSlot {
+    std::atomic<int64_t> enterTime { 0 };
+    char tag[MAX_TAG_SIZE] { 0 };
+    std::atomic_bool isRecovery { false };
+    std::atomic_bool isClaimed { false };
+};
+
+// Gives the slot of the thread back when the thread exits
+struct ThreadSlot {
+    ~ThreadSlot();
+    int32_t slot { UNCLAIMED_SLOT };
+    uint32_t depth { 0 };
+};
+
+thread_local ThreadSlot t_slot;
+
+class BatteryWatchdog {
+public:
+    static BatteryWatchdog& GetInstance()
+    {
+        // never destroyed, the detached monitor thread keeps using it until the process exits
+        static BatteryWatchdog* instance = new BatteryWatchdog();
+        return *instance;
+    }
+
+    int32_t Enter(const char* tag, bool isRecovery)
+    {
+        if (t_slot.slot == UNCLAIMED_SLOT) {
+            t_slot.slot = ClaimSlot();
+        }
+        if (t_slot.slot == INVALID_SLOT) {
+            return INVALID_SLOT;
+        }
+        // a nested guard keeps the entry time of the outermost call
+        if (t_slot.depth++ == 0) {
+            WatchdogSlot& slot = slots_[t_slot.slot];
+            // orders the tag after the exit of the last call for a monitor copying it meanwhile
+            std::atomic_thread_fence(std::memory_order_release);
+            if (strncpy_s(slot.tag, sizeof(slot.tag), tag, sizeof(slot.tag) - 1) != EOK) {
+                slot.tag[0] = '\0';
+            }
+            slot.isRecovery.store(isRecovery, std::memory_order_relaxed);
+            slot.enterTime.store(GetTickMs(), std::memory_order_release);
+        }
+        return t_slot.slot;
+    }
+
+    void Exit(int32_t slot)
+    {
+        if (t_slot.depth > 0 && --t_slot.depth == 0) {
+            slots_[slot].enterTime.store(0, std::memory_order_release);
+        }
+    }
+
+    void ReleaseSlot(int32_t slot)
+    {
+        slots_[slot].enterTime.store(0, std::memory_order_release);
+        slots_[slot].isClaimed.store(false, std::memory_order_release);
+    }
+
+private:
+    BatteryWatchdog() = default;
+
+    int32_t ClaimSlot()
+    {
+        for (int32_t slot = 0; slot < SLOT_COUNT; slot++) {
+            bool isClaimed = false;
+            if (!slots_[slot].isClaimed.compare_exchange_strong(isClaimed, true, std::memory_order_acq_rel)) {
+                continue;
+            }
+            std::call_once(monitorFlag_, [this] {
+                std::thread monitor([this] { Monitor(); });
+                monitor.detach();
+            });
+            return slot;
+        }
+        BATTERY_HILOGW(COMP_SVC, "no watchdog slot left, fall back to xcollie timer");
+        return INVALID_SLOT;
+    }
+
+    void Monitor()
+    {
+        std::array<int64_t, SLOT_COUNT> reported {};
+        while (true) {
+            std::this_thread::sleep_for(std::chrono::seconds(CHECK_INTERVAL_S));
+            int64_t now = GetTickMs();
+            for (int32_t i = 0; i < SLOT_COUNT; i++) {
+                int64_t enterTime = slots_[i].enterTime.load(std::memory_order_acquire);
+                if (enterTime == 0 || enterTime == reported[i] || (now - enterTime) < DFX_DELAY_S * SEC_TO_MS) {
+                    continue;
+                }
+                char tag[MAX_TAG_SIZE] { 0 };
+                if (memcpy_s(tag, sizeof(tag) - 1, slots_[i].tag, sizeof(tag) - 1) != EOK) {
+                    continue;
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slots_[i].enterTime.load(std::memory_order_relaxed) != enterTime) {
+                    // the call returned while the tag was copied
+                    continue;
+                }
+                reported[i] = enterTime;
+                Report(tag, slots_[i].isRecovery.load(std::memory_order_relaxed), now - enterTime);
+            }
+        }
+    }
+
+    void Report(const char* tag, bool isRecovery, int64_t blockedMs)
+    {
+        std::string logTag = tag;
+        unsigned int flag = HiviewDFX::XCOLLIE_FLAG_LOG;
+        if (isRecovery) {
+            flag = HiviewDFX::XCOLLIE_FLAG_LOG | HiviewDFX::XCOLLIE_FLAG_RECOVERY;
+        }
+        BATTERY_HILOGE(COMP_SVC, "ipc blocked, tag:%{public}s, blocked(ms):%{public}lld", logTag.c_str(),
+            static_cast<long long>(blockedMs));
+        // the timer is left to expire so XCollie takes its usual log and recovery actions
+        int32_t id = HiviewDFX::XCollie::GetInstance().SetTimer(logTag, REPORT_DELAY_S, nullptr, nullptr, flag);
+        if (id == HiviewDFX::INVALID_ID) {
+            BATTERY_HILOGE(COMP_SVC, "report ipc block SetTimer fail, tag:%{public}s", logTag.c_str());
+        }
+    }
+
+    std::array<WatchdogSlot, SLOT_COUNT> slots_;
+    std::once_flag monitorFlag_;
+};
+
+ThreadSlot::~ThreadSlot()
+{
+    if (slot >= 0) {
+        BatteryWatchdog::GetInstance().ReleaseSlot(slot);
+    }
+}
+}
+
+BatteryXCollie::BatteryXCollie(const char* logTag, bool isRecovery) : tag_(logTag)
+{
+    StartBatteryXCollie(isRecovery);
+}
+
+BatteryXCollie::BatteryXCollie(const std::string &logTag, bool isRecovery) : logTag_(logTag)
+{
+    tag_ = logTag_.c_str();
+    StartBatteryXCollie(isRecovery);
+}
+
+BatteryXCollie::~BatteryXCollie()
+{
+    CancelBatteryXCollie();
+}
+
+void BatteryXCollie::StartBatteryXCollie(bool isRecovery)
 {
-    logTag_ = logTag;
     isCanceled_.store(false, std::memory_order_release);
-    const int DFX_DELAY_S = 60;
+    slot_ = BatteryWatchdog::GetInstance().Enter(tag_, isRecovery);
+    if (slot_ != INVALID_SLOT) {
+        return;
+    }
     unsigned int flag = HiviewDFX::XCOLLIE_FLAG_LOG;
     if (isRecovery) {
         flag = HiviewDFX::XCOLLIE_FLAG_LOG | HiviewDFX::XCOLLIE_FLAG_RECOVERY;
     }
-    id_ = HiviewDFX::XCollie::GetInstance().SetTimer(logTag_, DFX_DELAY_S, nullptr, nullptr, flag);
+    id_ = HiviewDFX::XCollie::GetInstance().SetTimer(tag_, DFX_DELAY_S, nullptr, nullptr, flag);
     if (id_ == HiviewDFX::INVALID_ID) {
         BATTERY_HILOGE(COMP_SVC, "Start BatteryXCollie SetTimer fail, tag:%{public}s, timeout(s):%{public}u",
-            logTag_.c_str(), DFX_DELAY_S);
+            tag_, DFX_DELAY_S);
         return;
     }
     BATTERY_HILOGD(COMP_SVC, "Start BatteryXCollie, id:%{public}d, tag:%{public}s, timeout(s):%{public}u", id_,
-        logTag_.c_str(), DFX_DELAY_S);
-}
-
-BatteryXCollie::~BatteryXCollie()
-{
-    CancelBatteryXCollie();
+        tag_, DFX_DELAY_S);
 }
 
 void BatteryXCollie::CancelBatteryXCollie()
@@ -41,13 +215,17 @@ void BatteryXCollie::CancelBatteryXCollie()
     if (isCanceled_.load(std::memory_order_acquire)) {
         return;
     }
+    if (slot_ != INVALID_SLOT) {
+        BatteryWatchdog::GetInstance().Exit(slot_);
+        slot_ = INVALID_SLOT;
+    }
     if (id_ != HiviewDFX::INVALID_ID) {
         HiviewDFX::XCollie::GetInstance().CancelTimer(id_);
         id_ = HiviewDFX::INVALID_ID;
+        BATTERY_HILOGD(COMP_SVC, "Cancel BatteryXCollie, tag:%{public}s", tag_);
     }
     isCanceled_.store(true, std::memory_order_release);
-    BATTERY_HILOGD(COMP_SVC, "Cancel BatteryXCollie, id:%{public}d, tag:%{public}s", id_, logTag_.c_str());
 }
 
 } // namespace PowerMgr
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS